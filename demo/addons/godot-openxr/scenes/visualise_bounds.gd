@@ -8,7 +8,7 @@ func _update_bounds():
 	$CSGPolygon.visible = false
 	if configuration_node:
 		var polygon : PoolVector2Array
-		var bounds = configuration_node.get_play_space()
+		var bounds = configuration_node.get_play_space_boundary()
 		if bounds.size() > 0:
 			# While in most conditions our polygon will be flat on the ground but may be lifted up or down,
 			# there are situations where it can be slanted (basically when CenterHMD is called with RESET_FULL_ROTATION which is seldom used)
@@ -17,8 +17,8 @@ func _update_bounds():
 			# For now we assume a flat plane and just move our CSGPolygon up/down
 			$CSGPolygon.transform.origin.y = bounds[0].y;
 
-			for i in 4:
-				polygon.push_back(Vector2(bounds[i].x, bounds[i].z))
+			for point in bounds:
+				polygon.push_back(Vector2(point.x, point.z))
 
 			$CSGPolygon.polygon = polygon
 			$CSGPolygon.visible = true
@@ -0,0 +1,198 @@
+extends ARVROrigin
+
+# Runs our OpenXR frame loop for a number of frames with a realistic setup
+# (4 action sets with 34 actions, 8 pose nodes and 2 tracked hands),
+# writes our frame timings to a JSON file and exits with a non-zero exit code
+# when we exceed our thresholds or allocate memory after warming up.
+#
+# This is meant to be run against the headless mock runtime with a plugin build
+# that has track_allocations=yes, see tools/run_benchmark.py.
+#
+# Timings depend on the machine we run on so there are no default thresholds,
+# run with --benchmark-calibrate on the machine that checks for regressions first.
+#
+# Command line options:
+#   --benchmark-output=<file>      where to write our results, default user://benchmark.json
+#   --benchmark-frames=<count>     number of frames to measure, default 900
+#   --benchmark-thresholds=<file>  thresholds to check
+#   --benchmark-calibrate=<file>   write thresholds with THRESHOLD_HEADROOM based on this run instead
+
+const WARMUP_FRAMES = 180
+const STARTUP_TIMEOUT_FRAMES = 600
+
+# Our frame timings are averaged over this many frames (FRAME_TIMING_WINDOW in OpenXRApi.h)
+const FRAME_TIMING_WINDOW = 90
+
+# Calibrated thresholds allow for this factor over the timings we measured
+const THRESHOLD_HEADROOM = 1.5
+
+var output_path = "user://benchmark.json"
+var frame_count = 900
+var thresholds_path = ""
+var calibrate_path = ""
+var thresholds : Dictionary
+
+var interface : ARVRInterface
+var focused = false
+var startup_frames = 0
+var warmup_frames = 0
+var measured_frames = 0
+
+func _parse_arguments():
+	for argument in OS.get_cmdline_args():
+		if argument.begins_with("--benchmark-output="):
+			output_path = argument.trim_prefix("--benchmark-output=")
+		elif argument.begins_with("--benchmark-frames="):
+			frame_count = int(argument.trim_prefix("--benchmark-frames="))
+		elif argument.begins_with("--benchmark-thresholds="):
+			thresholds_path = argument.trim_prefix("--benchmark-thresholds=")
+		elif argument.begins_with("--benchmark-calibrate="):
+			calibrate_path = argument.trim_prefix("--benchmark-calibrate=")
+
+	# We only check our timings once per window, make sure we measure at least one
+	frame_count = int(max(frame_count, FRAME_TIMING_WINDOW))
+
+func _load_text(p_path : String) -> String:
+	var file = File.new()
+	if file.open(p_path, File.READ) != OK:
+		return ""
+
+	var text = file.get_as_text()
+	file.close()
+	return text
+
+func _fail(p_message : String, p_exit_code = 1):
+	printerr("Benchmark failed: " + p_message)
+	get_tree().quit(p_exit_code)
+	set_process(false)
+
+func _ready():
+	_parse_arguments()
+
+	if calibrate_path == "":
+		if thresholds_path == "":
+			_fail("no thresholds, use --benchmark-thresholds=<file> or --benchmark-calibrate=<file>", 2)
+			return
+
+		var loaded = parse_json(_load_text(thresholds_path))
+		if typeof(loaded) != TYPE_DICTIONARY or !loaded.has("total_ns_per_frame") or typeof(loaded.get("functions")) != TYPE_DICTIONARY:
+			_fail("couldn't load thresholds from " + thresholds_path, 2)
+			return
+		thresholds = loaded
+
+	# Our action map must be set before we initialise
+	$Configuration.action_sets = _load_text("res://benchmark/action_sets.json")
+	$Configuration.interaction_profiles = _load_text("res://benchmark/interaction_profiles.json")
+	$Configuration.headless = true
+
+	interface = ARVRServer.find_interface("OpenXR")
+	if !interface or !interface.initialize():
+		_fail("couldn't initialise OpenXR, is XR_RUNTIME_JSON pointing to our mock runtime?", 2)
+		return
+
+	# our plugin adds its signals when initialising, we only become focused once we process our first frames
+	ARVRServer.connect("openxr_focused_state", self, "_on_focused_state")
+
+	get_viewport().arvr = true
+
+func _on_focused_state():
+	focused = true
+
+func _process(_delta):
+	if !focused:
+		startup_frames += 1
+		if startup_frames > STARTUP_TIMEOUT_FRAMES:
+			_fail("our OpenXR session never got focus", 2)
+		return
+
+	if warmup_frames < WARMUP_FRAMES:
+		# Give the runtime a chance to report interaction profiles and hand tracking
+		# and let any one time setup happen before we start measuring.
+		warmup_frames += 1
+		if warmup_frames == WARMUP_FRAMES:
+			$Configuration.frame_timings_enabled = true
+		return
+
+	measured_frames += 1
+	if measured_frames >= frame_count:
+		_finish()
+
+func _finish():
+	set_process(false)
+
+	# Note, we only call into our plugin once we're done as this allocates memory
+	# which would otherwise be counted against our frame loop.
+	var timings : Dictionary = $Configuration.get_frame_timings()
+
+	var results = {
+		"frames": measured_frames,
+		"frame_timing_window": FRAME_TIMING_WINDOW,
+		"functions": {},
+		"total_ns_per_frame": timings.get("total_ns", 0),
+	}
+	for key in timings.keys():
+		if typeof(timings[key]) == TYPE_DICTIONARY:
+			results["functions"][key] = {
+				"average_ns_per_frame": timings[key]["average_ns"],
+				"max_ns": timings[key]["max_ns"],
+			}
+
+	var failures = []
+
+	if timings.has("allocations"):
+		results["allocations_per_frame"] = float(timings["allocations"]) / FRAME_TIMING_WINDOW
+		results["windows_with_allocations"] = timings["allocation_failures"]
+
+		# allocating doesn't depend on our machine so this always fails our run, calibrating or not,
+		# any window that allocated counts, not just the last one we report on
+		if results["windows_with_allocations"] > 0:
+			failures.push_back("allocated memory in %d windows of %d frames" % [results["windows_with_allocations"], FRAME_TIMING_WINDOW])
+	else:
+		failures.push_back("allocations aren't tracked, build the plugin with track_allocations=yes")
+
+	if calibrate_path != "":
+		_write_thresholds(results, failures)
+	else:
+		if results["total_ns_per_frame"] > thresholds["total_ns_per_frame"]:
+			failures.push_back("%d ns per frame exceeds %d ns" % [results["total_ns_per_frame"], thresholds["total_ns_per_frame"]])
+
+		var function_thresholds = thresholds["functions"]
+		for function in function_thresholds.keys():
+			if results["functions"].has(function) and results["functions"][function]["average_ns_per_frame"] > function_thresholds[function]:
+				failures.push_back("%s uses %d ns per frame, exceeding %d ns" % [function, results["functions"][function]["average_ns_per_frame"], function_thresholds[function]])
+
+	results["passed"] = failures.empty()
+	results["failures"] = failures
+
+	var file = File.new()
+	if file.open(output_path, File.WRITE) == OK:
+		file.store_string(JSON.print(results, "\t") + "\n")
+		file.close()
+	else:
+		failures.push_back("couldn't write our results to " + output_path)
+
+	interface.uninitialize()
+
+	if failures.empty():
+		print("Benchmark passed, results written to " + output_path)
+		get_tree().quit(0)
+	else:
+		for failure in failures:
+			printerr("Benchmark failed: " + failure)
+		get_tree().quit(1)
+
+func _write_thresholds(p_results : Dictionary, p_failures : Array):
+	var calibrated = {
+		"total_ns_per_frame": int(ceil(p_results["total_ns_per_frame"] * THRESHOLD_HEADROOM)),
+		"functions": {},
+	}
+	for function in p_results["functions"].keys():
+		calibrated["functions"][function] = int(ceil(p_results["functions"][function]["average_ns_per_frame"] * THRESHOLD_HEADROOM))
+
+	var file = File.new()
+	if file.open(calibrate_path, File.WRITE) == OK:
+		file.store_string(JSON.print(calibrated, "\t") + "\n")
+		file.close()
+		print("Benchmark thresholds written to " + calibrate_path)
+	else:
+		p_failures.push_back("couldn't write our thresholds to " + calibrate_path)
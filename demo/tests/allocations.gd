@@ -0,0 +1,32 @@
+extends "res://tests/test.gd"
+
+# Checks our frame loop doesn't allocate any memory once we're running, our plugin must be built
+# with track_allocations=yes which counts the allocations made in process_openxr and render_openxr.
+# This runs with our controllers, pose nodes, hands and action events so their updates are covered as well.
+
+# Give the runtime a chance to report interaction profiles and hand tracking before we count
+const WARMUP_FRAMES = 60
+
+var action_changes_reported = 0
+
+func _setup():
+	$Configuration.action_events_enabled = true
+
+func _on_actions_changed(p_changes : Array):
+	action_changes_reported += p_changes.size()
+
+func _test_frame(p_frame : int):
+	if p_frame == 1:
+		ARVRServer.connect("openxr_actions_changed", self, "_on_actions_changed")
+	elif p_frame == WARMUP_FRAMES:
+		$Configuration.frame_timings_enabled = true
+
+func _teardown():
+	var timings : Dictionary = $Configuration.get_frame_timings()
+	if !expect(timings.has("allocations"), "allocations aren't tracked, build the plugin with track_allocations=yes"):
+		return
+
+	# our timings are only updated once per window, make sure we measured
+	expect(timings["total_ns"] > 0, "no frame timings were reported after %d frames" % [frame_count - WARMUP_FRAMES])
+	expect(timings["allocation_failures"] == 0, "our frame loop allocated memory in %d windows, %d allocations in the last one" % [timings["allocation_failures"], timings["allocations"]])
+	expect(action_changes_reported > 0, "no action changes were reported through openxr_actions_changed")
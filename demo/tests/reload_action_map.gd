@@ -0,0 +1,56 @@
+extends "res://tests/test.gd"
+
+# Checks reloading our action map while running recreates our session the way the spec allows,
+# our mock runtime reports an error if we end our session before it's stopping.
+
+const RELOAD_FRAME = 10
+const CHECK_FRAME = 40
+const UNCHANGED_RELOAD_FRAME = 50
+
+const RELOAD_TEST_ACTION_SET = {
+	"name": "reload_test",
+	"localised_name": "Reload test",
+	"priority": 0,
+	"actions": [
+		{
+			"type": "bool",
+			"name": "test_button",
+			"localised_name": "Test button",
+			"paths": [ "/user/hand/left" ]
+		}
+	]
+}
+
+var sessions_begun = 0
+var session_exiting = false
+var action_sets : Array
+
+func _on_session_begun():
+	sessions_begun += 1
+
+func _on_session_exiting():
+	session_exiting = true
+
+func _test_frame(p_frame : int):
+	if p_frame == 1:
+		# our plugin adds its signals when initialising
+		ARVRServer.connect("openxr_session_begun", self, "_on_session_begun")
+		ARVRServer.connect("openxr_session_exiting", self, "_on_session_exiting")
+	elif p_frame == RELOAD_FRAME:
+		action_sets = parse_json($Configuration.action_sets)
+		if !expect(typeof(action_sets) == TYPE_ARRAY, "couldn't parse our action sets"):
+			return
+
+		action_sets.push_back(RELOAD_TEST_ACTION_SET)
+		expect($Configuration.reload_action_map(JSON.print(action_sets), $Configuration.interaction_profiles), "reload_action_map failed")
+	elif p_frame == CHECK_FRAME:
+		expect(sessions_begun == 1, "our session began %d times after reloading" % [sessions_begun])
+		expect($Configuration.get_action_set_names().has("reload_test"), "our new action set wasn't loaded")
+	elif p_frame == UNCHANGED_RELOAD_FRAME:
+		# formatting differences don't count as a change
+		expect($Configuration.reload_action_map(JSON.print(action_sets, "\t"), $Configuration.interaction_profiles), "reload_action_map failed")
+
+	expect(!session_exiting, "our session reported it's exiting, the application would quit")
+
+func _check_report(p_report : Dictionary):
+	expect(p_report["sessions_created"] == 2, "created %d sessions, expected 2" % [p_report["sessions_created"]])
@@ -0,0 +1,56 @@
+extends "res://tests/test.gd"
+
+# Checks the space warp info we add to our projection views. Our mock runtime checks the motion vector
+# and depth swapchains these reference and counts the frames that used space warp.
+# Also checks we cap our frame rate to our display refresh rate divided by our frame rate divisor.
+# Space warp needs swapchains so this scene runs with an OpenGL session.
+
+const FRAME_RATE_DIVISOR = 2
+const REFRESH_RATE = 90 # our mock runtime's display refresh rate
+
+# We don't render our images until this frame, until then we shouldn't use space warp
+const RENDER_FRAME = 10
+
+# and we ask the runtime to skip one frame, i.e. after teleporting
+const SKIP_FRAME = 40
+
+var original_target_fps = 0
+
+func _setup():
+	original_target_fps = Engine.target_fps
+	$Configuration.space_warp_frame_rate_divisor = FRAME_RATE_DIVISOR
+	$Configuration.space_warp_enabled = true
+
+func _test_frame(p_frame : int):
+	if p_frame == 1:
+		expect($Configuration.is_space_warp_supported(), "space warp is not supported")
+		expect($Configuration.get_refresh_rate() == REFRESH_RATE, "our refresh rate is %f, not %d" % [$Configuration.get_refresh_rate(), REFRESH_RATE])
+
+	if p_frame < RENDER_FRAME:
+		expect(Engine.target_fps == original_target_fps, "our frame rate was capped before we rendered our images")
+		return
+
+	# the images for our next frame are acquired by now
+	for eye in range(2):
+		expect($Configuration.get_space_warp_motion_vector_texture(eye) != 0, "we have no motion vector texture for eye %d" % [eye])
+		expect($Configuration.get_space_warp_depth_texture(eye) != 0, "we have no depth texture for eye %d" % [eye])
+
+	# A real application would render its motion vectors and depth here
+	$Configuration.space_warp_images_rendered()
+	if p_frame == SKIP_FRAME:
+		$Configuration.space_warp_skip_frame()
+
+	if p_frame > RENDER_FRAME:
+		expect(Engine.target_fps == REFRESH_RATE / FRAME_RATE_DIVISOR, "our frame rate is capped at %d, not %d" % [Engine.target_fps, REFRESH_RATE / FRAME_RATE_DIVISOR])
+
+func _check_report(p_report : Dictionary):
+	# we're called after our session was destroyed, by now our frame rate should be back to what it was
+	expect(Engine.target_fps == original_target_fps, "our frame rate is still capped at %d" % [Engine.target_fps])
+
+	# Every frame we marked as rendered is submitted with space warp, except our last frame as we
+	# uninitialise before rendering it. The first frame with our images and the frame we asked for are skipped.
+	var rendered_frames = frame_count - RENDER_FRAME
+	var space_warp : Dictionary = p_report["space_warp"]
+	expect(p_report["submitted_frames"] >= frame_count, "only submitted %d frames" % [p_report["submitted_frames"]])
+	expect(space_warp["frames"] == rendered_frames, "used space warp for %d frames, not %d" % [space_warp["frames"], rendered_frames])
+	expect(space_warp["skipped_frames"] == 2, "skipped %d space warp frames, not 2" % [space_warp["skipped_frames"]])
@@ -0,0 +1,84 @@
+extends "res://tests/test.gd"
+
+# Checks our spatial anchors are located in one batch each frame with our static anchors
+# spread out over our update interval, and that they survive a save_anchors/load_anchors round trip.
+# Our scene has one dynamic anchor, with a scaled basis, and STATIC_ANCHORS static anchors.
+
+const STATIC_UPDATE_INTERVAL = 4
+const STATIC_ANCHORS = 4
+const ANCHOR_COUNT = STATIC_ANCHORS + 1
+
+const CREATE_FRAME = 1
+const CHECK_FRAME = 10
+const RELOAD_FRAME = 30
+const RELOAD_CHECK_FRAME = 40
+
+const ANCHORS_PATH = "user://test_anchors.json"
+
+const TOLERANCE = 0.001
+
+var anchors = []
+var expected_transforms = {}
+var anchor_ids = []
+
+func _setup():
+	frame_count = 60
+	$Configuration.anchor_static_update_interval = STATIC_UPDATE_INTERVAL
+
+	anchors = [ $DynamicAnchor ]
+	for i in range(STATIC_ANCHORS):
+		anchors.push_back(get_node("StaticAnchor%d" % [i + 1]))
+
+func _test_frame(p_frame : int):
+	if p_frame == CREATE_FRAME:
+		if !expect($Configuration.is_spatial_anchor_supported(), "spatial anchors are not supported"):
+			return
+
+		for anchor in anchors:
+			# our anchors only keep the rotation of our basis
+			expected_transforms[anchor.name] = Transform(anchor.transform.basis.orthonormalized(), anchor.transform.origin)
+			expect(anchor.create_anchor(anchor != $DynamicAnchor) != "", "couldn't create " + anchor.name)
+
+		anchor_ids = $Configuration.get_anchor_ids()
+		expect(anchor_ids.size() == ANCHOR_COUNT, "we have %d anchors, not %d" % [anchor_ids.size(), ANCHOR_COUNT])
+	elif p_frame == CHECK_FRAME or p_frame == RELOAD_CHECK_FRAME:
+		_check_anchors()
+	elif p_frame == RELOAD_FRAME:
+		expect($Configuration.save_anchors(ANCHORS_PATH), "couldn't save our anchors")
+		$Configuration.clear_anchors()
+		expect($Configuration.get_anchor_ids().empty(), "clear_anchors left anchors behind")
+
+		expect($Configuration.load_anchors(ANCHORS_PATH), "couldn't load our anchors")
+		var loaded_ids = $Configuration.get_anchor_ids()
+		expect(loaded_ids == anchor_ids, "loaded anchors %s, saved %s" % [loaded_ids, anchor_ids])
+
+func _check_anchors():
+	for anchor in anchors:
+		if !expect(anchor.get_tracking_confidence() != 0, anchor.name + " is not tracked"):
+			continue
+
+		var expected : Transform = expected_transforms[anchor.name]
+		expect(anchor.transform.origin.distance_to(expected.origin) < TOLERANCE, "%s is at %s, not %s" % [anchor.name, anchor.transform.origin, expected.origin])
+		expect(anchor.transform.basis.is_equal_approx(expected.basis), "%s is rotated %s, not %s" % [anchor.name, anchor.transform.basis, expected.basis])
+
+func _check_report(p_report : Dictionary):
+	var spatial_anchors : Dictionary = p_report["spatial_anchors"]
+
+	# all our anchors are created again after loading them, and destroyed when our session ends
+	expect(spatial_anchors["created"] == 2 * ANCHOR_COUNT, "created %d runtime anchors, not %d" % [spatial_anchors["created"], 2 * ANCHOR_COUNT])
+	expect(spatial_anchors["destroyed"] == spatial_anchors["created"], "destroyed %d of %d runtime anchors" % [spatial_anchors["destroyed"], spatial_anchors["created"]])
+
+	# New anchors are all located on the frame we create them, after that each frame locates
+	# our dynamic anchor and one of our static anchors.
+	var batch_frames = 0
+	var staggered_frames = 0
+	for located in spatial_anchors["located_per_frame"]:
+		if located > ANCHOR_COUNT:
+			expect(false, "located %d anchors in one frame, we only have %d" % [located, ANCHOR_COUNT])
+		elif located > 2:
+			batch_frames += 1
+		elif located == 2:
+			staggered_frames += 1
+
+	expect(batch_frames <= 2, "located all our anchors on %d frames, static anchors should be staggered" % [batch_frames])
+	expect(staggered_frames >= frame_count - 2 * CHECK_FRAME, "only %d frames located one static anchor" % [staggered_frames])
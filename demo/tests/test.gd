@@ -0,0 +1,115 @@
+extends ARVROrigin
+
+# Base script for our tests, these run against the headless mock runtime, see tools/run_tests.py.
+#
+# A test scene has an OpenXRConfig node called Configuration, extends this script and overrides:
+#   _setup()              called before we initialise OpenXR
+#   _test_frame(p_frame)  called every frame once our session is focused, p_frame starts at 1
+#   _teardown()           called after our last frame, before we uninitialise OpenXR
+#   _check_report(p_report)  called after we uninitialise OpenXR with the report our mock runtime
+#                         wrote to OPENXR_MOCK_REPORT, see tools/mock_runtime/mock_report.cpp
+# Use expect() to check results, we exit with a non-zero exit code if any of them failed.
+
+const STARTUP_TIMEOUT_FRAMES = 600
+
+# Only report this many failures, the same check failing every frame isn't more helpful
+const MAX_REPORTED_FAILURES = 20
+
+# Number of frames we run once our session is focused
+export var frame_count = 90
+
+# Tests that need swapchains turn this off to run with an OpenGL session, these render into our
+# mock runtime's textures so they need a display just like our headless tests.
+export var headless = true
+
+var interface : ARVRInterface
+var focused = false
+var startup_frames = 0
+var frame = 0
+var failures = []
+
+func _setup():
+	pass
+
+func _test_frame(_p_frame : int):
+	pass
+
+func _teardown():
+	pass
+
+func _check_report(_p_report : Dictionary):
+	pass
+
+func expect(p_condition : bool, p_message : String) -> bool:
+	if !p_condition:
+		failures.push_back("frame %d: %s" % [frame, p_message])
+	return p_condition
+
+func _load_text(p_path : String) -> String:
+	var file = File.new()
+	if file.open(p_path, File.READ) != OK:
+		return ""
+
+	var text = file.get_as_text()
+	file.close()
+	return text
+
+func _fail(p_message : String, p_exit_code = 1):
+	printerr(name + " failed: " + p_message)
+	get_tree().quit(p_exit_code)
+	set_process(false)
+
+func _ready():
+	$Configuration.headless = headless
+	_setup()
+
+	interface = ARVRServer.find_interface("OpenXR")
+	if !interface or !interface.initialize():
+		_fail("couldn't initialise OpenXR, is XR_RUNTIME_JSON pointing to our mock runtime?", 2)
+		return
+
+	# our plugin adds its signals when initialising, we only become focused once we process our first frames
+	ARVRServer.connect("openxr_focused_state", self, "_on_focused_state")
+
+	get_viewport().arvr = true
+
+func _on_focused_state():
+	focused = true
+
+func _process(_delta):
+	if !focused:
+		startup_frames += 1
+		if startup_frames > STARTUP_TIMEOUT_FRAMES:
+			_fail("our OpenXR session never got focus", 2)
+		return
+
+	frame += 1
+	_test_frame(frame)
+	if frame >= frame_count:
+		_finish()
+
+func _finish():
+	set_process(false)
+	_teardown()
+	interface.uninitialize()
+
+	# our mock runtime writes its report when our instance is destroyed
+	var report_path = OS.get_environment("OPENXR_MOCK_REPORT")
+	if report_path != "":
+		var report = parse_json(_load_text(report_path))
+		if expect(typeof(report) == TYPE_DICTIONARY, "couldn't read the mock runtime report from " + report_path):
+			# any test fails if our runtime didn't like the layers we submitted or how we used our session
+			for error in report["layer_errors"] + report["session_errors"]:
+				expect(false, "mock runtime: " + error)
+			_check_report(report)
+
+	if failures.empty():
+		print(name + " passed")
+		get_tree().quit(0)
+		return
+
+	for i in range(min(failures.size(), MAX_REPORTED_FAILURES)):
+		printerr(name + " failed: " + failures[i])
+	if failures.size() > MAX_REPORTED_FAILURES:
+		printerr("%s failed %d more checks" % [name, failures.size() - MAX_REPORTED_FAILURES])
+	get_tree().quit(1)
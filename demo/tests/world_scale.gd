@@ -0,0 +1,37 @@
+extends "res://tests/test.gd"
+
+# Checks world scale is applied exactly once to our controllers.
+# Godot scales the positions of ARVRController nodes itself while we scale
+# the positions of our OpenXRPose nodes, so both should end up in the same place.
+
+const WORLD_SCALE = 2.0
+
+# Our mock runtime holds its hands between 0.15 and 0.25 meters to either side
+const HAND_MIN_SIDE = 0.15
+const HAND_MAX_SIDE = 0.25
+
+const TOLERANCE = 0.01
+
+func _setup():
+	ARVRServer.world_scale = WORLD_SCALE
+
+func _test_frame(p_frame : int):
+	# give the runtime a few frames to report our interaction profiles
+	if p_frame < 10:
+		return
+
+	_check_controller($LeftController, $LeftAimPose, ARVRPositionalTracker.TRACKER_LEFT_HAND)
+	_check_controller($RightController, $RightAimPose, ARVRPositionalTracker.TRACKER_RIGHT_HAND)
+
+func _check_controller(p_controller : ARVRController, p_pose : Spatial, p_hand : int):
+	if !expect(p_controller.get_is_active(), p_controller.name + " is not active"):
+		return
+	if !expect(p_controller.get_hand() == p_hand, p_controller.name + " is tracking the wrong hand"):
+		return
+
+	var controller_position = p_controller.transform.origin
+	var pose_position = p_pose.transform.origin
+	expect(controller_position.distance_to(pose_position) < TOLERANCE * WORLD_SCALE, "%s is at %s while %s is at %s" % [p_controller.name, controller_position, p_pose.name, pose_position])
+
+	var side = abs(controller_position.x)
+	expect(side > (HAND_MIN_SIDE - TOLERANCE) * WORLD_SCALE and side < (HAND_MAX_SIDE + TOLERANCE) * WORLD_SCALE, "%s is %f to the side, not scaled by %f" % [p_controller.name, side, WORLD_SCALE])
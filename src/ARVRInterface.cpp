@@ -6,10 +6,15 @@
 #include "openxr/extensions/xr_ext_palm_pose_extension_wrapper.h"
 #include "openxr/extensions/xr_ext_performance_settings_extension_wrapper.h"
 #include "openxr/extensions/xr_fb_color_space_extension_wrapper.h"
+#include "openxr/extensions/xr_fb_composition_layer_settings_extension_wrapper.h"
 #include "openxr/extensions/xr_fb_display_refresh_rate_extension_wrapper.h"
 #include "openxr/extensions/xr_fb_foveation_extension_wrapper.h"
 #include "openxr/extensions/xr_fb_passthrough_extension_wrapper.h"
+#include "openxr/extensions/xr_fb_space_warp_extension_wrapper.h"
 #include "openxr/extensions/xr_fb_swapchain_update_state_extension_wrapper.h"
+#include "openxr/extensions/xr_htcx_vive_tracker_extension_wrapper.h"
+#include "openxr/extensions/xr_khr_composition_layer_cylinder_extension_wrapper.h"
+#include "openxr/extensions/xr_msft_spatial_anchor_extension_wrapper.h"
 #include <ARVRInterface.hpp>
 #include <MainLoop.hpp>
 
@@ -130,6 +135,11 @@ godot_bool godot_arvr_initialize(void *p_data) {
 		arvr_data->openxr_api->register_extension_wrapper<XRExtHandTrackingExtensionWrapper>();
 		arvr_data->openxr_api->register_extension_wrapper<XRFbPassthroughExtensionWrapper>();
 		arvr_data->openxr_api->register_extension_wrapper<XRExtPalmPoseExtensionWrapper>();
+		arvr_data->openxr_api->register_extension_wrapper<XRFbSpaceWarpExtensionWrapper>();
+		arvr_data->openxr_api->register_extension_wrapper<XRFbCompositionLayerSettingsExtensionWrapper>();
+		arvr_data->openxr_api->register_extension_wrapper<XRKhrCompositionLayerCylinderExtensionWrapper>();
+		arvr_data->openxr_api->register_extension_wrapper<XRHtcxViveTrackerExtensionWrapper>();
+		arvr_data->openxr_api->register_extension_wrapper<XRMsftSpatialAnchorExtensionWrapper>();
 
 		// not initialise
 		arvr_data->openxr_api->initialize();
@@ -0,0 +1,121 @@
+/////////////////////////////////////////////////////////////////////////////////////
+// Our OpenXR anchor GDNative object, this follows a spatial anchor
+
+#include <ARVRServer.hpp>
+
+#include "gdclasses/OpenXRAnchor.h"
+
+using namespace godot;
+
+void OpenXRAnchor::_register_methods() {
+	register_method("_enter_tree", &OpenXRAnchor::_enter_tree);
+	register_method("_exit_tree", &OpenXRAnchor::_exit_tree);
+
+	register_method("get_invisible_if_untracked", &OpenXRAnchor::get_invisible_if_untracked);
+	register_method("set_invisible_if_untracked", &OpenXRAnchor::set_invisible_if_untracked);
+	register_property<OpenXRAnchor, bool>(
+			"invisible_if_untracked",
+			&OpenXRAnchor::set_invisible_if_untracked,
+			&OpenXRAnchor::get_invisible_if_untracked,
+			true);
+
+	// The UUID of the anchor we follow, as returned by create_anchor
+	register_method("get_anchor_id", &OpenXRAnchor::get_anchor_id);
+	register_method("set_anchor_id", &OpenXRAnchor::set_anchor_id);
+	register_property<OpenXRAnchor, String>(
+			"anchor_id",
+			&OpenXRAnchor::set_anchor_id,
+			&OpenXRAnchor::get_anchor_id,
+			String());
+
+	register_method("get_tracking_confidence", &OpenXRAnchor::get_tracking_confidence);
+
+	// Create a new anchor where this node currently is and follow it, static anchors are located less often.
+	register_method("create_anchor", &OpenXRAnchor::create_anchor);
+	register_method("remove_anchor", &OpenXRAnchor::remove_anchor);
+}
+
+OpenXRAnchor::OpenXRAnchor() {
+	openxr_api = OpenXRApi::openxr_get_api();
+	spatial_anchor_wrapper = XRMsftSpatialAnchorExtensionWrapper::get_singleton();
+}
+
+OpenXRAnchor::~OpenXRAnchor() {
+	if (openxr_api != nullptr) {
+		OpenXRApi::openxr_release_api();
+	}
+
+	spatial_anchor_wrapper = nullptr;
+}
+
+void OpenXRAnchor::_init() {
+	// nothing to do here
+}
+
+void OpenXRAnchor::_enter_tree() {
+	if (openxr_api != nullptr) {
+		openxr_api->register_pose_listener(this);
+	}
+}
+
+void OpenXRAnchor::_exit_tree() {
+	if (openxr_api != nullptr) {
+		openxr_api->unregister_pose_listener(this);
+	}
+}
+
+void OpenXRAnchor::on_poses_updated(float p_world_scale, const Transform &p_reference_frame) {
+	if (spatial_anchor_wrapper == nullptr || anchor_id.empty()) {
+		confidence = TRACKING_CONFIDENCE_NONE;
+	} else {
+		Transform t;
+		confidence = spatial_anchor_wrapper->get_anchor_transform(anchor_id, p_world_scale, t);
+		if (confidence != TRACKING_CONFIDENCE_NONE) {
+			set_transform(p_reference_frame * t);
+		}
+	}
+
+	if (invisible_if_untracked) {
+		set_visible(confidence != TRACKING_CONFIDENCE_NONE);
+	}
+}
+
+bool OpenXRAnchor::get_invisible_if_untracked() const {
+	return invisible_if_untracked;
+}
+
+void OpenXRAnchor::set_invisible_if_untracked(bool p_hide) {
+	invisible_if_untracked = p_hide;
+}
+
+String OpenXRAnchor::get_anchor_id() const {
+	return anchor_id;
+}
+
+void OpenXRAnchor::set_anchor_id(const String p_anchor_id) {
+	anchor_id = p_anchor_id;
+}
+
+int OpenXRAnchor::get_tracking_confidence() const {
+	return int(confidence);
+}
+
+String OpenXRAnchor::create_anchor(bool p_is_static) {
+	if (spatial_anchor_wrapper == nullptr) {
+		return String();
+	}
+
+	// our transform is relative to our origin node, our anchor is relative to our play space
+	ARVRServer *server = ARVRServer::get_singleton();
+	Transform t = server->get_reference_frame().affine_inverse() * get_transform();
+
+	anchor_id = spatial_anchor_wrapper->create_anchor(t, server->get_world_scale(), p_is_static);
+	return anchor_id;
+}
+
+void OpenXRAnchor::remove_anchor() {
+	if (spatial_anchor_wrapper != nullptr && !anchor_id.empty()) {
+		spatial_anchor_wrapper->remove_anchor(anchor_id);
+	}
+	anchor_id = String();
+}
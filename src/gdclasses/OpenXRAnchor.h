@@ -0,0 +1,48 @@
+/////////////////////////////////////////////////////////////////////////////////////
+// Our OpenXR anchor GDNative object, this follows a spatial anchor
+
+#ifndef OPENXR_ANCHOR_H
+#define OPENXR_ANCHOR_H
+
+#include "openxr/OpenXRApi.h"
+#include "openxr/extensions/xr_msft_spatial_anchor_extension_wrapper.h"
+#include <Spatial.hpp>
+
+namespace godot {
+class OpenXRAnchor : public Spatial, public XRPoseListener {
+	GODOT_CLASS(OpenXRAnchor, Spatial)
+
+private:
+	OpenXRApi *openxr_api;
+	XRMsftSpatialAnchorExtensionWrapper *spatial_anchor_wrapper = nullptr;
+	TrackingConfidence confidence = TRACKING_CONFIDENCE_NONE;
+	bool invisible_if_untracked = true;
+	String anchor_id;
+
+public:
+	static void _register_methods();
+
+	void _init();
+	void _enter_tree();
+	void _exit_tree();
+
+	// Called by OpenXRApi each frame
+	void on_poses_updated(float p_world_scale, const Transform &p_reference_frame) override;
+
+	OpenXRAnchor();
+	~OpenXRAnchor();
+
+	bool get_invisible_if_untracked() const;
+	void set_invisible_if_untracked(bool p_hide);
+
+	String get_anchor_id() const;
+	void set_anchor_id(const String p_anchor_id);
+
+	int get_tracking_confidence() const;
+
+	String create_anchor(bool p_is_static);
+	void remove_anchor();
+};
+} // namespace godot
+
+#endif // !OPENXR_ANCHOR_H
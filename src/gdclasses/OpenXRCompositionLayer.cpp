@@ -0,0 +1,430 @@
+/////////////////////////////////////////////////////////////////////////////////////
+// Our OpenXR composition layer GDNative object, this shows the contents of a viewport
+// on a quad or cylinder that is composited by the OpenXR runtime
+
+#include <ARVROrigin.hpp>
+#include <ARVRServer.hpp>
+#include <ViewportTexture.hpp>
+#include <VisualServer.hpp>
+
+#include "gdclasses/OpenXRCompositionLayer.h"
+
+using namespace godot;
+
+void OpenXRCompositionLayer::_register_methods() {
+	register_method("_enter_tree", &OpenXRCompositionLayer::_enter_tree);
+	register_method("_exit_tree", &OpenXRCompositionLayer::_exit_tree);
+
+	register_method("get_layer_type", &OpenXRCompositionLayer::get_layer_type);
+	register_method("set_layer_type", &OpenXRCompositionLayer::set_layer_type);
+	register_property<OpenXRCompositionLayer, int>("layer_type", &OpenXRCompositionLayer::set_layer_type, &OpenXRCompositionLayer::get_layer_type, LAYER_TYPE_QUAD, GODOT_METHOD_RPC_MODE_DISABLED, GODOT_PROPERTY_USAGE_DEFAULT, GODOT_PROPERTY_HINT_ENUM, "Quad,Cylinder");
+
+	// Note, leave render_target_v_flip off on this viewport, we flip the image while copying it into our swapchain.
+	register_method("get_viewport_path", &OpenXRCompositionLayer::get_viewport_path);
+	register_method("set_viewport_path", &OpenXRCompositionLayer::set_viewport_path);
+	register_property<OpenXRCompositionLayer, NodePath>("viewport_path", &OpenXRCompositionLayer::set_viewport_path, &OpenXRCompositionLayer::get_viewport_path, NodePath());
+
+	// Size of our quad in world units, like our position this is divided by our world scale
+	register_method("get_size", &OpenXRCompositionLayer::get_size);
+	register_method("set_size", &OpenXRCompositionLayer::set_size);
+	register_property<OpenXRCompositionLayer, Vector2>("size", &OpenXRCompositionLayer::set_size, &OpenXRCompositionLayer::get_size, Vector2(1.0, 1.0));
+
+	// Shape of our cylinder, the radius is in world units and the central angle in radians
+	register_method("get_radius", &OpenXRCompositionLayer::get_radius);
+	register_method("set_radius", &OpenXRCompositionLayer::set_radius);
+	register_property<OpenXRCompositionLayer, float>("radius", &OpenXRCompositionLayer::set_radius, &OpenXRCompositionLayer::get_radius, 1.0);
+
+	register_method("get_central_angle", &OpenXRCompositionLayer::get_central_angle);
+	register_method("set_central_angle", &OpenXRCompositionLayer::set_central_angle);
+	register_property<OpenXRCompositionLayer, float>("central_angle", &OpenXRCompositionLayer::set_central_angle, &OpenXRCompositionLayer::get_central_angle, Math_PI / 2.0);
+
+	register_method("get_aspect_ratio", &OpenXRCompositionLayer::get_aspect_ratio);
+	register_method("set_aspect_ratio", &OpenXRCompositionLayer::set_aspect_ratio);
+	register_property<OpenXRCompositionLayer, float>("aspect_ratio", &OpenXRCompositionLayer::set_aspect_ratio, &OpenXRCompositionLayer::get_aspect_ratio, 1.0);
+
+	// Our projection layer sits at 0, layers with a negative sort order are shown behind it.
+	register_method("get_sort_order", &OpenXRCompositionLayer::get_sort_order);
+	register_method("set_sort_order", &OpenXRCompositionLayer::set_sort_order);
+	register_property<OpenXRCompositionLayer, int>("sort_order", &OpenXRCompositionLayer::set_sort_order, &OpenXRCompositionLayer::get_sort_order, 1);
+
+	// By default we only copy our viewport when request_update is called
+	register_method("get_always_update", &OpenXRCompositionLayer::get_always_update);
+	register_method("set_always_update", &OpenXRCompositionLayer::set_always_update);
+	register_property<OpenXRCompositionLayer, bool>("always_update", &OpenXRCompositionLayer::set_always_update, &OpenXRCompositionLayer::get_always_update, false);
+
+	register_method("request_update", &OpenXRCompositionLayer::request_update);
+}
+
+OpenXRCompositionLayer::OpenXRCompositionLayer() {
+	layer_type = LAYER_TYPE_QUAD;
+	size = Vector2(1.0, 1.0);
+	radius = 1.0;
+	central_angle = Math_PI / 2.0;
+	aspect_ratio = 1.0;
+	sort_order = 1;
+	always_update = false;
+	update_requested = true;
+	openxr_api = OpenXRApi::openxr_get_api();
+	cylinder_wrapper = XRKhrCompositionLayerCylinderExtensionWrapper::get_singleton();
+}
+
+OpenXRCompositionLayer::~OpenXRCompositionLayer() {
+	if (openxr_api != nullptr) {
+		OpenXRApi::openxr_release_api();
+	}
+
+	cylinder_wrapper = nullptr;
+}
+
+void OpenXRCompositionLayer::_init() {
+	// nothing to do here
+}
+
+void OpenXRCompositionLayer::_enter_tree() {
+	if (openxr_api != nullptr) {
+		openxr_api->register_composition_layer_provider(this);
+	}
+}
+
+void OpenXRCompositionLayer::_exit_tree() {
+	if (openxr_api != nullptr) {
+		openxr_api->unregister_composition_layer_provider(this);
+	}
+
+	destroy_swapchain();
+
+	if (framebuffers[0] != 0) {
+		glDeleteFramebuffers(2, framebuffers);
+		framebuffers[0] = 0;
+		framebuffers[1] = 0;
+	}
+}
+
+bool OpenXRCompositionLayer::create_swapchain(uint32_t p_width, uint32_t p_height) {
+	// We use the same format as our eye buffers
+	int64_t format = openxr_api->get_swapchain_format();
+	if (format == 0) {
+		return false;
+	}
+
+	XrSwapchainCreateInfo swapchain_create_info = {
+		.type = XR_TYPE_SWAPCHAIN_CREATE_INFO,
+		.next = nullptr,
+		.createFlags = 0,
+		.usageFlags = XR_SWAPCHAIN_USAGE_SAMPLED_BIT | XR_SWAPCHAIN_USAGE_COLOR_ATTACHMENT_BIT,
+		.format = format,
+		.sampleCount = 1,
+		.width = p_width,
+		.height = p_height,
+		.faceCount = 1,
+		.arraySize = 1,
+		.mipCount = 1,
+	};
+
+	XrSession session = openxr_api->get_session();
+	XrResult result = xrCreateSwapchain(session, &swapchain_create_info, &swapchain);
+	if (!openxr_api->xr_result(result, "Failed to create composition layer swapchain")) {
+		swapchain = XR_NULL_HANDLE;
+		return false;
+	}
+
+	swapchain_session = session;
+	swapchain_width = p_width;
+	swapchain_height = p_height;
+
+	uint32_t image_count = 0;
+	result = xrEnumerateSwapchainImages(swapchain, 0, &image_count, nullptr);
+	if (!openxr_api->xr_result(result, "Failed to get composition layer swapchain image count")) {
+		destroy_swapchain();
+		return false;
+	}
+
+	XrSwapchainImageGL image = {};
+	image.type = XR_TYPE_SWAPCHAIN_IMAGE_GL;
+	image.next = nullptr;
+	images.assign(image_count, image);
+
+	result = xrEnumerateSwapchainImages(swapchain, image_count, &image_count, (XrSwapchainImageBaseHeader *)images.data());
+	if (!openxr_api->xr_result(result, "Failed to enumerate composition layer swapchain images")) {
+		destroy_swapchain();
+		return false;
+	}
+
+	return true;
+}
+
+void OpenXRCompositionLayer::destroy_swapchain() {
+	// If our session has been destroyed our swapchain went with it
+	if (swapchain != XR_NULL_HANDLE && swapchain_session != XR_NULL_HANDLE && swapchain_session == openxr_api->get_session()) {
+		xrDestroySwapchain(swapchain);
+	}
+
+	swapchain = XR_NULL_HANDLE;
+	swapchain_session = XR_NULL_HANDLE;
+	swapchain_width = 0;
+	swapchain_height = 0;
+	images.clear();
+	has_released_image = false;
+}
+
+bool OpenXRCompositionLayer::copy_viewport(Viewport *p_viewport) {
+	Ref<ViewportTexture> texture = p_viewport->get_texture();
+	if (texture.is_null()) {
+		return false;
+	}
+
+	GLuint texid = (GLuint)VisualServer::get_singleton()->texture_get_texid(texture->get_rid());
+	if (texid == 0) {
+		return false;
+	}
+
+	uint32_t image_index;
+	XrSwapchainImageAcquireInfo acquire_info = {
+		.type = XR_TYPE_SWAPCHAIN_IMAGE_ACQUIRE_INFO,
+		.next = nullptr
+	};
+	XrResult result = xrAcquireSwapchainImage(swapchain, &acquire_info, &image_index);
+	if (!openxr_api->xr_result(result, "Failed to acquire composition layer swapchain image")) {
+		return false;
+	}
+
+	XrSwapchainImageWaitInfo wait_info = {
+		.type = XR_TYPE_SWAPCHAIN_IMAGE_WAIT_INFO,
+		.next = nullptr,
+		.timeout = 17000000, /* timeout in nanoseconds */
+	};
+	result = xrWaitSwapchainImage(swapchain, &wait_info);
+	bool copied = openxr_api->xr_result(result, "Failed to wait for composition layer swapchain image");
+
+	if (copied) {
+		GLint read_framebuffer, draw_framebuffer;
+		glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &read_framebuffer);
+		glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &draw_framebuffer);
+
+		if (framebuffers[0] == 0) {
+			glGenFramebuffers(2, framebuffers);
+		}
+
+		glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffers[0]);
+		glFramebufferTexture2D(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texid, 0);
+		glBindFramebuffer(GL_DRAW_FRAMEBUFFER, framebuffers[1]);
+		glFramebufferTexture2D(GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, images[image_index].image, 0);
+
+		// Godot's viewport textures are stored upside down compared to what OpenXR expects so we flip while copying.
+		glBlitFramebuffer(0, 0, swapchain_width, swapchain_height, 0, swapchain_height, swapchain_width, 0, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+
+		glBindFramebuffer(GL_READ_FRAMEBUFFER, read_framebuffer);
+		glBindFramebuffer(GL_DRAW_FRAMEBUFFER, draw_framebuffer);
+	}
+
+	// We must always release what we acquired
+	XrSwapchainImageReleaseInfo release_info = {
+		.type = XR_TYPE_SWAPCHAIN_IMAGE_RELEASE_INFO,
+		.next = nullptr
+	};
+	result = xrReleaseSwapchainImage(swapchain, &release_info);
+	if (!openxr_api->xr_result(result, "Failed to release composition layer swapchain image")) {
+		return false;
+	}
+
+	return copied;
+}
+
+XrPosef OpenXRCompositionLayer::get_pose_in_play_space(float p_world_scale) {
+	Transform transform = get_global_transform();
+
+	// Our transform should be relative to our origin node
+	Node *parent = get_parent();
+	while (parent != nullptr) {
+		ARVROrigin *origin = Object::cast_to<ARVROrigin>(parent);
+		if (origin != nullptr) {
+			transform = origin->get_global_transform().affine_inverse() * transform;
+			break;
+		}
+		parent = parent->get_parent();
+	}
+
+	// And remove our reference frame
+	ARVRServer *server = ARVRServer::get_singleton();
+	if (server != nullptr) {
+		transform = server->get_reference_frame().affine_inverse() * transform;
+	}
+
+	Quat q = transform.basis.orthonormalized().get_quat();
+	XrPosef pose = {
+		.orientation = { .x = q.x, .y = q.y, .z = q.z, .w = q.w },
+		.position = {
+				.x = transform.origin.x / p_world_scale,
+				.y = transform.origin.y / p_world_scale,
+				.z = transform.origin.z / p_world_scale,
+		},
+	};
+
+	return pose;
+}
+
+XrCompositionLayerBaseHeader *OpenXRCompositionLayer::get_composition_layer() {
+	if (openxr_api == nullptr || !openxr_api->is_running() || !is_visible_in_tree()) {
+		return nullptr;
+	}
+
+	if (swapchain != XR_NULL_HANDLE && swapchain_session != openxr_api->get_session()) {
+		// Our session was destroyed, we need to start over
+		destroy_swapchain();
+	}
+
+	Viewport *source = Object::cast_to<Viewport>(get_node_or_null(viewport_path));
+	if (source == nullptr) {
+		return nullptr;
+	}
+
+	Vector2 source_size = source->get_size();
+	uint32_t width = (uint32_t)source_size.x;
+	uint32_t height = (uint32_t)source_size.y;
+	if (width == 0 || height == 0) {
+		return nullptr;
+	}
+
+	if (swapchain == XR_NULL_HANDLE || width != swapchain_width || height != swapchain_height) {
+		destroy_swapchain();
+		if (!create_swapchain(width, height)) {
+			return nullptr;
+		}
+		update_requested = true;
+	}
+
+	// Only copy our viewport when needed, the runtime keeps using the last image we released.
+	if (always_update || update_requested) {
+		if (copy_viewport(source)) {
+			update_requested = false;
+			has_released_image = true;
+		}
+	}
+
+	if (!has_released_image) {
+		return nullptr;
+	}
+
+	ARVRServer *server = ARVRServer::get_singleton();
+	float world_scale = server != nullptr ? server->get_world_scale() : 1.0;
+
+	XrSwapchainSubImage sub_image = {
+		.swapchain = swapchain,
+		.imageRect = {
+				.offset = { .x = 0, .y = 0 },
+				.extent = { .width = (int32_t)swapchain_width, .height = (int32_t)swapchain_height },
+		},
+		.imageArrayIndex = 0,
+	};
+
+	if (layer_type == LAYER_TYPE_CYLINDER && cylinder_wrapper != nullptr && cylinder_wrapper->is_cylinder_supported()) {
+		cylinder_layer = XrCompositionLayerCylinderKHR{
+			.type = XR_TYPE_COMPOSITION_LAYER_CYLINDER_KHR,
+			.next = nullptr,
+			.layerFlags = XR_COMPOSITION_LAYER_BLEND_TEXTURE_SOURCE_ALPHA_BIT | XR_COMPOSITION_LAYER_UNPREMULTIPLIED_ALPHA_BIT,
+			.space = openxr_api->get_play_space(),
+			.eyeVisibility = XR_EYE_VISIBILITY_BOTH,
+			.subImage = sub_image,
+			.pose = get_pose_in_play_space(world_scale),
+			.radius = radius / world_scale,
+			.centralAngle = central_angle,
+			.aspectRatio = aspect_ratio,
+		};
+
+		return (XrCompositionLayerBaseHeader *)&cylinder_layer;
+	}
+
+	// If cylinders aren't supported we show a flat quad with the same dimensions
+	XrExtent2Df quad_size = { .width = size.x / world_scale, .height = size.y / world_scale };
+	if (layer_type == LAYER_TYPE_CYLINDER) {
+		quad_size.width = radius / world_scale * central_angle;
+		quad_size.height = aspect_ratio > 0.0 ? quad_size.width / aspect_ratio : quad_size.width;
+	}
+
+	quad_layer = XrCompositionLayerQuad{
+		.type = XR_TYPE_COMPOSITION_LAYER_QUAD,
+		.next = nullptr,
+		.layerFlags = XR_COMPOSITION_LAYER_BLEND_TEXTURE_SOURCE_ALPHA_BIT | XR_COMPOSITION_LAYER_UNPREMULTIPLIED_ALPHA_BIT,
+		.space = openxr_api->get_play_space(),
+		.eyeVisibility = XR_EYE_VISIBILITY_BOTH,
+		.subImage = sub_image,
+		.pose = get_pose_in_play_space(world_scale),
+		.size = quad_size,
+	};
+
+	return (XrCompositionLayerBaseHeader *)&quad_layer;
+}
+
+int OpenXRCompositionLayer::get_layer_type() const {
+	return layer_type;
+}
+
+void OpenXRCompositionLayer::set_layer_type(int p_layer_type) {
+	if (p_layer_type < LAYER_TYPE_QUAD || p_layer_type > LAYER_TYPE_CYLINDER) {
+		Godot::print_error(String("Unknown composition layer type ") + String::num_int64(p_layer_type), __FUNCTION__, __FILE__, __LINE__);
+		return;
+	}
+
+	layer_type = p_layer_type;
+}
+
+NodePath OpenXRCompositionLayer::get_viewport_path() const {
+	return viewport_path;
+}
+
+void OpenXRCompositionLayer::set_viewport_path(const NodePath p_viewport_path) {
+	viewport_path = p_viewport_path;
+	update_requested = true;
+}
+
+Vector2 OpenXRCompositionLayer::get_size() const {
+	return size;
+}
+
+void OpenXRCompositionLayer::set_size(const Vector2 p_size) {
+	size = p_size;
+}
+
+float OpenXRCompositionLayer::get_radius() const {
+	return radius;
+}
+
+void OpenXRCompositionLayer::set_radius(float p_radius) {
+	radius = p_radius;
+}
+
+float OpenXRCompositionLayer::get_central_angle() const {
+	return central_angle;
+}
+
+void OpenXRCompositionLayer::set_central_angle(float p_central_angle) {
+	central_angle = p_central_angle;
+}
+
+float OpenXRCompositionLayer::get_aspect_ratio() const {
+	return aspect_ratio;
+}
+
+void OpenXRCompositionLayer::set_aspect_ratio(float p_aspect_ratio) {
+	aspect_ratio = p_aspect_ratio;
+}
+
+int OpenXRCompositionLayer::get_sort_order() const {
+	return sort_order;
+}
+
+void OpenXRCompositionLayer::set_sort_order(int p_sort_order) {
+	sort_order = p_sort_order;
+}
+
+bool OpenXRCompositionLayer::get_always_update() const {
+	return always_update;
+}
+
+void OpenXRCompositionLayer::set_always_update(bool p_always_update) {
+	always_update = p_always_update;
+}
+
+void OpenXRCompositionLayer::request_update() {
+	update_requested = true;
+}
@@ -0,0 +1,99 @@
+/////////////////////////////////////////////////////////////////////////////////////
+// Our OpenXR composition layer GDNative object, this shows the contents of a viewport
+// on a quad or cylinder that is composited by the OpenXR runtime
+
+#ifndef OPENXR_COMPOSITION_LAYER_H
+#define OPENXR_COMPOSITION_LAYER_H
+
+#include "openxr/OpenXRApi.h"
+#include "openxr/extensions/xr_composition_layer_provider.h"
+#include "openxr/extensions/xr_khr_composition_layer_cylinder_extension_wrapper.h"
+#include <NodePath.hpp>
+#include <Spatial.hpp>
+#include <Viewport.hpp>
+
+#include <vector>
+
+namespace godot {
+class OpenXRCompositionLayer : public Spatial, public XRCompositionLayerProvider {
+	GODOT_CLASS(OpenXRCompositionLayer, Spatial)
+
+public:
+	enum LayerType {
+		LAYER_TYPE_QUAD,
+		LAYER_TYPE_CYLINDER,
+	};
+
+private:
+	OpenXRApi *openxr_api;
+	XRKhrCompositionLayerCylinderExtensionWrapper *cylinder_wrapper = nullptr;
+
+	int layer_type;
+	NodePath viewport_path;
+	Vector2 size;
+	float radius;
+	float central_angle;
+	float aspect_ratio;
+	int sort_order;
+	bool always_update;
+	bool update_requested;
+
+	// The swapchain we copy our viewport into, this belongs to the session it was created with.
+	XrSession swapchain_session = XR_NULL_HANDLE;
+	XrSwapchain swapchain = XR_NULL_HANDLE;
+	std::vector<XrSwapchainImageGL> images;
+	uint32_t swapchain_width = 0;
+	uint32_t swapchain_height = 0;
+	bool has_released_image = false;
+	GLuint framebuffers[2] = { 0, 0 };
+
+	XrCompositionLayerQuad quad_layer;
+	XrCompositionLayerCylinderKHR cylinder_layer;
+
+	bool create_swapchain(uint32_t p_width, uint32_t p_height);
+	void destroy_swapchain();
+	bool copy_viewport(Viewport *p_viewport);
+	XrPosef get_pose_in_play_space(float p_world_scale);
+
+public:
+	static void _register_methods();
+
+	void _init();
+	void _enter_tree();
+	void _exit_tree();
+
+	OpenXRCompositionLayer();
+	~OpenXRCompositionLayer();
+
+	XrCompositionLayerBaseHeader *get_composition_layer() override;
+	int get_composition_layer_order() override { return sort_order; }
+
+	int get_layer_type() const;
+	void set_layer_type(int p_layer_type);
+
+	NodePath get_viewport_path() const;
+	void set_viewport_path(const NodePath p_viewport_path);
+
+	Vector2 get_size() const;
+	void set_size(const Vector2 p_size);
+
+	float get_radius() const;
+	void set_radius(float p_radius);
+
+	float get_central_angle() const;
+	void set_central_angle(float p_central_angle);
+
+	float get_aspect_ratio() const;
+	void set_aspect_ratio(float p_aspect_ratio);
+
+	int get_sort_order() const;
+	void set_sort_order(int p_sort_order);
+
+	bool get_always_update() const;
+	void set_always_update(bool p_always_update);
+
+	void request_update();
+};
+} // namespace godot
+
+#endif // !OPENXR_COMPOSITION_LAYER_H
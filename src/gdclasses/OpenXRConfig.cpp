@@ -4,6 +4,7 @@
 #include <ARVRServer.hpp>
 #include <Dictionary.hpp>
 #include <GlobalConstants.hpp>
+#include <ProjectSettings.hpp>
 
 #include "gdclasses/OpenXRConfig.h"
 
@@ -31,6 +32,11 @@ void OpenXRConfig::_register_methods() {
 	register_method("set_play_space_type", &OpenXRConfig::set_play_space_type);
 	register_property<OpenXRConfig, int>("play_space_type", &OpenXRConfig::set_play_space_type, &OpenXRConfig::get_play_space_type, 2, GODOT_METHOD_RPC_MODE_DISABLED, GODOT_PROPERTY_USAGE_DEFAULT, GODOT_PROPERTY_HINT_ENUM, "View,Local,Stage"); // we don't support XR_REFERENCE_SPACE_TYPE_UNBOUNDED_MSFT and XR_REFERENCE_SPACE_TYPE_COMBINED_EYE_VARJO at this time.
 
+	// Headless mode lets us process input and tracking without a graphics binding, the runtime must support XR_MND_headless.
+	register_method("get_headless", &OpenXRConfig::get_headless);
+	register_method("set_headless", &OpenXRConfig::set_headless);
+	register_property<OpenXRConfig, bool>("headless", &OpenXRConfig::set_headless, &OpenXRConfig::get_headless, false, GODOT_METHOD_RPC_MODE_DISABLED, GODOT_PROPERTY_USAGE_NOEDITOR);
+
 	register_method("get_refresh_rate", &OpenXRConfig::get_refresh_rate);
 	register_method("set_refresh_rate", &OpenXRConfig::set_refresh_rate);
 	register_property<OpenXRConfig, double>("refresh_rate", &OpenXRConfig::set_refresh_rate, &OpenXRConfig::get_refresh_rate, 1, GODOT_METHOD_RPC_MODE_DISABLED, GODOT_PROPERTY_USAGE_NOEDITOR);
@@ -40,6 +46,12 @@ void OpenXRConfig::_register_methods() {
 
 	register_method("get_tracking_confidence", &OpenXRConfig::get_tracking_confidence);
 
+	// Velocities of our ARVRController and ARVRCamera nodes, obtained when we locate their poses
+	register_method("get_controller_linear_velocity", &OpenXRConfig::get_controller_linear_velocity);
+	register_method("get_controller_angular_velocity", &OpenXRConfig::get_controller_angular_velocity);
+	register_method("get_head_linear_velocity", &OpenXRConfig::get_head_linear_velocity);
+	register_method("get_head_angular_velocity", &OpenXRConfig::get_head_angular_velocity);
+
 	register_method("get_action_sets", &OpenXRConfig::get_action_sets);
 	register_method("set_action_sets", &OpenXRConfig::set_action_sets);
 	register_property<OpenXRConfig, String>("action_sets", &OpenXRConfig::set_action_sets, &OpenXRConfig::get_action_sets, String(OpenXRApi::default_action_sets_json), GODOT_METHOD_RPC_MODE_DISABLED, GODOT_PROPERTY_USAGE_DEFAULT, GODOT_PROPERTY_HINT_MULTILINE_TEXT);
@@ -48,6 +60,9 @@ void OpenXRConfig::_register_methods() {
 	register_method("set_interaction_profiles", &OpenXRConfig::set_interaction_profiles);
 	register_property<OpenXRConfig, String>("interaction_profiles", &OpenXRConfig::set_interaction_profiles, &OpenXRConfig::get_interaction_profiles, String(OpenXRApi::default_interaction_profiles_json), GODOT_METHOD_RPC_MODE_DISABLED, GODOT_PROPERTY_USAGE_DEFAULT, GODOT_PROPERTY_HINT_MULTILINE_TEXT);
 
+	// Replace our action sets and interaction profiles while OpenXR is running, our session is recreated if they've changed
+	register_method("reload_action_map", &OpenXRConfig::reload_action_map);
+
 	register_method("get_system_name", &OpenXRConfig::get_system_name);
 
 	register_method("get_cpu_level", &OpenXRConfig::get_cpu_level);
@@ -62,6 +77,53 @@ void OpenXRConfig::_register_methods() {
 	register_method("set_render_target_size_multiplier", &OpenXRConfig::set_render_target_size_multiplier);
 	register_property<OpenXRConfig, double>("render_target_size_multiplier", &OpenXRConfig::set_render_target_size_multiplier, &OpenXRConfig::get_render_target_size_multiplier, 1, GODOT_METHOD_RPC_MODE_DISABLED, GODOT_PROPERTY_USAGE_NOEDITOR);
 
+	register_method("get_swapchain_formats", &OpenXRConfig::get_swapchain_formats);
+	register_method("set_swapchain_formats", &OpenXRConfig::set_swapchain_formats);
+	register_property<OpenXRConfig, Array>("swapchain_formats", &OpenXRConfig::set_swapchain_formats, &OpenXRConfig::get_swapchain_formats, Array::make(SWAPCHAIN_FORMAT_SRGB8_ALPHA8, SWAPCHAIN_FORMAT_RGBA8), GODOT_METHOD_RPC_MODE_DISABLED, GODOT_PROPERTY_USAGE_NOEDITOR);
+	register_method("get_swapchain_format", &OpenXRConfig::get_swapchain_format);
+
+	// CPU time spent in our frame loop, averaged over a number of frames
+	register_method("get_frame_timings_enabled", &OpenXRConfig::get_frame_timings_enabled);
+	register_method("set_frame_timings_enabled", &OpenXRConfig::set_frame_timings_enabled);
+	register_property<OpenXRConfig, bool>("frame_timings_enabled", &OpenXRConfig::set_frame_timings_enabled, &OpenXRConfig::get_frame_timings_enabled, false, GODOT_METHOD_RPC_MODE_DISABLED, GODOT_PROPERTY_USAGE_NOEDITOR);
+
+	register_method("get_frame_timing_budget_usec", &OpenXRConfig::get_frame_timing_budget_usec);
+	register_method("set_frame_timing_budget_usec", &OpenXRConfig::set_frame_timing_budget_usec);
+	register_property<OpenXRConfig, double>("frame_timing_budget_usec", &OpenXRConfig::set_frame_timing_budget_usec, &OpenXRConfig::get_frame_timing_budget_usec, 0.0, GODOT_METHOD_RPC_MODE_DISABLED, GODOT_PROPERTY_USAGE_NOEDITOR);
+	// When built with track_allocations=yes this also reports our allocations in the last window, and the number of windows that allocated while running
+	register_method("get_frame_timings", &OpenXRConfig::get_frame_timings);
+
+	// Record the data we get from the runtime to a file, or replay such a recording instead of using the runtimes data
+	register_method("start_input_recording", &OpenXRConfig::start_input_recording);
+	register_method("start_input_replay", &OpenXRConfig::start_input_replay);
+	register_method("stop_input_recording", &OpenXRConfig::stop_input_recording);
+	register_method("get_input_recording_mode", &OpenXRConfig::get_input_recording_mode);
+
+	// Convert between path strings and OpenXR path ids, conversions are cached for the lifetime of our OpenXR instance
+	register_method("string_to_path", &OpenXRConfig::string_to_path);
+	register_method("path_to_string", &OpenXRConfig::path_to_string);
+
+	// The interaction profile currently active for a top level path, changes are reported with the openxr_interaction_profile_changed signal
+	register_method("get_interaction_profile", &OpenXRConfig::get_interaction_profile);
+
+	// Activate or deactivate action sets at runtime, inactive action sets aren't synced.
+	// Subaction paths limit an action set to specific top level paths, these must be used by the actions in the set.
+	register_method("get_action_set_names", &OpenXRConfig::get_action_set_names);
+	register_method("is_action_set_active", &OpenXRConfig::is_action_set_active);
+	register_method("set_action_set_active", &OpenXRConfig::set_action_set_active);
+	register_method("set_action_set_subaction_paths", &OpenXRConfig::set_action_set_subaction_paths);
+
+	// Report changes to our actions once per frame with the openxr_actions_changed signal on ARVRServer, analog values
+	// only when they change by at least 0.01. Actions that have an input action with the same name (action_set/action)
+	// in the project also send an InputEventAction when pressed or released. The array and dictionaries passed to openxr_actions_changed is reused every frame, duplicate it if you need to keep it.
+	register_method("get_action_events_enabled", &OpenXRConfig::get_action_events_enabled);
+	register_method("set_action_events_enabled", &OpenXRConfig::set_action_events_enabled);
+	register_property<OpenXRConfig, bool>("action_events_enabled", &OpenXRConfig::set_action_events_enabled, &OpenXRConfig::get_action_events_enabled, false);
+
+	// OpenXR errors we've encountered with how often they occurred, repeated errors are only logged occasionally
+	register_method("get_error_counts", &OpenXRConfig::get_error_counts);
+	register_method("clear_error_counts", &OpenXRConfig::clear_error_counts);
+
 	register_method("set_foveation_level", &OpenXRConfig::set_foveation_level);
 
 	register_method("is_passthrough_supported", &OpenXRConfig::is_passthrough_supported);
@@ -69,7 +131,45 @@ void OpenXRConfig::_register_methods() {
 	register_method("start_passthrough", &OpenXRConfig::start_passthrough);
 	register_method("stop_passthrough", &OpenXRConfig::stop_passthrough);
 
+	register_method("is_space_warp_supported", &OpenXRConfig::is_space_warp_supported);
+	register_method("get_space_warp_enabled", &OpenXRConfig::get_space_warp_enabled);
+	register_method("set_space_warp_enabled", &OpenXRConfig::set_space_warp_enabled);
+	register_property<OpenXRConfig, bool>("space_warp_enabled", &OpenXRConfig::set_space_warp_enabled, &OpenXRConfig::get_space_warp_enabled, false, GODOT_METHOD_RPC_MODE_DISABLED, GODOT_PROPERTY_USAGE_DEFAULT);
+	register_method("get_space_warp_frame_rate_divisor", &OpenXRConfig::get_space_warp_frame_rate_divisor);
+	register_method("set_space_warp_frame_rate_divisor", &OpenXRConfig::set_space_warp_frame_rate_divisor);
+	register_property<OpenXRConfig, int>("space_warp_frame_rate_divisor", &OpenXRConfig::set_space_warp_frame_rate_divisor, &OpenXRConfig::get_space_warp_frame_rate_divisor, 1, GODOT_METHOD_RPC_MODE_DISABLED, GODOT_PROPERTY_USAGE_DEFAULT, GODOT_PROPERTY_HINT_RANGE, "1,4");
+	register_method("space_warp_skip_frame", &OpenXRConfig::space_warp_skip_frame);
+	// OpenGL texture ids for the motion vector and depth images of the next frame we submit, the application renders into
+	// these from _process and calls space_warp_images_rendered. Space warp is only used for frames where this happened.
+	register_method("get_space_warp_motion_vector_texture", &OpenXRConfig::get_space_warp_motion_vector_texture);
+	register_method("get_space_warp_depth_texture", &OpenXRConfig::get_space_warp_depth_texture);
+	register_method("space_warp_images_rendered", &OpenXRConfig::space_warp_images_rendered);
+
+	// Spatial anchors keep content in place in the real world, use OpenXRAnchor nodes to follow them.
+	// Anchors are saved with their last known pose relative to our play space.
+	register_method("is_spatial_anchor_supported", &OpenXRConfig::is_spatial_anchor_supported);
+	register_method("create_anchor", &OpenXRConfig::create_anchor);
+	register_method("remove_anchor", &OpenXRConfig::remove_anchor);
+	register_method("clear_anchors", &OpenXRConfig::clear_anchors);
+	register_method("get_anchor_ids", &OpenXRConfig::get_anchor_ids);
+	register_method("get_anchor_static_update_interval", &OpenXRConfig::get_anchor_static_update_interval);
+	register_method("set_anchor_static_update_interval", &OpenXRConfig::set_anchor_static_update_interval);
+	register_property<OpenXRConfig, int>("anchor_static_update_interval", &OpenXRConfig::set_anchor_static_update_interval, &OpenXRConfig::get_anchor_static_update_interval, 30, GODOT_METHOD_RPC_MODE_DISABLED, GODOT_PROPERTY_USAGE_NOEDITOR);
+	register_method("save_anchors", &OpenXRConfig::save_anchors);
+	register_method("load_anchors", &OpenXRConfig::load_anchors);
+
+	register_method("get_supersampling_mode", &OpenXRConfig::get_supersampling_mode);
+	register_method("set_supersampling_mode", &OpenXRConfig::set_supersampling_mode);
+	register_property<OpenXRConfig, int>("supersampling_mode", &OpenXRConfig::set_supersampling_mode, &OpenXRConfig::get_supersampling_mode, 0, GODOT_METHOD_RPC_MODE_DISABLED, GODOT_PROPERTY_USAGE_DEFAULT, GODOT_PROPERTY_HINT_ENUM, "None,Normal,Quality");
+
+	register_method("get_sharpening_mode", &OpenXRConfig::get_sharpening_mode);
+	register_method("set_sharpening_mode", &OpenXRConfig::set_sharpening_mode);
+	register_property<OpenXRConfig, int>("sharpening_mode", &OpenXRConfig::set_sharpening_mode, &OpenXRConfig::get_sharpening_mode, 0, GODOT_METHOD_RPC_MODE_DISABLED, GODOT_PROPERTY_USAGE_DEFAULT, GODOT_PROPERTY_HINT_ENUM, "None,Normal,Quality");
+
+	// Our play area, relative to our origin node. Bounds are cached until the runtime reports a change.
 	register_method("get_play_space", &OpenXRConfig::get_play_space);
+	register_method("get_play_space_boundary", &OpenXRConfig::get_play_space_boundary);
+	register_method("get_distance_to_play_space_boundary", &OpenXRConfig::get_distance_to_play_space_boundary);
 }
 
 OpenXRConfig::OpenXRConfig() {
@@ -80,6 +180,9 @@ OpenXRConfig::OpenXRConfig() {
 	performance_settings_wrapper = XRExtPerformanceSettingsExtensionWrapper::get_singleton();
 	passthrough_wrapper = XRFbPassthroughExtensionWrapper::get_singleton();
 	hand_tracking_wrapper = XRExtHandTrackingExtensionWrapper::get_singleton();
+	space_warp_wrapper = XRFbSpaceWarpExtensionWrapper::get_singleton();
+	composition_layer_settings_wrapper = XRFbCompositionLayerSettingsExtensionWrapper::get_singleton();
+	spatial_anchor_wrapper = XRMsftSpatialAnchorExtensionWrapper::get_singleton();
 }
 
 OpenXRConfig::~OpenXRConfig() {
@@ -92,6 +195,9 @@ OpenXRConfig::~OpenXRConfig() {
 	performance_settings_wrapper = nullptr;
 	passthrough_wrapper = nullptr;
 	hand_tracking_wrapper = nullptr;
+	space_warp_wrapper = nullptr;
+	composition_layer_settings_wrapper = nullptr;
+	spatial_anchor_wrapper = nullptr;
 }
 
 void OpenXRConfig::_init() {
@@ -194,6 +300,22 @@ godot::Dictionary OpenXRConfig::get_available_color_spaces() {
 	}
 }
 
+bool OpenXRConfig::get_headless() const {
+	if (openxr_api == nullptr) {
+		return false;
+	} else {
+		return openxr_api->is_headless();
+	}
+}
+
+void OpenXRConfig::set_headless(const bool p_headless) {
+	if (openxr_api == nullptr) {
+		Godot::print("OpenXR object wasn't constructed.");
+	} else {
+		openxr_api->set_headless(p_headless);
+	}
+}
+
 int OpenXRConfig::get_play_space_type() const {
 	if (openxr_api == nullptr) {
 		return XR_REFERENCE_SPACE_TYPE_STAGE;
@@ -285,6 +407,50 @@ int OpenXRConfig::get_tracking_confidence(const int p_godot_controller) const {
 	return confidence;
 }
 
+Vector3 OpenXRConfig::get_controller_linear_velocity(const int p_godot_controller) const {
+	Vector3 linear, angular;
+	if (openxr_api != nullptr) {
+		ARVRServer *server = ARVRServer::get_singleton();
+		if (openxr_api->get_controller_velocity(p_godot_controller, server->get_world_scale(), linear, angular)) {
+			return server->get_reference_frame().basis.xform(linear);
+		}
+	}
+	return Vector3();
+}
+
+Vector3 OpenXRConfig::get_controller_angular_velocity(const int p_godot_controller) const {
+	Vector3 linear, angular;
+	if (openxr_api != nullptr) {
+		ARVRServer *server = ARVRServer::get_singleton();
+		if (openxr_api->get_controller_velocity(p_godot_controller, server->get_world_scale(), linear, angular)) {
+			return server->get_reference_frame().basis.xform(angular);
+		}
+	}
+	return Vector3();
+}
+
+Vector3 OpenXRConfig::get_head_linear_velocity() const {
+	Vector3 linear, angular;
+	if (openxr_api != nullptr) {
+		ARVRServer *server = ARVRServer::get_singleton();
+		if (openxr_api->get_head_velocity(server->get_world_scale(), linear, angular)) {
+			return server->get_reference_frame().basis.xform(linear);
+		}
+	}
+	return Vector3();
+}
+
+Vector3 OpenXRConfig::get_head_angular_velocity() const {
+	Vector3 linear, angular;
+	if (openxr_api != nullptr) {
+		ARVRServer *server = ARVRServer::get_singleton();
+		if (openxr_api->get_head_velocity(server->get_world_scale(), linear, angular)) {
+			return server->get_reference_frame().basis.xform(angular);
+		}
+	}
+	return Vector3();
+}
+
 String OpenXRConfig::get_action_sets() const {
 	if (openxr_api == nullptr) {
 		return String();
@@ -317,6 +483,15 @@ void OpenXRConfig::set_interaction_profiles(const String p_interaction_profiles)
 	}
 }
 
+bool OpenXRConfig::reload_action_map(const String p_action_sets, const String p_interaction_profiles) {
+	if (openxr_api == nullptr) {
+		Godot::print("OpenXR object wasn't constructed.");
+		return false;
+	}
+
+	return openxr_api->reload_action_map(p_action_sets, p_interaction_profiles);
+}
+
 String OpenXRConfig::get_system_name() const {
 	if (openxr_api == nullptr) {
 		return String();
@@ -367,6 +542,221 @@ void OpenXRConfig::set_render_target_size_multiplier(double multiplier) {
 	}
 }
 
+godot::Array OpenXRConfig::get_swapchain_formats() const {
+	Array arr;
+
+	if (openxr_api != nullptr) {
+		const std::vector<SwapchainFormat> &formats = openxr_api->get_swapchain_format_preference();
+		for (uint64_t i = 0; i < formats.size(); i++) {
+			arr.push_back(formats[i]);
+		}
+	}
+
+	return arr;
+}
+
+void OpenXRConfig::set_swapchain_formats(const godot::Array p_swapchain_formats) {
+	if (openxr_api != nullptr) {
+		// Formats are listed from most to least preferred, we fall back to the first format the runtime supports if none are available.
+		std::vector<SwapchainFormat> formats;
+		for (int i = 0; i < p_swapchain_formats.size(); i++) {
+			int format = p_swapchain_formats[i];
+			formats.push_back(static_cast<SwapchainFormat>(format));
+		}
+
+		openxr_api->set_swapchain_format_preference(formats);
+	}
+}
+
+String OpenXRConfig::get_swapchain_format() const {
+	if (openxr_api == nullptr) {
+		return String();
+	} else {
+		return openxr_api->get_selected_swapchain_format_name();
+	}
+}
+
+bool OpenXRConfig::get_frame_timings_enabled() const {
+	if (openxr_api == nullptr) {
+		return false;
+	} else {
+		return openxr_api->get_frame_timings_enabled();
+	}
+}
+
+void OpenXRConfig::set_frame_timings_enabled(const bool p_enabled) {
+	if (openxr_api == nullptr) {
+		Godot::print("OpenXR object wasn't constructed.");
+	} else {
+		openxr_api->set_frame_timings_enabled(p_enabled);
+	}
+}
+
+double OpenXRConfig::get_frame_timing_budget_usec() const {
+	if (openxr_api == nullptr) {
+		return 0.0;
+	} else {
+		return openxr_api->get_frame_timing_budget_ns() / 1000.0;
+	}
+}
+
+void OpenXRConfig::set_frame_timing_budget_usec(const double p_budget_usec) {
+	if (openxr_api == nullptr) {
+		Godot::print("OpenXR object wasn't constructed.");
+	} else if (p_budget_usec < 0.0) {
+		Godot::print_error("Frame timing budget can't be negative", __FUNCTION__, __FILE__, __LINE__);
+	} else {
+		openxr_api->set_frame_timing_budget_ns((uint64_t)(p_budget_usec * 1000.0));
+	}
+}
+
+godot::Dictionary OpenXRConfig::get_frame_timings() const {
+	Dictionary timings;
+
+	if (openxr_api != nullptr) {
+		int64_t total_ns = 0;
+		for (int i = 0; i < FRAME_TIMING_MAX; i++) {
+			FrameTiming timing = FrameTiming(i);
+			Dictionary entry;
+			entry["average_ns"] = (int64_t)openxr_api->get_frame_timing_average_ns(timing);
+			entry["max_ns"] = (int64_t)openxr_api->get_frame_timing_max_ns(timing);
+			timings[OpenXRApi::get_frame_timing_name(timing)] = entry;
+
+			total_ns += (int64_t)openxr_api->get_frame_timing_average_ns(timing);
+		}
+		timings["total_ns"] = total_ns;
+
+		if (AllocationTracker::is_enabled()) {
+			timings["allocations"] = (int64_t)openxr_api->get_frame_timing_allocations();
+			timings["allocation_failures"] = (int64_t)openxr_api->get_frame_timing_allocation_failures();
+		}
+	}
+
+	return timings;
+}
+
+bool OpenXRConfig::start_input_recording(const String p_path) {
+	if (openxr_api == nullptr) {
+		Godot::print("OpenXR object wasn't constructed.");
+		return false;
+	}
+
+	String path = ProjectSettings::get_singleton()->globalize_path(p_path);
+	return openxr_api->get_input_recorder()->start_recording(path.utf8().get_data());
+}
+
+bool OpenXRConfig::start_input_replay(const String p_path) {
+	if (openxr_api == nullptr) {
+		Godot::print("OpenXR object wasn't constructed.");
+		return false;
+	}
+
+	String path = ProjectSettings::get_singleton()->globalize_path(p_path);
+	return openxr_api->get_input_recorder()->start_replay(path.utf8().get_data());
+}
+
+void OpenXRConfig::stop_input_recording() {
+	if (openxr_api != nullptr) {
+		openxr_api->get_input_recorder()->stop();
+	}
+}
+
+int OpenXRConfig::get_input_recording_mode() const {
+	if (openxr_api == nullptr) {
+		return int(InputRecorder::MODE_OFF);
+	}
+
+	return int(openxr_api->get_input_recorder()->get_mode());
+}
+
+int64_t OpenXRConfig::string_to_path(const String p_path) {
+	if (openxr_api == nullptr) {
+		return (int64_t)XR_NULL_PATH;
+	}
+
+	return (int64_t)openxr_api->get_path(p_path);
+}
+
+String OpenXRConfig::path_to_string(const int64_t p_path) {
+	if (openxr_api == nullptr) {
+		return String();
+	}
+
+	return openxr_api->get_path_string((XrPath)p_path);
+}
+
+String OpenXRConfig::get_interaction_profile(const String p_toplevel_path) const {
+	if (openxr_api == nullptr) {
+		return String();
+	}
+
+	return openxr_api->get_interaction_profile(p_toplevel_path);
+}
+
+godot::Array OpenXRConfig::get_action_set_names() const {
+	if (openxr_api == nullptr) {
+		return godot::Array();
+	}
+
+	return openxr_api->get_action_set_names();
+}
+
+bool OpenXRConfig::is_action_set_active(const String p_name) const {
+	if (openxr_api == nullptr) {
+		return false;
+	}
+
+	return openxr_api->is_action_set_active(p_name);
+}
+
+bool OpenXRConfig::set_action_set_active(const String p_name, const bool p_active) {
+	if (openxr_api == nullptr) {
+		Godot::print("OpenXR object wasn't constructed.");
+		return false;
+	}
+
+	return openxr_api->set_action_set_active(p_name, p_active);
+}
+
+bool OpenXRConfig::set_action_set_subaction_paths(const String p_name, const PoolStringArray p_paths) {
+	if (openxr_api == nullptr) {
+		Godot::print("OpenXR object wasn't constructed.");
+		return false;
+	}
+
+	return openxr_api->set_action_set_subaction_paths(p_name, p_paths);
+}
+
+bool OpenXRConfig::get_action_events_enabled() const {
+	if (openxr_api == nullptr) {
+		return false;
+	} else {
+		return openxr_api->get_action_events_enabled();
+	}
+}
+
+void OpenXRConfig::set_action_events_enabled(const bool p_enabled) {
+	if (openxr_api == nullptr) {
+		Godot::print("OpenXR object wasn't constructed.");
+	} else {
+		openxr_api->set_action_events_enabled(p_enabled);
+	}
+}
+
+godot::Array OpenXRConfig::get_error_counts() const {
+	if (openxr_api == nullptr) {
+		return godot::Array();
+	}
+
+	return openxr_api->get_error_counts();
+}
+
+void OpenXRConfig::clear_error_counts() {
+	if (openxr_api != nullptr) {
+		openxr_api->clear_error_counts();
+	}
+}
+
 void OpenXRConfig::set_foveation_level(int level, bool is_dynamic) {
 	if (foveation_wrapper != nullptr) {
 		XrFoveationDynamicFB foveation_dynamic = is_dynamic ? XR_FOVEATION_DYNAMIC_LEVEL_ENABLED_FB : XR_FOVEATION_DYNAMIC_DISABLED_FB;
@@ -392,6 +782,163 @@ void OpenXRConfig::stop_passthrough() {
 	}
 }
 
+bool OpenXRConfig::is_space_warp_supported() {
+	return space_warp_wrapper != nullptr && space_warp_wrapper->is_space_warp_supported();
+}
+
+bool OpenXRConfig::get_space_warp_enabled() const {
+	return space_warp_wrapper != nullptr && space_warp_wrapper->is_space_warp_enabled();
+}
+
+void OpenXRConfig::set_space_warp_enabled(const bool p_enabled) {
+	if (space_warp_wrapper != nullptr) {
+		space_warp_wrapper->set_space_warp_enabled(p_enabled);
+	}
+}
+
+int OpenXRConfig::get_space_warp_frame_rate_divisor() const {
+	if (space_warp_wrapper == nullptr) {
+		return 1;
+	} else {
+		return space_warp_wrapper->get_frame_rate_divisor();
+	}
+}
+
+void OpenXRConfig::set_space_warp_frame_rate_divisor(const int p_divisor) {
+	if (space_warp_wrapper != nullptr) {
+		space_warp_wrapper->set_frame_rate_divisor(p_divisor);
+	}
+}
+
+void OpenXRConfig::space_warp_skip_frame() {
+	if (space_warp_wrapper != nullptr) {
+		space_warp_wrapper->skip_frame();
+	}
+}
+
+int OpenXRConfig::get_space_warp_motion_vector_texture(const int p_eye) const {
+	if (space_warp_wrapper == nullptr || p_eye < 0) {
+		return 0;
+	}
+
+	return space_warp_wrapper->get_motion_vector_texture(p_eye);
+}
+
+int OpenXRConfig::get_space_warp_depth_texture(const int p_eye) const {
+	if (space_warp_wrapper == nullptr || p_eye < 0) {
+		return 0;
+	}
+
+	return space_warp_wrapper->get_depth_texture(p_eye);
+}
+
+void OpenXRConfig::space_warp_images_rendered() {
+	if (space_warp_wrapper != nullptr) {
+		space_warp_wrapper->mark_images_rendered();
+	}
+}
+
+bool OpenXRConfig::is_spatial_anchor_supported() const {
+	return spatial_anchor_wrapper != nullptr && spatial_anchor_wrapper->is_spatial_anchor_supported();
+}
+
+String OpenXRConfig::create_anchor(const Transform p_transform, const bool p_is_static) {
+	if (spatial_anchor_wrapper == nullptr) {
+		return String();
+	}
+
+	// p_transform is relative to our origin node, our anchor is relative to our play space
+	ARVRServer *server = ARVRServer::get_singleton();
+	Transform t = server->get_reference_frame().affine_inverse() * p_transform;
+	return spatial_anchor_wrapper->create_anchor(t, server->get_world_scale(), p_is_static);
+}
+
+bool OpenXRConfig::remove_anchor(const String p_uuid) {
+	return spatial_anchor_wrapper != nullptr && spatial_anchor_wrapper->remove_anchor(p_uuid);
+}
+
+void OpenXRConfig::clear_anchors() {
+	if (spatial_anchor_wrapper != nullptr) {
+		spatial_anchor_wrapper->clear_anchors();
+	}
+}
+
+godot::Array OpenXRConfig::get_anchor_ids() const {
+	if (spatial_anchor_wrapper == nullptr) {
+		return Array();
+	}
+
+	return spatial_anchor_wrapper->get_anchor_ids();
+}
+
+int OpenXRConfig::get_anchor_static_update_interval() const {
+	if (spatial_anchor_wrapper == nullptr) {
+		return 30;
+	}
+
+	return spatial_anchor_wrapper->get_static_update_interval();
+}
+
+void OpenXRConfig::set_anchor_static_update_interval(const int p_frames) {
+	if (spatial_anchor_wrapper != nullptr) {
+		spatial_anchor_wrapper->set_static_update_interval(p_frames);
+	}
+}
+
+bool OpenXRConfig::save_anchors(const String p_path) {
+	if (spatial_anchor_wrapper == nullptr) {
+		return false;
+	}
+
+	String path = ProjectSettings::get_singleton()->globalize_path(p_path);
+	return spatial_anchor_wrapper->save_anchors(path.utf8().get_data());
+}
+
+bool OpenXRConfig::load_anchors(const String p_path) {
+	if (spatial_anchor_wrapper == nullptr) {
+		return false;
+	}
+
+	String path = ProjectSettings::get_singleton()->globalize_path(p_path);
+	return spatial_anchor_wrapper->load_anchors(path.utf8().get_data());
+}
+
+int OpenXRConfig::get_supersampling_mode() const {
+	if (composition_layer_settings_wrapper == nullptr) {
+		return XRFbCompositionLayerSettingsExtensionWrapper::FILTER_MODE_NONE;
+	} else {
+		return composition_layer_settings_wrapper->get_supersampling_mode();
+	}
+}
+
+void OpenXRConfig::set_supersampling_mode(const int p_mode) {
+	if (composition_layer_settings_wrapper == nullptr) {
+		return;
+	} else if (p_mode < XRFbCompositionLayerSettingsExtensionWrapper::FILTER_MODE_NONE || p_mode > XRFbCompositionLayerSettingsExtensionWrapper::FILTER_MODE_QUALITY) {
+		Godot::print_error(String("Unknown supersampling mode ") + String::num_int64(p_mode), __FUNCTION__, __FILE__, __LINE__);
+	} else {
+		composition_layer_settings_wrapper->set_supersampling_mode(static_cast<XRFbCompositionLayerSettingsExtensionWrapper::FilterMode>(p_mode));
+	}
+}
+
+int OpenXRConfig::get_sharpening_mode() const {
+	if (composition_layer_settings_wrapper == nullptr) {
+		return XRFbCompositionLayerSettingsExtensionWrapper::FILTER_MODE_NONE;
+	} else {
+		return composition_layer_settings_wrapper->get_sharpening_mode();
+	}
+}
+
+void OpenXRConfig::set_sharpening_mode(const int p_mode) {
+	if (composition_layer_settings_wrapper == nullptr) {
+		return;
+	} else if (p_mode < XRFbCompositionLayerSettingsExtensionWrapper::FILTER_MODE_NONE || p_mode > XRFbCompositionLayerSettingsExtensionWrapper::FILTER_MODE_QUALITY) {
+		Godot::print_error(String("Unknown sharpening mode ") + String::num_int64(p_mode), __FUNCTION__, __FILE__, __LINE__);
+	} else {
+		composition_layer_settings_wrapper->set_sharpening_mode(static_cast<XRFbCompositionLayerSettingsExtensionWrapper::FilterMode>(p_mode));
+	}
+}
+
 godot::Array OpenXRConfig::get_play_space() {
 	ARVRServer *server = ARVRServer::get_singleton();
 	Array arr;
@@ -425,3 +972,33 @@ godot::Array OpenXRConfig::get_play_space() {
 
 	return arr;
 }
+
+godot::Array OpenXRConfig::get_play_space_boundary() {
+	ARVRServer *server = ARVRServer::get_singleton();
+	Array arr;
+
+	if (openxr_api && server) {
+		PoolVector2Array boundary = openxr_api->get_play_space_boundary();
+		const float ws = server->get_world_scale();
+		const Transform reference_frame = server->get_reference_frame();
+
+		for (int i = 0; i < boundary.size(); i++) {
+			Vector2 point = boundary[i];
+			arr.push_back(reference_frame.xform(Vector3(point.x, 0.0, point.y) * ws));
+		}
+	}
+
+	return arr;
+}
+
+float OpenXRConfig::get_distance_to_play_space_boundary(const Vector3 p_position) {
+	ARVRServer *server = ARVRServer::get_singleton();
+	if (openxr_api == nullptr || server == nullptr) {
+		return 0.0;
+	}
+
+	// p_position is relative to our origin node
+	const float ws = server->get_world_scale();
+	Vector3 position = server->get_reference_frame().affine_inverse().xform(p_position) / ws;
+	return openxr_api->get_distance_to_play_space_boundary(position) * ws;
+}
@@ -8,9 +8,12 @@
 #include "openxr/extensions/xr_ext_hand_tracking_extension_wrapper.h"
 #include "openxr/extensions/xr_ext_performance_settings_extension_wrapper.h"
 #include "openxr/extensions/xr_fb_color_space_extension_wrapper.h"
+#include "openxr/extensions/xr_fb_composition_layer_settings_extension_wrapper.h"
 #include "openxr/extensions/xr_fb_display_refresh_rate_extension_wrapper.h"
 #include "openxr/extensions/xr_fb_foveation_extension_wrapper.h"
 #include "openxr/extensions/xr_fb_passthrough_extension_wrapper.h"
+#include "openxr/extensions/xr_fb_space_warp_extension_wrapper.h"
+#include "openxr/extensions/xr_msft_spatial_anchor_extension_wrapper.h"
 #include <Node.hpp>
 
 namespace godot {
@@ -25,6 +28,9 @@ private:
 	XRExtPerformanceSettingsExtensionWrapper *performance_settings_wrapper = nullptr;
 	XRFbPassthroughExtensionWrapper *passthrough_wrapper = nullptr;
 	XRExtHandTrackingExtensionWrapper *hand_tracking_wrapper = nullptr;
+	XRFbSpaceWarpExtensionWrapper *space_warp_wrapper = nullptr;
+	XRFbCompositionLayerSettingsExtensionWrapper *composition_layer_settings_wrapper = nullptr;
+	XRMsftSpatialAnchorExtensionWrapper *spatial_anchor_wrapper = nullptr;
 
 public:
 	// For Godot we can't have gaps in our enums so we define our own where needed.
@@ -66,6 +72,9 @@ public:
 	void set_color_space(const int p_color_space);
 	godot::Dictionary get_available_color_spaces();
 
+	bool get_headless() const;
+	void set_headless(const bool p_headless);
+
 	int get_play_space_type() const;
 	void set_play_space_type(const int p_play_space_type);
 
@@ -76,6 +85,10 @@ public:
 	godot::Array get_enabled_extensions() const;
 
 	int get_tracking_confidence(const int p_godot_controller) const;
+	Vector3 get_controller_linear_velocity(const int p_godot_controller) const;
+	Vector3 get_controller_angular_velocity(const int p_godot_controller) const;
+	Vector3 get_head_linear_velocity() const;
+	Vector3 get_head_angular_velocity() const;
 
 	String get_action_sets() const;
 	void set_action_sets(const String p_action_sets);
@@ -83,6 +96,8 @@ public:
 	String get_interaction_profiles() const;
 	void set_interaction_profiles(const String p_interaction_profiles);
 
+	bool reload_action_map(const String p_action_sets, const String p_interaction_profiles);
+
 	String get_system_name() const;
 
 	int get_cpu_level() const;
@@ -94,6 +109,37 @@ public:
 	double get_render_target_size_multiplier() const;
 	void set_render_target_size_multiplier(double multiplier);
 
+	godot::Array get_swapchain_formats() const;
+	void set_swapchain_formats(const godot::Array p_swapchain_formats);
+	String get_swapchain_format() const;
+
+	bool get_frame_timings_enabled() const;
+	void set_frame_timings_enabled(const bool p_enabled);
+	double get_frame_timing_budget_usec() const;
+	void set_frame_timing_budget_usec(const double p_budget_usec);
+	godot::Dictionary get_frame_timings() const;
+
+	bool start_input_recording(const String p_path);
+	bool start_input_replay(const String p_path);
+	void stop_input_recording();
+	int get_input_recording_mode() const;
+
+	int64_t string_to_path(const String p_path);
+	String path_to_string(const int64_t p_path);
+
+	String get_interaction_profile(const String p_toplevel_path) const;
+
+	godot::Array get_action_set_names() const;
+	bool is_action_set_active(const String p_name) const;
+	bool set_action_set_active(const String p_name, const bool p_active);
+	bool set_action_set_subaction_paths(const String p_name, const PoolStringArray p_paths);
+
+	bool get_action_events_enabled() const;
+	void set_action_events_enabled(const bool p_enabled);
+
+	godot::Array get_error_counts() const;
+	void clear_error_counts();
+
 	void set_foveation_level(int level, bool is_dynamic);
 
 	bool is_passthrough_supported();
@@ -101,7 +147,35 @@ public:
 	bool start_passthrough();
 	void stop_passthrough();
 
+	bool is_space_warp_supported();
+	bool get_space_warp_enabled() const;
+	void set_space_warp_enabled(const bool p_enabled);
+	int get_space_warp_frame_rate_divisor() const;
+	void set_space_warp_frame_rate_divisor(const int p_divisor);
+	void space_warp_skip_frame();
+	int get_space_warp_motion_vector_texture(const int p_eye) const;
+	int get_space_warp_depth_texture(const int p_eye) const;
+	void space_warp_images_rendered();
+
+	bool is_spatial_anchor_supported() const;
+	String create_anchor(const Transform p_transform, const bool p_is_static);
+	bool remove_anchor(const String p_uuid);
+	void clear_anchors();
+	godot::Array get_anchor_ids() const;
+	int get_anchor_static_update_interval() const;
+	void set_anchor_static_update_interval(const int p_frames);
+	bool save_anchors(const String p_path);
+	bool load_anchors(const String p_path);
+
+	int get_supersampling_mode() const;
+	void set_supersampling_mode(const int p_mode);
+
+	int get_sharpening_mode() const;
+	void set_sharpening_mode(const int p_mode);
+
 	godot::Array get_play_space();
+	godot::Array get_play_space_boundary();
+	float get_distance_to_play_space_boundary(const Vector3 p_position);
 };
 } // namespace godot
 
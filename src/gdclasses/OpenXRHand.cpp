@@ -8,6 +8,8 @@
 using namespace godot;
 
 void OpenXRHand::_register_methods() {
+	register_method("_enter_tree", &OpenXRHand::_enter_tree);
+	register_method("_exit_tree", &OpenXRHand::_exit_tree);
 	register_method("_ready", &OpenXRHand::_ready);
 	register_method("_physics_process", &OpenXRHand::_physics_process);
 
@@ -19,6 +21,10 @@ void OpenXRHand::_register_methods() {
 	register_method("set_motion_range", &OpenXRHand::set_motion_range);
 	register_property<OpenXRHand, int>("motion_range", &OpenXRHand::set_motion_range, &OpenXRHand::get_motion_range, 0, GODOT_METHOD_RPC_MODE_DISABLED, GODOT_PROPERTY_USAGE_DEFAULT, GODOT_PROPERTY_HINT_ENUM, "Unobstructed,Conform to controller");
 
+	register_method("get_update_mode", &OpenXRHand::get_update_mode);
+	register_method("set_update_mode", &OpenXRHand::set_update_mode);
+	register_property<OpenXRHand, int>("update_mode", &OpenXRHand::set_update_mode, &OpenXRHand::get_update_mode, POSE_UPDATE_MODE_RENDER, GODOT_METHOD_RPC_MODE_DISABLED, GODOT_PROPERTY_USAGE_DEFAULT, GODOT_PROPERTY_HINT_ENUM, "Render,Physics");
+
 	register_method("is_active", &OpenXRHand::is_active);
 }
 
@@ -84,9 +90,55 @@ void OpenXRHand::_ready() {
 	}
 
 	_set_motion_range();
+
+	// Godot enables physics processing before calling _ready because we have a _physics_process
+	apply_update_mode();
+}
+
+void OpenXRHand::_enter_tree() {
+	apply_update_mode();
+}
+
+void OpenXRHand::_exit_tree() {
+	if (openxr_api != nullptr) {
+		openxr_api->unregister_pose_listener(this);
+	}
+}
+
+int OpenXRHand::get_update_mode() const {
+	return update_mode;
+}
+
+void OpenXRHand::set_update_mode(int p_update_mode) {
+	update_mode = p_update_mode == POSE_UPDATE_MODE_PHYSICS ? POSE_UPDATE_MODE_PHYSICS : POSE_UPDATE_MODE_RENDER;
+	apply_update_mode();
+}
+
+void OpenXRHand::apply_update_mode() {
+	if (openxr_api == nullptr) {
+		return;
+	}
+
+	const bool in_tree = is_inside_tree();
+	if (in_tree && update_mode == POSE_UPDATE_MODE_RENDER) {
+		openxr_api->register_pose_listener(this);
+	} else {
+		openxr_api->unregister_pose_listener(this);
+	}
+	set_physics_process(in_tree && update_mode == POSE_UPDATE_MODE_PHYSICS);
+}
+
+void OpenXRHand::on_poses_updated(float p_world_scale, const Transform &p_reference_frame) {
+	update_joints(p_world_scale, p_reference_frame);
 }
 
 void OpenXRHand::_physics_process(float delta) {
+	// We don't keep a history of joint locations so we use the latest data we have
+	ARVRServer *server = ARVRServer::get_singleton();
+	update_joints(server->get_world_scale(), server->get_reference_frame());
+}
+
+void OpenXRHand::update_joints(float p_world_scale, const Transform &p_reference_frame) {
 	if (openxr_api == nullptr || hand_tracking_wrapper == nullptr) {
 		return;
 	} else if (!openxr_api->is_initialised()) {
@@ -122,18 +174,19 @@ void OpenXRHand::_physics_process(float delta) {
 		24, // XR_HAND_JOINT_LITTLE_TIP_EXT = 25,
 	};
 
-	// we cache the inverse of our transforms so we can quickly calculate local transforms
+	// we cache our transforms and their inverse so we can quickly calculate local transforms
+	Transform transforms[XR_HAND_JOINT_COUNT_EXT];
 	Transform inv_transforms[XR_HAND_JOINT_COUNT_EXT];
 
 	const HandTracker *hand_tracker = hand_tracking_wrapper->get_hand_tracker(hand);
-	ARVRServer *server = ARVRServer::get_singleton();
-	const float ws = server->get_world_scale();
-	Transform reference_frame = server->get_reference_frame();
+	const float ws = p_world_scale;
+	const Transform &reference_frame = p_reference_frame;
 
 	if (hand_tracker->is_initialised && hand_tracker->locations.isActive) {
+		openxr_api->transform_from_locations(hand_tracker->joint_locations, XR_HAND_JOINT_COUNT_EXT, ws, transforms);
+
 		for (int i = 0; i < XR_HAND_JOINT_COUNT_EXT; i++) {
-			Transform t;
-			openxr_api->transform_from_location(hand_tracker->joint_locations[i], ws, t);
+			Transform t = transforms[i];
 			// store the inverse to make live easier later on
 			inv_transforms[i] = t.inverse();
 
@@ -10,7 +10,7 @@
 #include <Spatial.hpp>
 
 namespace godot {
-class OpenXRHand : public Spatial {
+class OpenXRHand : public Spatial, public XRPoseListener {
 	GODOT_CLASS(OpenXRHand, Spatial)
 
 private:
@@ -18,6 +18,9 @@ private:
 	XRExtHandTrackingExtensionWrapper *hand_tracking_wrapper = nullptr;
 	int hand;
 	int motion_range;
+	int update_mode = POSE_UPDATE_MODE_RENDER;
+	void apply_update_mode();
+	void update_joints(float p_world_scale, const Transform &p_reference_frame);
 
 	Spatial *joints[XR_HAND_JOINT_COUNT_EXT];
 	void _set_motion_range();
@@ -26,9 +29,14 @@ public:
 	static void _register_methods();
 
 	void _init();
+	void _enter_tree();
+	void _exit_tree();
 	void _ready();
 	void _physics_process(float delta);
 
+	// Called by OpenXRApi each frame when our update mode is render
+	void on_poses_updated(float p_world_scale, const Transform &p_reference_frame) override;
+
 	OpenXRHand();
 	~OpenXRHand();
 
@@ -39,6 +47,9 @@ public:
 
 	int get_motion_range() const;
 	void set_motion_range(int p_motion_range);
+
+	int get_update_mode() const;
+	void set_update_mode(int p_update_mode);
 };
 } // namespace godot
 
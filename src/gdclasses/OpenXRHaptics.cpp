@@ -0,0 +1,234 @@
+/////////////////////////////////////////////////////////////////////////////////////
+// Our OpenXR haptics GDNative object, this plays haptic effects on a vibration action
+
+#include <Dictionary.hpp>
+
+#include "gdclasses/OpenXRHaptics.h"
+
+using namespace godot;
+
+void OpenXRHaptics::_register_methods() {
+	register_method("_exit_tree", &OpenXRHaptics::_exit_tree);
+
+	register_method("get_action", &OpenXRHaptics::get_action);
+	register_method("set_action", &OpenXRHaptics::set_action);
+	register_property<OpenXRHaptics, String>(
+			"action",
+			&OpenXRHaptics::set_action,
+			&OpenXRHaptics::get_action,
+			String("godot/haptic"));
+
+	// For now this is hard coded, these are fixed entries based on the OpenXR spec
+	register_method("get_path", &OpenXRHaptics::get_path);
+	register_method("set_path", &OpenXRHaptics::set_path);
+	register_property<OpenXRHaptics, String>(
+			"path",
+			&OpenXRHaptics::set_path,
+			&OpenXRHaptics::get_path,
+			String("/user/hand/left"),
+			GODOT_METHOD_RPC_MODE_DISABLED,
+			GODOT_PROPERTY_USAGE_DEFAULT,
+			GODOT_PROPERTY_HINT_ENUM,
+			"/user/hand/left,/user/hand/right");
+
+	// Duration in seconds, frequency in Hz (0.0 lets the runtime decide), amplitude between 0.0 and 1.0
+	register_method("play_pulse", &OpenXRHaptics::play_pulse);
+
+	// Effects are an array of dictionaries with a duration, frequency and amplitude entry and optionally
+	// an amplitude_end entry to ramp our amplitude over the duration. The effect is played repeat + 1 times.
+	// play_effect replaces anything we're playing, queue_effect plays it after what we're playing.
+	register_method("play_effect", &OpenXRHaptics::play_effect);
+	register_method("queue_effect", &OpenXRHaptics::queue_effect);
+	register_method("stop", &OpenXRHaptics::stop);
+	register_method("is_playing", &OpenXRHaptics::is_playing);
+}
+
+OpenXRHaptics::OpenXRHaptics() {
+	action = String("godot/haptic");
+	_action = nullptr;
+	path = String("/user/hand/left");
+	_path = XR_NULL_PATH;
+	openxr_api = OpenXRApi::openxr_get_api();
+}
+
+OpenXRHaptics::~OpenXRHaptics() {
+	if (openxr_api != nullptr) {
+		OpenXRApi::openxr_release_api();
+	}
+}
+
+void OpenXRHaptics::_init() {
+	// nothing to do here
+}
+
+void OpenXRHaptics::_exit_tree() {
+	// don't leave our controller vibrating
+	stop();
+}
+
+bool OpenXRHaptics::check_action_and_path() {
+	if (openxr_api == nullptr || !openxr_api->is_initialised()) {
+		return false;
+	}
+
+	// not yet ready?
+	if (!openxr_api->has_action_sets()) {
+		return false;
+	}
+
+	// our action sets were reloaded, our cached action is no longer valid
+	if (action_sets_generation != openxr_api->get_action_sets_generation()) {
+		action_sets_generation = openxr_api->get_action_sets_generation();
+		_action = nullptr;
+		fail_cache = false;
+	}
+
+	// don't keep trying this over and over and over again if we fail
+	if (fail_cache) {
+		return false;
+	}
+
+	if (_action == nullptr) {
+		Array split = action.split("/");
+		if (split.size() != 2) {
+			Godot::print("Incorrect action string {0}", action);
+			fail_cache = true;
+			return false;
+		}
+
+		ActionSet *aset = openxr_api->get_action_set(split[0]);
+		if (aset == nullptr) {
+			Godot::print("Couldn't find action set {0}", split[0]);
+			fail_cache = true;
+			return false;
+		}
+
+		_action = aset->get_action(split[1]);
+		if (_action == nullptr) {
+			Godot::print("Couldn't find action {0}", split[1]);
+			fail_cache = true;
+			return false;
+		} else if (_action->get_type() != XR_ACTION_TYPE_VIBRATION_OUTPUT) {
+			Godot::print("Action {0} is not a vibration action", action);
+			_action = nullptr;
+			fail_cache = true;
+			return false;
+		}
+	}
+
+	if (_path == XR_NULL_PATH) {
+		_path = openxr_api->get_path(path);
+		if (_path == XR_NULL_PATH) {
+			fail_cache = true;
+			return false;
+		}
+	}
+
+	return true;
+}
+
+String OpenXRHaptics::get_action() const {
+	return action;
+}
+
+void OpenXRHaptics::set_action(const String p_action) {
+	stop();
+
+	action = p_action;
+	_action = nullptr;
+	fail_cache = false;
+}
+
+String OpenXRHaptics::get_path() const {
+	return path;
+}
+
+void OpenXRHaptics::set_path(const String p_path) {
+	stop();
+
+	path = p_path;
+	_path = XR_NULL_PATH;
+	fail_cache = false;
+}
+
+bool OpenXRHaptics::parse_effect(const Array &p_segments, int p_repeat) {
+	segments.clear();
+
+	for (int i = 0; i < p_segments.size(); i++) {
+		if (p_segments[i].get_type() != Variant::DICTIONARY) {
+			Godot::print_error("Haptic effect segments must be dictionaries", __FUNCTION__, __FILE__, __LINE__);
+			return false;
+		}
+
+		Dictionary entry = p_segments[i];
+		HapticScheduler::HapticSegment segment;
+
+		const double duration = entry.has("duration") ? double(entry["duration"]) : 0.0;
+		segment.duration = XrDuration(duration * 1000000000.0);
+
+		const float frequency = entry.has("frequency") ? float(entry["frequency"]) : 0.0;
+		segment.frequency = frequency > 0.0 ? frequency : XR_FREQUENCY_UNSPECIFIED;
+
+		segment.amplitude = entry.has("amplitude") ? float(entry["amplitude"]) : 0.0;
+		segment.amplitude_end = entry.has("amplitude_end") ? float(entry["amplitude_end"]) : segment.amplitude;
+
+		segments.push_back(segment);
+	}
+
+	// repeat our pattern
+	const size_t count = segments.size();
+	for (int r = 0; r < p_repeat; r++) {
+		for (size_t i = 0; i < count; i++) {
+			segments.push_back(segments[i]);
+		}
+	}
+
+	return !segments.empty();
+}
+
+void OpenXRHaptics::submit(const Array &p_segments, int p_repeat, bool p_replace) {
+	if (!check_action_and_path()) {
+		return;
+	}
+
+	if (parse_effect(p_segments, p_repeat)) {
+		openxr_api->get_haptic_scheduler()->submit(_action, _path, segments.data(), uint32_t(segments.size()), p_replace);
+	}
+}
+
+void OpenXRHaptics::play_pulse(float p_duration, float p_frequency, float p_amplitude) {
+	if (!check_action_and_path()) {
+		return;
+	}
+
+	HapticScheduler::HapticSegment segment = {
+		.duration = XrDuration(double(p_duration) * 1000000000.0),
+		.frequency = p_frequency > 0.0 ? p_frequency : XR_FREQUENCY_UNSPECIFIED,
+		.amplitude = p_amplitude,
+		.amplitude_end = p_amplitude,
+	};
+	openxr_api->get_haptic_scheduler()->submit(_action, _path, &segment, 1, true);
+}
+
+void OpenXRHaptics::play_effect(const Array p_segments, int p_repeat) {
+	submit(p_segments, p_repeat, true);
+}
+
+void OpenXRHaptics::queue_effect(const Array p_segments, int p_repeat) {
+	submit(p_segments, p_repeat, false);
+}
+
+void OpenXRHaptics::stop() {
+	// only if we've resolved our action, otherwise there is nothing to stop
+	if (_action != nullptr && _path != XR_NULL_PATH && openxr_api != nullptr) {
+		openxr_api->get_haptic_scheduler()->stop(_action, _path);
+	}
+}
+
+bool OpenXRHaptics::is_playing() {
+	if (!check_action_and_path()) {
+		return false;
+	}
+
+	return openxr_api->get_haptic_scheduler()->is_playing(_action, _path);
+}
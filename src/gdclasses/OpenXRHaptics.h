@@ -0,0 +1,57 @@
+/////////////////////////////////////////////////////////////////////////////////////
+// Our OpenXR haptics GDNative object, this plays haptic effects on a vibration action
+
+#ifndef OPENXR_HAPTICS_H
+#define OPENXR_HAPTICS_H
+
+#include "openxr/OpenXRApi.h"
+#include <Array.hpp>
+#include <Node.hpp>
+
+#include <vector>
+
+namespace godot {
+class OpenXRHaptics : public Node {
+	GODOT_CLASS(OpenXRHaptics, Node)
+
+private:
+	OpenXRApi *openxr_api;
+	String action;
+	String path;
+
+	// cache action and path
+	bool fail_cache = false;
+	uint64_t action_sets_generation = 0;
+	Action *_action;
+	XrPath _path;
+	bool check_action_and_path();
+
+	// converted segments, reused between calls
+	std::vector<HapticScheduler::HapticSegment> segments;
+	bool parse_effect(const Array &p_segments, int p_repeat);
+	void submit(const Array &p_segments, int p_repeat, bool p_replace);
+
+public:
+	static void _register_methods();
+
+	void _init();
+	void _exit_tree();
+
+	OpenXRHaptics();
+	~OpenXRHaptics();
+
+	String get_action() const;
+	void set_action(const String p_action);
+
+	String get_path() const;
+	void set_path(const String p_path);
+
+	void play_pulse(float p_duration, float p_frequency, float p_amplitude);
+	void play_effect(const Array p_segments, int p_repeat);
+	void queue_effect(const Array p_segments, int p_repeat);
+	void stop();
+	bool is_playing();
+};
+} // namespace godot
+
+#endif // !OPENXR_HAPTICS_H
@@ -8,8 +8,17 @@
 using namespace godot;
 
 void OpenXRPose::_register_methods() {
+	register_method("_enter_tree", &OpenXRPose::_enter_tree);
+	register_method("_exit_tree", &OpenXRPose::_exit_tree);
+	register_method("_ready", &OpenXRPose::_ready);
 	register_method("_physics_process", &OpenXRPose::_physics_process);
 
+	// Render updates us once per frame with the pose for the frame we're about to render,
+	// Physics updates us every physics tick with the pose for the time that tick simulates.
+	register_method("get_update_mode", &OpenXRPose::get_update_mode);
+	register_method("set_update_mode", &OpenXRPose::set_update_mode);
+	register_property<OpenXRPose, int>("update_mode", &OpenXRPose::set_update_mode, &OpenXRPose::get_update_mode, POSE_UPDATE_MODE_RENDER, GODOT_METHOD_RPC_MODE_DISABLED, GODOT_PROPERTY_USAGE_DEFAULT, GODOT_PROPERTY_HINT_ENUM, "Render,Physics");
+
 	register_method("get_invisible_if_inactive", &OpenXRPose::get_invisible_if_inactive);
 	register_method("set_invisible_if_inactive", &OpenXRPose::set_invisible_if_inactive);
 	register_property<OpenXRPose, bool>(
@@ -49,6 +58,14 @@ void OpenXRPose::_register_methods() {
 
 	register_method("is_active", &OpenXRPose::is_active);
 	register_method("get_tracking_confidence", &OpenXRPose::get_tracking_confidence);
+
+	// Velocities as reported by the OpenXR runtime, in our parents space.
+	register_method("get_linear_velocity", &OpenXRPose::get_linear_velocity);
+	register_method("get_angular_velocity", &OpenXRPose::get_angular_velocity);
+
+	// Look up our pose a number of seconds before (negative) or after (positive) our current pose,
+	// this uses the poses we've recently located and doesn't call into the OpenXR runtime.
+	register_method("get_transform_at_offset", &OpenXRPose::get_transform_at_offset);
 }
 
 OpenXRPose::OpenXRPose() {
@@ -73,12 +90,57 @@ void OpenXRPose::_init() {
 	// nothing to do here
 }
 
+void OpenXRPose::_enter_tree() {
+	apply_update_mode();
+}
+
+void OpenXRPose::_ready() {
+	// Godot enables physics processing before calling _ready because we have a _physics_process
+	apply_update_mode();
+}
+
+void OpenXRPose::_exit_tree() {
+	if (openxr_api != nullptr) {
+		openxr_api->unregister_pose_listener(this);
+	}
+}
+
+int OpenXRPose::get_update_mode() const {
+	return update_mode;
+}
+
+void OpenXRPose::set_update_mode(int p_update_mode) {
+	update_mode = p_update_mode == POSE_UPDATE_MODE_PHYSICS ? POSE_UPDATE_MODE_PHYSICS : POSE_UPDATE_MODE_RENDER;
+	apply_update_mode();
+}
+
+void OpenXRPose::apply_update_mode() {
+	if (openxr_api == nullptr) {
+		return;
+	}
+
+	const bool in_tree = is_inside_tree();
+	if (in_tree && update_mode == POSE_UPDATE_MODE_RENDER) {
+		openxr_api->register_pose_listener(this);
+	} else {
+		openxr_api->unregister_pose_listener(this);
+	}
+	set_physics_process(in_tree && update_mode == POSE_UPDATE_MODE_PHYSICS);
+}
+
 bool OpenXRPose::check_action_and_path() {
 	// not yet ready?
 	if (!openxr_api->has_action_sets()) {
 		return false;
 	}
 
+	// our action sets were reloaded, our cached action is no longer valid
+	if (action_sets_generation != openxr_api->get_action_sets_generation()) {
+		action_sets_generation = openxr_api->get_action_sets_generation();
+		_action = nullptr;
+		fail_cache = false;
+	}
+
 	// don't keep trying this over and over and over again if we fail
 	if (fail_cache) {
 		return false;
@@ -108,8 +170,8 @@ bool OpenXRPose::check_action_and_path() {
 	}
 
 	if (_path == XR_NULL_PATH) {
-		XrResult res = xrStringToPath(openxr_api->get_instance(), path.utf8().get_data(), &_path);
-		if (!openxr_api->xr_result(res, "Couldn't obtain path {0}", path)) {
+		_path = openxr_api->get_path(path);
+		if (_path == XR_NULL_PATH) {
 			fail_cache = true;
 			return false;
 		}
@@ -118,10 +180,21 @@ bool OpenXRPose::check_action_and_path() {
 	return true;
 }
 
+void OpenXRPose::on_poses_updated(float p_world_scale, const Transform &p_reference_frame) {
+	update_pose(p_world_scale, p_reference_frame, 0);
+}
+
 void OpenXRPose::_physics_process(float delta) {
-	if (openxr_api == nullptr || hand_tracking_wrapper == nullptr) {
+	if (openxr_api == nullptr || !openxr_api->is_running()) {
 		return;
-	} else if (!openxr_api->is_initialised()) {
+	}
+
+	ARVRServer *server = ARVRServer::get_singleton();
+	update_pose(server->get_world_scale(), server->get_reference_frame(), openxr_api->get_physics_frame_time());
+}
+
+void OpenXRPose::update_pose(float p_world_scale, const Transform &p_reference_frame, XrTime p_time) {
+	if (hand_tracking_wrapper == nullptr) {
 		return;
 	}
 
@@ -129,27 +202,48 @@ void OpenXRPose::_physics_process(float delta) {
 		set_visible(is_active());
 	}
 
-	ARVRServer *server = ARVRServer::get_singleton();
-	const float ws = server->get_world_scale();
-	Transform reference_frame = server->get_reference_frame();
+	const float ws = p_world_scale;
+	const Transform &reference_frame = p_reference_frame;
 
-	if (action == "SkeletonBase") {
-		if (path == "/user/hand/left") {
-			const HandTracker *hand_tracker = hand_tracking_wrapper->get_hand_tracker(0);
-			Transform t;
-			confidence = openxr_api->transform_from_location(hand_tracker->joint_locations[XR_HAND_JOINT_PALM_EXT], ws, t);
-			set_transform(reference_frame * t);
-		} else if (path == "/user/hand/right") {
-			const HandTracker *hand_tracker = hand_tracking_wrapper->get_hand_tracker(1);
+	Vector3 linear;
+	Vector3 angular;
+
+	if (skeleton_base) {
+		if (skeleton_hand != -1) {
+			const HandTracker *hand_tracker = hand_tracking_wrapper->get_hand_tracker(skeleton_hand);
 			Transform t;
 			confidence = openxr_api->transform_from_location(hand_tracker->joint_locations[XR_HAND_JOINT_PALM_EXT], ws, t);
 			set_transform(reference_frame * t);
+
+			const XrHandJointVelocityEXT &velocity = hand_tracker->joint_velocities[XR_HAND_JOINT_PALM_EXT];
+			if (velocity.velocityFlags & XR_SPACE_VELOCITY_LINEAR_VALID_BIT) {
+				linear = Vector3(velocity.linearVelocity.x, velocity.linearVelocity.y, velocity.linearVelocity.z) * ws;
+			}
+			if (velocity.velocityFlags & XR_SPACE_VELOCITY_ANGULAR_VALID_BIT) {
+				angular = Vector3(velocity.angularVelocity.x, velocity.angularVelocity.y, velocity.angularVelocity.z);
+			}
 		}
 	} else if (check_action_and_path()) {
 		Transform t;
 		confidence = _action->get_as_pose(_path, ws, t);
+		if (p_time != 0 && confidence != TRACKING_CONFIDENCE_NONE) {
+			// get_as_pose has added this frames pose to our history, we can now find our pose for the requested time
+			Transform t_at_time;
+			TrackingConfidence confidence_at_time = _action->get_pose_at_time(_path, p_time, ws, t_at_time);
+			if (confidence_at_time != TRACKING_CONFIDENCE_NONE) {
+				t = t_at_time;
+				confidence = confidence_at_time;
+			}
+		}
 		set_transform(reference_frame * t);
+
+		// obtained by the locate above, no extra call into the runtime
+		_action->get_velocity(_path, ws, linear, angular);
 	}
+
+	// our velocities are in play space, rotate them into our parents space
+	linear_velocity = reference_frame.basis.xform(linear);
+	angular_velocity = reference_frame.basis.xform(angular);
 }
 
 bool OpenXRPose::is_active() {
@@ -159,13 +253,9 @@ bool OpenXRPose::is_active() {
 		return false;
 	}
 
-	if (action == "SkeletonBase") {
-		if (path == "/user/hand/left") {
-			const HandTracker *hand_tracker = hand_tracking_wrapper->get_hand_tracker(0);
-
-			return (hand_tracker->is_initialised && hand_tracker->locations.isActive);
-		} else if (path == "/user/hand/right") {
-			const HandTracker *hand_tracker = hand_tracking_wrapper->get_hand_tracker(1);
+	if (skeleton_base) {
+		if (skeleton_hand != -1) {
+			const HandTracker *hand_tracker = hand_tracking_wrapper->get_hand_tracker(skeleton_hand);
 
 			return (hand_tracker->is_initialised && hand_tracker->locations.isActive);
 		}
@@ -192,6 +282,7 @@ void OpenXRPose::set_action(const String p_action) {
 	action = p_action;
 	_action = nullptr;
 	fail_cache = false;
+	update_skeleton_hand();
 }
 
 String OpenXRPose::get_path() const {
@@ -202,8 +293,54 @@ void OpenXRPose::set_path(const String p_path) {
 	path = p_path;
 	_path = XR_NULL_PATH;
 	fail_cache = false;
+	update_skeleton_hand();
+}
+
+void OpenXRPose::update_skeleton_hand() {
+	skeleton_base = action == "SkeletonBase";
+
+	if (path == "/user/hand/left") {
+		skeleton_hand = 0;
+	} else if (path == "/user/hand/right") {
+		skeleton_hand = 1;
+	} else {
+		skeleton_hand = -1;
+	}
 }
 
 int OpenXRPose::get_tracking_confidence() const {
 	return int(confidence);
 }
+
+Vector3 OpenXRPose::get_linear_velocity() const {
+	return linear_velocity;
+}
+
+Vector3 OpenXRPose::get_angular_velocity() const {
+	return angular_velocity;
+}
+
+Transform OpenXRPose::get_transform_at_offset(float p_offset) {
+	if (openxr_api == nullptr || !openxr_api->is_initialised()) {
+		return get_transform();
+	}
+
+	// Our hand skeleton doesn't keep a history
+	if (skeleton_base || !check_action_and_path()) {
+		return get_transform();
+	}
+
+	XrTime time = openxr_api->get_next_frame_time();
+	if (time == 0) {
+		return get_transform();
+	}
+	time += (XrDuration)(p_offset * 1000000000.0);
+
+	ARVRServer *server = ARVRServer::get_singleton();
+	Transform t;
+	if (_action->get_pose_at_time(_path, time, server->get_world_scale(), t) == TRACKING_CONFIDENCE_NONE) {
+		return get_transform();
+	}
+
+	return server->get_reference_frame() * t;
+}
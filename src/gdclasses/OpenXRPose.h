@@ -9,34 +9,54 @@
 #include <Spatial.hpp>
 
 namespace godot {
-class OpenXRPose : public Spatial {
+class OpenXRPose : public Spatial, public XRPoseListener {
 	GODOT_CLASS(OpenXRPose, Spatial)
 
 private:
 	OpenXRApi *openxr_api;
 	TrackingConfidence confidence = TRACKING_CONFIDENCE_NONE;
+	Vector3 linear_velocity;
+	Vector3 angular_velocity;
 	XRExtHandTrackingExtensionWrapper *hand_tracking_wrapper = nullptr;
 	bool invisible_if_inactive = true;
+	int update_mode = POSE_UPDATE_MODE_RENDER;
+	void apply_update_mode();
+	void update_pose(float p_world_scale, const Transform &p_reference_frame, XrTime p_time);
 	String action;
 	String path;
 
 	// cache action and path
 	bool fail_cache = false;
+	uint64_t action_sets_generation = 0;
 	Action *_action;
 	XrPath _path;
 	bool check_action_and_path();
 
+	// resolved when action or path changes so we don't compare strings every frame
+	bool skeleton_base = true;
+	int skeleton_hand = 0; // -1 if our path isn't a hand
+	void update_skeleton_hand();
+
 public:
 	static void _register_methods();
 
 	void _init();
+	void _enter_tree();
+	void _exit_tree();
+	void _ready();
 	void _physics_process(float delta);
 
+	// Called by OpenXRApi each frame when our update mode is render
+	void on_poses_updated(float p_world_scale, const Transform &p_reference_frame) override;
+
 	OpenXRPose();
 	~OpenXRPose();
 
 	bool is_active();
 
+	int get_update_mode() const;
+	void set_update_mode(int p_update_mode);
+
 	bool get_invisible_if_inactive() const;
 	void set_invisible_if_inactive(bool hide);
 
@@ -47,6 +67,10 @@ public:
 	void set_path(const String p_path);
 
 	int get_tracking_confidence() const;
+	Vector3 get_linear_velocity() const;
+	Vector3 get_angular_velocity() const;
+
+	Transform get_transform_at_offset(float p_offset);
 };
 } // namespace godot
 
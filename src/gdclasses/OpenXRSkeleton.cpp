@@ -8,6 +8,8 @@
 using namespace godot;
 
 void OpenXRSkeleton::_register_methods() {
+	register_method("_enter_tree", &OpenXRSkeleton::_enter_tree);
+	register_method("_exit_tree", &OpenXRSkeleton::_exit_tree);
 	register_method("_ready", &OpenXRSkeleton::_ready);
 	register_method("_physics_process", &OpenXRSkeleton::_physics_process);
 
@@ -18,6 +20,10 @@ void OpenXRSkeleton::_register_methods() {
 	register_method("get_motion_range", &OpenXRSkeleton::get_motion_range);
 	register_method("set_motion_range", &OpenXRSkeleton::set_motion_range);
 	register_property<OpenXRSkeleton, int>("motion_range", &OpenXRSkeleton::set_motion_range, &OpenXRSkeleton::get_motion_range, 0, GODOT_METHOD_RPC_MODE_DISABLED, GODOT_PROPERTY_USAGE_DEFAULT, GODOT_PROPERTY_HINT_ENUM, "Unobstructed,Conform to controller");
+
+	register_method("get_update_mode", &OpenXRSkeleton::get_update_mode);
+	register_method("set_update_mode", &OpenXRSkeleton::set_update_mode);
+	register_property<OpenXRSkeleton, int>("update_mode", &OpenXRSkeleton::set_update_mode, &OpenXRSkeleton::get_update_mode, POSE_UPDATE_MODE_RENDER, GODOT_METHOD_RPC_MODE_DISABLED, GODOT_PROPERTY_USAGE_DEFAULT, GODOT_PROPERTY_HINT_ENUM, "Render,Physics");
 }
 
 OpenXRSkeleton::OpenXRSkeleton() {
@@ -89,9 +95,55 @@ void OpenXRSkeleton::_ready() {
 	}
 
 	_set_motion_range();
+
+	// Godot enables physics processing before calling _ready because we have a _physics_process
+	apply_update_mode();
+}
+
+void OpenXRSkeleton::_enter_tree() {
+	apply_update_mode();
+}
+
+void OpenXRSkeleton::_exit_tree() {
+	if (openxr_api != nullptr) {
+		openxr_api->unregister_pose_listener(this);
+	}
+}
+
+int OpenXRSkeleton::get_update_mode() const {
+	return update_mode;
+}
+
+void OpenXRSkeleton::set_update_mode(int p_update_mode) {
+	update_mode = p_update_mode == POSE_UPDATE_MODE_PHYSICS ? POSE_UPDATE_MODE_PHYSICS : POSE_UPDATE_MODE_RENDER;
+	apply_update_mode();
+}
+
+void OpenXRSkeleton::apply_update_mode() {
+	if (openxr_api == nullptr) {
+		return;
+	}
+
+	const bool in_tree = is_inside_tree();
+	if (in_tree && update_mode == POSE_UPDATE_MODE_RENDER) {
+		openxr_api->register_pose_listener(this);
+	} else {
+		openxr_api->unregister_pose_listener(this);
+	}
+	set_physics_process(in_tree && update_mode == POSE_UPDATE_MODE_PHYSICS);
+}
+
+void OpenXRSkeleton::on_poses_updated(float p_world_scale, const Transform &p_reference_frame) {
+	update_joints(p_world_scale, p_reference_frame);
 }
 
 void OpenXRSkeleton::_physics_process(float delta) {
+	// We don't keep a history of joint locations so we use the latest data we have
+	ARVRServer *server = ARVRServer::get_singleton();
+	update_joints(server->get_world_scale(), server->get_reference_frame());
+}
+
+void OpenXRSkeleton::update_joints(float p_world_scale, const Transform &p_reference_frame) {
 	if (openxr_api == nullptr || hand_tracking_wrapper == nullptr) {
 		return;
 	} else if (!openxr_api->is_initialised()) {
@@ -103,12 +155,12 @@ void OpenXRSkeleton::_physics_process(float delta) {
 	Transform inv_transforms[XR_HAND_JOINT_COUNT_EXT];
 
 	const HandTracker *hand_tracker = hand_tracking_wrapper->get_hand_tracker(hand);
-	const float ws = ARVRServer::get_singleton()->get_world_scale();
+	const float ws = p_world_scale;
 
 	if (hand_tracker->is_initialised && hand_tracker->locations.isActive) {
 		// get our transforms
+		openxr_api->transform_from_locations(hand_tracker->joint_locations, XR_HAND_JOINT_COUNT_EXT, ws, transforms);
 		for (int i = 0; i < XR_HAND_JOINT_COUNT_EXT; i++) {
-			openxr_api->transform_from_location(hand_tracker->joint_locations[i], ws, transforms[i]);
 			inv_transforms[i] = transforms[i].inverse();
 		}
 
@@ -5,16 +5,22 @@
 // with loads of help from Thomas "Karroffel" Herzog
 
 #include "godot_openxr.h"
+#include "gdclasses/OpenXRAnchor.h"
+#include "gdclasses/OpenXRCompositionLayer.h"
 #include "gdclasses/OpenXRConfig.h"
 #include "gdclasses/OpenXRHand.h"
+#include "gdclasses/OpenXRHaptics.h"
 #include "gdclasses/OpenXRPose.h"
 #include "gdclasses/OpenXRSkeleton.h"
+#include "openxr/allocation_tracker.h"
 
 void GDN_EXPORT godot_openxr_gdnative_init(godot_gdnative_init_options *o) {
 	godot::Godot::gdnative_init(o);
+	AllocationTracker::start_tracking_godot_api();
 }
 
 void GDN_EXPORT godot_openxr_gdnative_terminate(godot_gdnative_terminate_options *o) {
+	AllocationTracker::stop_tracking_godot_api();
 	godot::Godot::gdnative_terminate(o);
 }
 
@@ -28,7 +34,10 @@ void GDN_EXPORT godot_openxr_nativescript_init(void *p_handle) {
 	godot::Godot::nativescript_init(p_handle);
 
 	godot::register_tool_class<godot::OpenXRConfig>();
+	godot::register_class<godot::OpenXRAnchor>();
+	godot::register_class<godot::OpenXRCompositionLayer>();
 	godot::register_class<godot::OpenXRHand>();
+	godot::register_class<godot::OpenXRHaptics>();
 	godot::register_class<godot::OpenXRPose>();
 	godot::register_class<godot::OpenXRSkeleton>();
 }
@@ -3,6 +3,7 @@
 
 #include <ARVRServer.hpp>
 #include <CameraMatrix.hpp>
+#include <Engine.hpp>
 #include <JSON.hpp>
 #include <JSONParseResult.hpp>
 #include <ProjectSettings.hpp>
@@ -52,7 +53,20 @@ const char *OpenXRApi::default_action_sets_json = R"===(
 				"localised_name": "Grip Pose",
 				"paths": [
 					"/user/hand/left",
-					"/user/hand/right"
+					"/user/hand/right",
+					"/user/vive_tracker_htcx/role/handheld_object",
+					"/user/vive_tracker_htcx/role/left_foot",
+					"/user/vive_tracker_htcx/role/right_foot",
+					"/user/vive_tracker_htcx/role/left_shoulder",
+					"/user/vive_tracker_htcx/role/right_shoulder",
+					"/user/vive_tracker_htcx/role/left_elbow",
+					"/user/vive_tracker_htcx/role/right_elbow",
+					"/user/vive_tracker_htcx/role/left_knee",
+					"/user/vive_tracker_htcx/role/right_knee",
+					"/user/vive_tracker_htcx/role/waist",
+					"/user/vive_tracker_htcx/role/chest",
+					"/user/vive_tracker_htcx/role/camera",
+					"/user/vive_tracker_htcx/role/keyboard"
 				]
 			},
 			{
@@ -1379,6 +1393,31 @@ const char *OpenXRApi::default_interaction_profiles_json = R"===(
 				]
 			}
 		]
+	},)==="
+	/* Vive trackers are bound by the role assigned to them in SteamVR, these are only used if XR_HTCX_vive_tracker_interaction is supported */
+	R"===({
+		"path": "/interaction_profiles/htc/vive_tracker_htcx",
+		"bindings": [
+			{
+				"set": "godot",
+				"action": "grip_pose",
+				"paths": [
+					"/user/vive_tracker_htcx/role/handheld_object/input/grip/pose",
+					"/user/vive_tracker_htcx/role/left_foot/input/grip/pose",
+					"/user/vive_tracker_htcx/role/right_foot/input/grip/pose",
+					"/user/vive_tracker_htcx/role/left_shoulder/input/grip/pose",
+					"/user/vive_tracker_htcx/role/right_shoulder/input/grip/pose",
+					"/user/vive_tracker_htcx/role/left_elbow/input/grip/pose",
+					"/user/vive_tracker_htcx/role/right_elbow/input/grip/pose",
+					"/user/vive_tracker_htcx/role/left_knee/input/grip/pose",
+					"/user/vive_tracker_htcx/role/right_knee/input/grip/pose",
+					"/user/vive_tracker_htcx/role/waist/input/grip/pose",
+					"/user/vive_tracker_htcx/role/chest/input/grip/pose",
+					"/user/vive_tracker_htcx/role/camera/input/grip/pose",
+					"/user/vive_tracker_htcx/role/keyboard/input/grip/pose"
+				]
+			}
+		]
 	}
 ]
 )===";
@@ -1626,12 +1665,17 @@ bool OpenXRApi::initialiseInstance() {
 		request_extensions.insert(wrapper_request_extensions.begin(), wrapper_request_extensions.end());
 	}
 
+	if (headless) {
+		// We don't need a graphics API, but we do need the runtime to allow us to run without one.
+		request_extensions[XR_MND_HEADLESS_EXTENSION_NAME] = nullptr;
+	} else {
 #ifdef ANDROID
-	request_extensions[XR_KHR_OPENGL_ES_ENABLE_EXTENSION_NAME] = nullptr;
-	request_extensions[XR_KHR_ANDROID_THREAD_SETTINGS_EXTENSION_NAME] = nullptr;
+		request_extensions[XR_KHR_OPENGL_ES_ENABLE_EXTENSION_NAME] = nullptr;
+		request_extensions[XR_KHR_ANDROID_THREAD_SETTINGS_EXTENSION_NAME] = nullptr;
 #else
-	request_extensions[XR_KHR_OPENGL_ENABLE_EXTENSION_NAME] = nullptr;
+		request_extensions[XR_KHR_OPENGL_ENABLE_EXTENSION_NAME] = nullptr;
 #endif
+	}
 
 	// If we have these, we use them, if not we skip related logic..
 	request_extensions[XR_MND_BALL_ON_STICK_EXTENSION_NAME] = &monado_stick_on_ball_ext;
@@ -1639,7 +1683,7 @@ bool OpenXRApi::initialiseInstance() {
 	for (auto &requested_extension : request_extensions) {
 		if (!isExtensionSupported(requested_extension.first, extensionProperties, extensionCount)) {
 			if (requested_extension.second == nullptr) {
-				Godot::print_error("OpenXR Runtime does not support OpenGL extension!", __FUNCTION__, __FILE__, __LINE__);
+				Godot::print_error(String("OpenXR Runtime does not support required extension ") + String(requested_extension.first), __FUNCTION__, __FILE__, __LINE__);
 				free(extensionProperties);
 				return false;
 			} else {
@@ -1804,13 +1848,12 @@ bool OpenXRApi::initialiseSession() {
 		return false;
 	}
 
-	XrViewConfigurationView *configuration_views = (XrViewConfigurationView *)malloc(sizeof(XrViewConfigurationView) * view_count);
-	for (uint32_t i = 0; i < view_count; i++) {
-		configuration_views[i].type = XR_TYPE_VIEW_CONFIGURATION_VIEW;
-		configuration_views[i].next = nullptr;
-	}
+	XrViewConfigurationView configuration_view = {};
+	configuration_view.type = XR_TYPE_VIEW_CONFIGURATION_VIEW;
+	configuration_view.next = nullptr;
+	std::vector<XrViewConfigurationView> configuration_views(view_count, configuration_view);
 
-	result = xrEnumerateViewConfigurationViews(instance, systemId, view_config_type, view_count, &view_count, configuration_views);
+	result = xrEnumerateViewConfigurationViews(instance, systemId, view_config_type, view_count, &view_count, configuration_views.data());
 	if (!xr_result(result, "Failed to enumerate view configuration views!")) {
 		return false;
 	}
@@ -1821,17 +1864,37 @@ bool OpenXRApi::initialiseSession() {
 	render_target_height = configuration_views[0].recommendedImageRectHeight * render_target_size_multiplier;
 	render_target_height = (std::min)(render_target_height, configuration_views[0].maxImageRectHeight);
 
-	swapchain_sample_count = configuration_views[0].recommendedSwapchainSampleCount;
+	buffer_index.assign(view_count, 0);
+
+	void *graphics_binding = nullptr;
+	if (!headless) {
+		if (!check_graphics_requirements_gl(systemId)) {
+			return false;
+		}
+
+		if (!initialiseGraphicsBinding()) {
+			return false;
+		}
 
-	free(configuration_views);
-	configuration_views = nullptr;
+		graphics_binding = &graphics_binding_gl;
+	}
 
-	buffer_index = (uint32_t *)malloc(sizeof(uint32_t) * view_count);
+	XrSessionCreateInfo session_create_info = {
+		.type = XR_TYPE_SESSION_CREATE_INFO,
+		.next = graphics_binding,
+		.createFlags = 0,
+		.systemId = systemId
+	};
 
-	if (!check_graphics_requirements_gl(systemId)) {
+	result = xrCreateSession(instance, &session_create_info, &session);
+	if (!xr_result(result, "Failed to create session")) {
 		return false;
 	}
 
+	return true;
+}
+
+bool OpenXRApi::initialiseGraphicsBinding() {
 	OS *os = OS::get_singleton();
 
 	// TODO: support wayland
@@ -1900,18 +1963,6 @@ bool OpenXRApi::initialiseSession() {
 	Godot::print("OpenXR Using OpenGL version: {0}", (char *)glGetString(GL_VERSION));
 	Godot::print("OpenXR Using OpenGL renderer: {0}", (char *)glGetString(GL_RENDERER));
 
-	XrSessionCreateInfo session_create_info = {
-		.type = XR_TYPE_SESSION_CREATE_INFO,
-		.next = &graphics_binding_gl,
-		.createFlags = 0,
-		.systemId = systemId
-	};
-
-	result = xrCreateSession(instance, &session_create_info, &session);
-	if (!xr_result(result, "Failed to create session")) {
-		return false;
-	}
-
 	return true;
 }
 
@@ -1923,6 +1974,14 @@ void OpenXRApi::set_play_space_type(XrReferenceSpaceType p_type) {
 	}
 }
 
+void OpenXRApi::set_headless(bool p_headless) {
+	if (is_initialised()) {
+		Godot::print_error("Setting headless mode is only allowed prior to initialization.", __FUNCTION__, __FILE__, __LINE__);
+	} else {
+		headless = p_headless;
+	}
+}
+
 bool OpenXRApi::set_render_target_size_multiplier(float multiplier) {
 	if (is_initialised()) {
 		Godot::print_error("Setting the render target size multiplier is only allowed prior to initialization.", __FUNCTION__, __FILE__, __LINE__);
@@ -2005,30 +2064,23 @@ void OpenXRApi::cleanupSpaces() {
 	}
 }
 
-bool OpenXRApi::initialiseSwapChains() {
+bool OpenXRApi::select_swapchain_format() {
 	XrResult result;
 
-#ifdef DEBUG
-	Godot::print("OpenXR initialiseSwapChains");
-#endif
-
 	uint32_t swapchainFormatCount;
 	result = xrEnumerateSwapchainFormats(session, 0, &swapchainFormatCount, nullptr);
 	if (!xr_result(result, "Failed to get number of supported swapchain formats")) {
 		return false;
 	}
 
-	// Damn you microsoft for not supporting this!!
-	// int64_t swapchainFormats[swapchainFormatCount];
-	int64_t *swapchainFormats = (int64_t *)malloc(sizeof(int64_t) * swapchainFormatCount);
-	if (swapchainFormats == nullptr) {
-		Godot::print_error("OpenXR Couldn't allocate memory for swap chain formats", __FUNCTION__, __FILE__, __LINE__);
+	std::vector<int64_t> swapchainFormats(swapchainFormatCount);
+	result = xrEnumerateSwapchainFormats(session, swapchainFormatCount, &swapchainFormatCount, swapchainFormats.data());
+	if (!xr_result(result, "Failed to enumerate swapchain formats")) {
 		return false;
 	}
 
-	result = xrEnumerateSwapchainFormats(session, swapchainFormatCount, &swapchainFormatCount, swapchainFormats);
-	if (!xr_result(result, "Failed to enumerate swapchain formats")) {
-		free(swapchainFormats);
+	if (swapchainFormatCount == 0) {
+		Godot::print_error("OpenXR runtime does not report any swapchain formats", __FUNCTION__, __FILE__, __LINE__);
 		return false;
 	}
 
@@ -2054,20 +2106,16 @@ bool OpenXRApi::initialiseSwapChains() {
 	// Note that OpenXR expects sRGB content if an sRGB buffer is used, else it expects linear, however sRGB buffers don't seem to work properly under GLES2.
 	// this is a problem especially on Quest where we have to use a 32bit buffer yet 8bits per color leads to awefull banding when linear color space is used.
 
-	// We start by defining a list of formats we'd like to use from most to least, doesn't help every platform has slightly different names for these...
+	// Our list of formats we'd like to use from most to least is configurable, see get_requested_swapchain_format for how these map to each platform.
+	// Higher precision formats like RGB10_A2 and RGBA16F are stored in linear color space and prevent banding at the cost of bandwidth.
 
 	std::vector<RequestedSwapchainFormat> requested_swapchain_formats;
-
-#ifdef WIN32
-	requested_swapchain_formats.push_back({ GL_SRGB8_ALPHA8, false });
-	requested_swapchain_formats.push_back({ GL_RGBA8, true });
-#elif ANDROID
-	requested_swapchain_formats.push_back({ GL_SRGB8_ALPHA8, false });
-	requested_swapchain_formats.push_back({ GL_RGBA8, true });
-#else
-	requested_swapchain_formats.push_back({ GL_SRGB8_ALPHA8_EXT, false });
-	requested_swapchain_formats.push_back({ GL_RGBA8_EXT, true });
-#endif
+	for (SwapchainFormat format : swapchain_format_preference) {
+		RequestedSwapchainFormat requested_format;
+		if (get_requested_swapchain_format(format, requested_format)) {
+			requested_swapchain_formats.push_back(requested_format);
+		}
+	}
 
 	int64_t swapchain_format_to_use = 0;
 
@@ -2085,127 +2133,198 @@ bool OpenXRApi::initialiseSwapChains() {
 		swapchain_format_to_use = swapchainFormats[0];
 		keep_3d_linear = true;
 		Godot::print("OpenXR Couldn't find prefered swapchain format, using {0} in linear color space", get_swapchain_format_name(swapchain_format_to_use));
-#ifdef DEBUG
 	} else {
 		Godot::print("OpenXR Using swapchain format {0} in {1} color space", get_swapchain_format_name(swapchain_format_to_use), keep_3d_linear ? "linear" : "sRGB");
-#endif
 	}
 
-	if (!keep_3d_linear) {
-		// Make sure we keep our data in sRGB by turning linear to sRGB conversion off for the frame buffer. We are supplying data in sRGB.
-		glDisable(GL_FRAMEBUFFER_SRGB_EXT);
+	swapchain_format = swapchain_format_to_use;
+
+	return true;
+}
+
+bool OpenXRApi::get_requested_swapchain_format(SwapchainFormat p_format, RequestedSwapchainFormat &r_requested_format) const {
+	// doesn't help every platform has slightly different names for these...
+	switch (p_format) {
+		case SWAPCHAIN_FORMAT_SRGB8_ALPHA8: {
+#if defined(WIN32) || defined(ANDROID)
+			r_requested_format = { GL_SRGB8_ALPHA8, false };
+#else
+			r_requested_format = { GL_SRGB8_ALPHA8_EXT, false };
+#endif
+		} break;
+		case SWAPCHAIN_FORMAT_RGBA8: {
+#if defined(WIN32) || defined(ANDROID)
+			r_requested_format = { GL_RGBA8, true };
+#else
+			r_requested_format = { GL_RGBA8_EXT, true };
+#endif
+		} break;
+		case SWAPCHAIN_FORMAT_RGB10_A2: {
+#if defined(WIN32) || defined(ANDROID)
+			r_requested_format = { GL_RGB10_A2, true };
+#else
+			r_requested_format = { GL_RGB10_A2_EXT, true };
+#endif
+		} break;
+		case SWAPCHAIN_FORMAT_RGBA16F: {
+#if defined(WIN32) || defined(ANDROID)
+			r_requested_format = { GL_RGBA16F, true };
+#else
+			r_requested_format = { GL_RGBA16F_ARB, true };
+#endif
+		} break;
+		default: {
+			return false;
+		} break;
 	}
 
-	free(swapchainFormats);
+	return true;
+}
 
-	swapchains = (XrSwapchain *)malloc(sizeof(XrSwapchain) * view_count);
-	if (swapchains == nullptr) {
-		Godot::print_error("OpenXR Couldn't allocate memory for swap chains", __FUNCTION__, __FILE__, __LINE__);
+bool OpenXRApi::set_swapchain_format_preference(const std::vector<SwapchainFormat> &p_formats) {
+	if (is_initialised()) {
+		Godot::print_error("Setting the swapchain formats is only allowed prior to initialization.", __FUNCTION__, __FILE__, __LINE__);
 		return false;
 	}
 
-	swapchain_acquired = (bool *)malloc(sizeof(bool) * view_count);
-	if (swapchain_acquired == nullptr) {
-		Godot::print_error("OpenXR Couldn't allocate memory for swap chains", __FUNCTION__, __FILE__, __LINE__);
-		return false;
+	for (SwapchainFormat format : p_formats) {
+		if (format < 0 || format >= SWAPCHAIN_FORMAT_MAX) {
+			Godot::print_error(String("Unknown swapchain format ") + String::num_int64(format), __FUNCTION__, __FILE__, __LINE__);
+			return false;
+		}
 	}
 
-	// Damn you microsoft for not supporting this!!
-	// uint32_t swapchainLength[view_count];
-	uint32_t *swapchainLength = (uint32_t *)malloc(sizeof(uint32_t) * view_count);
-	if (swapchainLength == nullptr) {
-		Godot::print_error("OpenXR Couldn't allocate memory for swap chain lengths", __FUNCTION__, __FILE__, __LINE__);
-		return false;
+	swapchain_format_preference = p_formats;
+	return true;
+}
+
+godot::String OpenXRApi::get_selected_swapchain_format_name() {
+	if (swapchain_format == 0) {
+		return String();
 	}
 
-	for (uint32_t i = 0; i < view_count; i++) {
-		swapchain_acquired[i] = false;
+	return get_swapchain_format_name(swapchain_format);
+}
 
-		// again Microsoft wants these in order!
-		XrSwapchainCreateInfo swapchainCreateInfo = {
-			.type = XR_TYPE_SWAPCHAIN_CREATE_INFO,
-			.next = nullptr,
-			.createFlags = 0,
-			.usageFlags = XR_SWAPCHAIN_USAGE_SAMPLED_BIT | XR_SWAPCHAIN_USAGE_COLOR_ATTACHMENT_BIT,
-			.format = swapchain_format_to_use,
-			.sampleCount = swapchain_sample_count, // 1,
-			.width = render_target_width,
-			.height = render_target_height,
-			.faceCount = 1,
-			.arraySize = 1,
-			.mipCount = 1,
-		};
+bool OpenXRApi::create_swapchain(uint32_t eye) {
+	XrResult result;
 
-		void **swapchain_create_info_pointer = const_cast<void **>(&swapchainCreateInfo.next);
-		for (XRExtensionWrapper *wrapper : registered_extension_wrappers) {
-			void **swapchain_create_info_next_pointer = wrapper->set_swapchain_create_info_and_get_next_pointer(swapchain_create_info_pointer);
-			if (*swapchain_create_info_pointer && swapchain_create_info_next_pointer && !*swapchain_create_info_next_pointer) {
-				swapchain_create_info_pointer = swapchain_create_info_next_pointer;
-			} else {
-				// Invalid return values.
-				// Reset the value stored by the swapchain_create_info_pointer so it can be reused in the next loop.
-				*swapchain_create_info_pointer = nullptr;
-			}
-		}
+	swapchain_acquired[eye] = false;
+	swapchain_error[eye] = false;
 
-		result = xrCreateSwapchain(session, &swapchainCreateInfo, &swapchains[i]);
-		if (!xr_result(result, "Failed to create swapchain {0}!", i)) {
-			free(swapchainLength);
-			return false;
-		}
+	// again Microsoft wants these in order!
+	XrSwapchainCreateInfo swapchainCreateInfo = {
+		.type = XR_TYPE_SWAPCHAIN_CREATE_INFO,
+		.next = nullptr,
+		.createFlags = 0,
+		.usageFlags = XR_SWAPCHAIN_USAGE_SAMPLED_BIT | XR_SWAPCHAIN_USAGE_COLOR_ATTACHMENT_BIT,
+		.format = swapchain_format,
+		.sampleCount = 1, // Godot renders into our images as GL_TEXTURE_2D, it applies MSAA in its own viewport
+		.width = render_target_width,
+		.height = render_target_height,
+		.faceCount = 1,
+		.arraySize = 1,
+		.mipCount = 1,
+	};
 
-		result = xrEnumerateSwapchainImages(swapchains[i], 0, &swapchainLength[i], nullptr);
-		if (!xr_result(result, "Failed to enumerate swapchains")) {
-			free(swapchainLength);
-			return false;
+	void **swapchain_create_info_pointer = const_cast<void **>(&swapchainCreateInfo.next);
+	for (XRExtensionWrapper *wrapper : registered_extension_wrappers) {
+		void **swapchain_create_info_next_pointer = wrapper->set_swapchain_create_info_and_get_next_pointer(swapchain_create_info_pointer);
+		if (*swapchain_create_info_pointer && swapchain_create_info_next_pointer && !*swapchain_create_info_next_pointer) {
+			swapchain_create_info_pointer = swapchain_create_info_next_pointer;
+		} else {
+			// Invalid return values.
+			// Reset the value stored by the swapchain_create_info_pointer so it can be reused in the next loop.
+			*swapchain_create_info_pointer = nullptr;
 		}
 	}
 
-#ifdef ANDROID
-	images = (XrSwapchainImageOpenGLESKHR **)malloc(sizeof(XrSwapchainImageOpenGLESKHR **) * view_count);
-#else
-	images = (XrSwapchainImageOpenGLKHR **)malloc(sizeof(XrSwapchainImageOpenGLKHR **) * view_count);
-#endif
-	if (images == nullptr) {
-		Godot::print_error("OpenXR Couldn't allocate memory for swap chain images", __FUNCTION__, __FILE__, __LINE__);
+	result = xrCreateSwapchain(session, &swapchainCreateInfo, &swapchains[eye]);
+	if (!xr_result(result, "Failed to create swapchain {0}!", eye)) {
+		swapchains[eye] = XR_NULL_HANDLE;
 		return false;
 	}
 
-	// reset so if we fail we don't try to free memory we never allocated
-	for (uint32_t i = 0; i < view_count; i++) {
-		images[i] = nullptr;
+	uint32_t swapchainLength = 0;
+	result = xrEnumerateSwapchainImages(swapchains[eye], 0, &swapchainLength, nullptr);
+	if (!xr_result(result, "Failed to enumerate swapchains")) {
+		destroy_swapchain(eye);
+		return false;
 	}
 
-	for (uint32_t i = 0; i < view_count; i++) {
-#ifdef ANDROID
-		images[i] = (XrSwapchainImageOpenGLESKHR *)malloc(sizeof(XrSwapchainImageOpenGLESKHR) * swapchainLength[i]);
-#else
-		images[i] = (XrSwapchainImageOpenGLKHR *)malloc(sizeof(XrSwapchainImageOpenGLKHR) * swapchainLength[i]);
+	XrSwapchainImageGL image = {};
+	image.type = XR_TYPE_SWAPCHAIN_IMAGE_GL;
+	image.next = nullptr;
+	images[eye].assign(swapchainLength, image);
+
+	result = xrEnumerateSwapchainImages(swapchains[eye], swapchainLength, &swapchainLength, (XrSwapchainImageBaseHeader *)images[eye].data());
+	if (!xr_result(result, "Failed to enumerate swapchain images")) {
+		destroy_swapchain(eye);
+		return false;
+	}
+
+	projection_views[eye].subImage.swapchain = swapchains[eye];
+
+	return true;
+}
+
+void OpenXRApi::destroy_swapchain(uint32_t eye) {
+	if (swapchains[eye] != XR_NULL_HANDLE) {
+		xrDestroySwapchain(swapchains[eye]);
+		swapchains[eye] = XR_NULL_HANDLE;
+	}
+
+	images[eye].clear();
+	projection_views[eye].subImage.swapchain = XR_NULL_HANDLE;
+	swapchain_acquired[eye] = false;
+}
+
+bool OpenXRApi::initialiseSwapChains() {
+#ifdef DEBUG
+	Godot::print("OpenXR initialiseSwapChains");
 #endif
-		if (images[i] == nullptr) {
-			Godot::print_error("OpenXR Couldn't allocate memory for swap chain image", __FUNCTION__, __FILE__, __LINE__);
+
+	if (!headless) {
+		// Our supported formats won't change for the lifetime of our session so we only need to do this once.
+		if (swapchain_format == 0 && !select_swapchain_format()) {
 			return false;
 		}
 
-		for (uint64_t j = 0; j < swapchainLength[i]; j++) {
-#ifdef ANDROID
-			images[i][j].type = XR_TYPE_SWAPCHAIN_IMAGE_OPENGL_ES_KHR;
-#else
-			images[i][j].type = XR_TYPE_SWAPCHAIN_IMAGE_OPENGL_KHR;
-#endif
-			images[i][j].next = nullptr;
+		if (!keep_3d_linear) {
+			// Make sure we keep our data in sRGB by turning linear to sRGB conversion off for the frame buffer. We are supplying data in sRGB.
+			glDisable(GL_FRAMEBUFFER_SRGB_EXT);
 		}
 	}
 
-	for (uint32_t i = 0; i < view_count; i++) {
-		result = xrEnumerateSwapchainImages(swapchains[i], swapchainLength[i], &swapchainLength[i], (XrSwapchainImageBaseHeader *)images[i]);
-		if (!xr_result(result, "Failed to enumerate swapchain images")) {
+	swapchains.assign(view_count, XR_NULL_HANDLE);
+	swapchain_acquired.assign(view_count, false);
+	swapchain_error.assign(view_count, false);
+	swapchain_rebuild_failed.assign(view_count, false);
+	images.assign(view_count, std::vector<XrSwapchainImageGL>());
+
+	XrView view = {};
+	view.type = XR_TYPE_VIEW;
+	view.next = nullptr;
+	views.assign(view_count, view);
+
+	XrCompositionLayerProjectionView projection_view = {};
+	projection_view.type = XR_TYPE_COMPOSITION_LAYER_PROJECTION_VIEW;
+	projection_view.next = nullptr;
+	projection_view.subImage.swapchain = XR_NULL_HANDLE;
+	projection_view.subImage.imageArrayIndex = 0;
+	projection_view.subImage.imageRect.offset.x = 0;
+	projection_view.subImage.imageRect.offset.y = 0;
+	projection_view.subImage.imageRect.extent.width = render_target_width;
+	projection_view.subImage.imageRect.extent.height = render_target_height;
+	projection_views.assign(view_count, projection_view);
+
+	// A headless session has no swapchains, render_openxr will submit empty frames.
+	for (uint32_t i = 0; i < view_count && !headless; i++) {
+		if (!create_swapchain(i)) {
 			return false;
 		}
 	}
 
-	free(swapchainLength);
-
 	// only used for OpenGL depth testing
 	/*
 	glGenTextures(1, &depthbuffer);
@@ -2216,79 +2335,75 @@ bool OpenXRApi::initialiseSwapChains() {
 		GL_DEPTH_COMPONENT, GL_UNSIGNED_INT, 0);
 	*/
 
-	projectionLayer = (XrCompositionLayerProjection *)malloc(sizeof(XrCompositionLayerProjection));
-	projectionLayer->type = XR_TYPE_COMPOSITION_LAYER_PROJECTION;
-	projectionLayer->next = nullptr;
-	projectionLayer->layerFlags = XR_COMPOSITION_LAYER_CORRECT_CHROMATIC_ABERRATION_BIT;
-	projectionLayer->space = play_space;
-	projectionLayer->viewCount = view_count;
-	projectionLayer->views = nullptr;
+	projectionLayer.type = XR_TYPE_COMPOSITION_LAYER_PROJECTION;
+	projectionLayer.next = nullptr;
+	projectionLayer.layerFlags = XR_COMPOSITION_LAYER_CORRECT_CHROMATIC_ABERRATION_BIT;
+	projectionLayer.space = play_space;
+	projectionLayer.viewCount = view_count;
+	projectionLayer.views = projection_views.data();
 
 	frameState.type = XR_TYPE_FRAME_STATE;
 	frameState.next = nullptr;
 
-	views = (XrView *)malloc(sizeof(XrView) * view_count);
-	if (views == nullptr) {
-		Godot::print_error("OpenXR Couldn't allocate memory for views", __FUNCTION__, __FILE__, __LINE__);
-		return false;
-	}
+	return true;
+}
 
-	projection_views = (XrCompositionLayerProjectionView *)malloc(sizeof(XrCompositionLayerProjectionView) * view_count);
-	if (projection_views == nullptr) {
-		Godot::print_error("OpenXR Couldn't allocate memory for projection views", __FUNCTION__, __FILE__, __LINE__);
-		return false;
+void OpenXRApi::cleanupSwapChains() {
+	for (uint32_t i = 0; i < swapchains.size(); i++) {
+		destroy_swapchain(i);
 	}
 
-	for (uint32_t i = 0; i < view_count; i++) {
-		views[i].type = XR_TYPE_VIEW;
-		views[i].next = nullptr;
-
-		projection_views[i].type = XR_TYPE_COMPOSITION_LAYER_PROJECTION_VIEW;
-		projection_views[i].next = nullptr;
-		projection_views[i].subImage.swapchain = swapchains[i];
-		projection_views[i].subImage.imageArrayIndex = 0;
-		projection_views[i].subImage.imageRect.offset.x = 0;
-		projection_views[i].subImage.imageRect.offset.y = 0;
-		projection_views[i].subImage.imageRect.extent.width = render_target_width;
-		projection_views[i].subImage.imageRect.extent.height = render_target_height;
-	};
+	swapchains.clear();
+	swapchain_acquired.clear();
+	swapchain_error.clear();
+	swapchain_rebuild_failed.clear();
+	images.clear();
+	projection_views.clear();
+	views.clear();
 
-	return true;
+	projectionLayer.views = nullptr;
+	projectionLayer.viewCount = 0;
 }
 
-void OpenXRApi::cleanupSwapChains() {
-	if (swapchain_acquired != nullptr) {
-		free(swapchain_acquired);
-		swapchain_acquired = nullptr;
-	}
-	if (swapchains != nullptr) {
-		for (uint32_t i = 0; i < view_count; i++) {
-			if (swapchains[i] != XR_NULL_HANDLE) {
-				xrDestroySwapchain(swapchains[i]);
+void OpenXRApi::rebuild_failed_swapchains() {
+	// Workaround for dealing with swapchain not getting released properly after screen recording.
+	// We're called in between xrWaitFrame and xrBeginFrame so none of our images are in use,
+	// and we only rebuild the swapchain that failed. If this fails we try again next frame,
+	// render_openxr submits empty frames until then.
+	for (uint32_t i = 0; i < swapchain_error.size(); i++) {
+		if (swapchain_error[i]) {
+			if (!swapchain_rebuild_failed[i]) {
+				Godot::print("OpenXR Swapchain {0} needs reinitialization", i);
+			}
+#ifdef DEBUG
+			else {
+				Godot::print("OpenXR Swapchain {0} retrying reinitialization", i);
+			}
+#endif
+
+			destroy_swapchain(i);
+			if (!create_swapchain(i)) {
+				swapchain_error[i] = true;
+				swapchain_rebuild_failed[i] = true;
+			} else {
+				swapchain_rebuild_failed[i] = false;
 			}
 		}
-		free(swapchains);
-		swapchains = nullptr;
 	}
-	if (projection_views != nullptr) {
-		free(projection_views);
-		projection_views = nullptr;
+}
+
+bool OpenXRApi::swapchains_valid() const {
+	if (swapchains.size() != view_count) {
+		return false;
 	}
-	if (images != nullptr) {
-		for (uint32_t i = 0; i < view_count; i++) {
-			free(images[i]);
+
+	for (uint32_t i = 0; i < view_count; i++) {
+		if (swapchains[i] == XR_NULL_HANDLE || swapchain_error[i]) {
+			return false;
 		}
-		free(images);
-		images = nullptr;
-	}
-	if (projectionLayer != nullptr) {
-		free(projectionLayer);
-		projectionLayer = nullptr;
-	}
-	if (views != nullptr) {
-		free(views);
-		views = nullptr;
 	}
+
+	return true;
 }
 
 bool OpenXRApi::loadActionSets() {
@@ -2299,14 +2414,43 @@ bool OpenXRApi::loadActionSets() {
 	parse_action_sets(action_sets_json);
 	parse_interaction_profiles(interaction_profiles_json);
 
+	prepare_action_changes();
+
 	return true;
 }
 
+void OpenXRApi::set_action_events_enabled(bool p_enabled) {
+	action_events_enabled = p_enabled;
+	prepare_action_changes();
+}
+
+void OpenXRApi::prepare_action_changes() {
+	action_changes.clear();
+	if (!action_events_enabled || action_sets.empty()) {
+		return;
+	}
+
+	uint32_t max_change_count = 0;
+	for (ActionSet *action_set : action_sets) {
+		for (Action *action : action_set->get_actions()) {
+			max_change_count += action->get_max_change_count();
+		}
+	}
+
+	for (uint32_t i = 0; i <= max_change_count; i++) {
+		godot::Array changes;
+		changes.resize(i);
+		action_changes.push_back(changes);
+	}
+}
+
 bool OpenXRApi::bindActionSets() {
 #ifdef DEBUG
 	Godot::print("OpenXR bindActionSets");
 #endif
 
+	active_action_sets_dirty = true;
+
 	// finally attach our action sets, that locks everything in place
 	for (uint64_t i = 0; i < action_sets.size(); i++) {
 		ActionSet *action_set = action_sets[i];
@@ -2320,12 +2464,6 @@ bool OpenXRApi::bindActionSets() {
 	// NOTE: outputting what we find here for debugging, should probably make this silent in due time or just have one line with missing actions.
 	// a developer that is not using the internal actions but defines their own may not care about these missing
 
-	// Init our input paths and godot controllers for our mapping to
-	for (uint64_t i = 0; i < USER_INPUT_MAX; i++) {
-		XrResult res = xrStringToPath(instance, inputmaps[i].name, &inputmaps[i].toplevel_path);
-		xr_result(res, "OpenXR Couldn't obtain path for {0}", inputmaps[i].name);
-	}
-
 	// find our default actions
 	for (uint64_t i = 0; i < ACTION_MAX; i++) {
 		default_actions[i].action = get_action(default_actions[i].name);
@@ -2334,97 +2472,359 @@ bool OpenXRApi::bindActionSets() {
 		}
 	}
 
-	return true;
-}
+	// Init our input paths for our mapping to godot controllers, we always add our hands first
+	const char *hand_paths[2] = { "/user/hand/left", "/user/hand/right" };
+	for (int i = 0; i < 2; i++) {
+		register_input_map(get_path(hand_paths[i]));
+	}
 
-void OpenXRApi::unbindActionSets() {
-	// cleanup our controller mapping
-	for (uint64_t i = 0; i < USER_INPUT_MAX; i++) {
-		inputmaps[i].toplevel_path = XR_NULL_PATH;
-		inputmaps[i].active_profile = XR_NULL_PATH;
-		if (inputmaps[i].godot_controller >= 0) {
-			arvr_api->godot_arvr_remove_controller(inputmaps[i].godot_controller);
-			inputmaps[i].godot_controller = -1;
+	// and add any other device our action sets use
+	for (ActionSet *action_set : action_sets) {
+		for (Action *action : action_set->get_actions()) {
+			for (uint32_t p = 0; p < action->get_toplevel_path_count(); p++) {
+				register_input_map(action->get_toplevel_path(p));
+			}
 		}
 	}
 
-	// reset our default actions
-	for (uint64_t i = 0; i < ACTION_MAX; i++) {
-		default_actions[i].action = nullptr;
+	return true;
+}
+
+XrPath OpenXRApi::get_path(const char *p_path) {
+	std::lock_guard<std::mutex> lock(paths_mutex);
+
+	auto it = paths_by_string.find(p_path);
+	if (it != paths_by_string.end()) {
+		return it->second;
 	}
 
-	// reset our spaces
-	for (uint64_t i = 0; i < action_sets.size(); i++) {
-		ActionSet *action_set = action_sets[i];
+	if (instance == XR_NULL_HANDLE) {
+		return XR_NULL_PATH;
+	}
 
-		action_set->reset_spaces();
+	XrPath path;
+	XrResult res = xrStringToPath(instance, p_path, &path);
+	if (!xr_result(res, "OpenXR couldn't create path for {0}", p_path)) {
+		return XR_NULL_PATH;
 	}
-}
 
-void OpenXRApi::cleanupActionSets() {
-	unbindActionSets();
+	paths_by_string[p_path] = path;
+	strings_by_path[path] = String(p_path);
+	return path;
+}
 
-	// clear out our action sets
-	while (!action_sets.empty()) {
-		ActionSet *action_set = action_sets.back();
-		delete action_set;
+XrPath OpenXRApi::get_path(const godot::String &p_path) {
+	return get_path(p_path.utf8().get_data());
+}
 
-		action_sets.pop_back();
+godot::String OpenXRApi::get_path_string(XrPath p_path) {
+	if (p_path == XR_NULL_PATH) {
+		return godot::String();
 	}
-}
 
-OpenXRApi::OpenXRApi() {
-	// We set this to true if we init everything correctly
-	initialised = false;
+	std::lock_guard<std::mutex> lock(paths_mutex);
 
-	// set our defaults
-	action_sets_json = default_action_sets_json;
-	interaction_profiles_json = default_interaction_profiles_json;
-}
+	auto it = strings_by_path.find(p_path);
+	if (it != strings_by_path.end()) {
+		return it->second;
+	}
 
-bool OpenXRApi::initialize() {
-	if (initialised) {
-		// Already initialised, shouldn't be called in this case..
-#ifdef DEBUG
-		Godot::print("Initialize called when interface is already initialized.");
-#endif
-		return true;
+	if (instance == XR_NULL_HANDLE) {
+		return godot::String();
 	}
 
-#ifdef WIN32
-	if (!gladLoadGL()) {
-		Godot::print_error("OpenXR Failed to initialize GLAD", __FUNCTION__, __FILE__, __LINE__);
-		return false;
+	uint32_t strl;
+	char path_str[XR_MAX_PATH_LENGTH];
+	XrResult res = xrPathToString(instance, p_path, XR_MAX_PATH_LENGTH, &strl, path_str);
+	if (!xr_result(res, "OpenXR couldn't obtain path string")) {
+		return godot::String();
 	}
-#endif
 
-	// get our video driver setting from Godot.
-	OS *os = OS::get_singleton();
-	video_driver = os->get_current_video_driver();
+	paths_by_string[path_str] = p_path;
+	strings_by_path[p_path] = String(path_str);
+	return strings_by_path[p_path];
+}
 
-	if (!initialiseInstance()) {
-		// cleanup and exit
-		uninitialize();
+bool OpenXRApi::register_input_map(XrPath p_toplevel_path) {
+	if (p_toplevel_path == XR_NULL_PATH) {
 		return false;
+	} else if (get_input_map(p_toplevel_path) != nullptr) {
+		// already registered
+		return true;
 	}
 
-	// Propagate the callback to the registered extension wrappers.
-	for (XRExtensionWrapper *wrapper : registered_extension_wrappers) {
-		wrapper->on_instance_initialized(instance);
+	String path_str = get_path_string(p_toplevel_path);
+	if (path_str.empty()) {
+		return false;
 	}
 
-	if (!initialiseSession()) {
-		// cleanup and exit
-		uninitialize();
+	// gamepad is already supported in Godots own joystick handling, head we're using directly
+	if (path_str == "/user/gamepad" || path_str == "/user/head") {
 		return false;
 	}
 
-	// Propagate the callback to the registered extension wrappers.
-	for (XRExtensionWrapper *wrapper : registered_extension_wrappers) {
-		wrapper->on_session_initialized(session);
+	InputMap inputmap;
+	inputmap.name = path_str.utf8().get_data();
+	inputmap.toplevel_path = p_toplevel_path;
+	if (path_str == "/user/hand/left") {
+		inputmap.hand = 1;
+		inputmap.pose_action = ACTION_AIM_POSE;
+	} else if (path_str == "/user/hand/right") {
+		inputmap.hand = 2;
+		inputmap.pose_action = ACTION_AIM_POSE;
+	} else {
+		// trackers and other devices generally only have a grip pose
+		inputmap.hand = 0;
+		inputmap.pose_action = ACTION_GRIP_POSE;
+	}
+	inputmap.action_mask = 0;
+	for (int i = 0; i < ACTION_MAX; i++) {
+		if (default_actions[i].action != nullptr && default_actions[i].action->has_toplevel_path(p_toplevel_path)) {
+			inputmap.action_mask |= 1 << i;
+		}
 	}
+	inputmap.godot_controller = -1;
+	inputmap.active_profile = XR_NULL_PATH;
+	inputmap.bound_action_mask = inputmap.action_mask; // until we know our profile we assume everything is bound
+	inputmap.tracking_confidence = TRACKING_CONFIDENCE_NONE;
 
-	if (!loadActionSets()) {
+	inputmaps.push_back(inputmap);
+
+#ifdef DEBUG
+	Godot::print("OpenXR registered input path {0}", path_str);
+#endif
+
+	return true;
+}
+
+godot::String OpenXRApi::get_interaction_profile(const godot::String &p_toplevel_path) const {
+	// compare names so we don't need to convert our path
+	std::string toplevel_path = p_toplevel_path.utf8().get_data();
+	for (const InputMap &inputmap : inputmaps) {
+		if (inputmap.name == toplevel_path) {
+			return inputmap.profile_name;
+		}
+	}
+
+	return godot::String();
+}
+
+OpenXRApi::InteractionProfile *OpenXRApi::get_interaction_profile_info(XrPath p_profile) {
+	auto it = interaction_profiles.find(p_profile);
+	if (it != interaction_profiles.end()) {
+		return &it->second;
+	}
+
+	String profile_str = get_path_string(p_profile);
+	if (profile_str.empty()) {
+		return nullptr;
+	}
+
+	InteractionProfile &profile = interaction_profiles[p_profile];
+	profile.name = profile_str;
+	return &profile;
+}
+
+uint32_t OpenXRApi::get_bound_action_mask(InteractionProfile &p_profile, const InputMap &p_inputmap) {
+	auto it = p_profile.bound_action_masks.find(p_inputmap.toplevel_path);
+	if (it != p_profile.bound_action_masks.end()) {
+		return it->second;
+	}
+
+	// Find out which of our default actions are bound to an input on this device,
+	// our compatibility layer doesn't need to query the others.
+	String prefix = String(p_inputmap.name.c_str()) + "/";
+	uint32_t mask = 0;
+	std::vector<XrPath> sources;
+	for (int i = 0; i < ACTION_MAX; i++) {
+		if (!(p_inputmap.action_mask & (1 << i))) {
+			continue;
+		}
+
+		XrBoundSourcesForActionEnumerateInfo enumerate_info = {
+			.type = XR_TYPE_BOUND_SOURCES_FOR_ACTION_ENUMERATE_INFO,
+			.next = nullptr,
+			.action = default_actions[i].action->get_action()
+		};
+
+		uint32_t count = 0;
+		XrResult res = xrEnumerateBoundSourcesForAction(session, &enumerate_info, 0, &count, nullptr);
+		if (!xr_result(res, "Failed to get bound sources for {0}", default_actions[i].name)) {
+			// assume it's bound and don't cache our result
+			return p_inputmap.action_mask;
+		}
+
+		sources.resize(count);
+		if (count > 0) {
+			res = xrEnumerateBoundSourcesForAction(session, &enumerate_info, count, &count, sources.data());
+			if (!xr_result(res, "Failed to get bound sources for {0}", default_actions[i].name)) {
+				return p_inputmap.action_mask;
+			}
+		}
+
+		for (uint32_t s = 0; s < count; s++) {
+			if (get_path_string(sources[s]).begins_with(prefix)) {
+				mask |= 1 << i;
+				break;
+			}
+		}
+	}
+
+	p_profile.bound_action_masks[p_inputmap.toplevel_path] = mask;
+	return mask;
+}
+
+void OpenXRApi::update_interaction_profiles() {
+	XrInteractionProfileState profile_state = {
+		.type = XR_TYPE_INTERACTION_PROFILE_STATE,
+		.next = nullptr
+	};
+
+	for (InputMap &inputmap : inputmaps) {
+		XrResult res = xrGetCurrentInteractionProfile(session, inputmap.toplevel_path, &profile_state);
+		if (!xr_result(res, "Failed to get interaction profile for {0}", inputmap.name.c_str())) {
+			continue;
+		}
+
+		XrPath new_profile = profile_state.interactionProfile;
+		if (inputmap.active_profile == new_profile) {
+			continue;
+		}
+
+		inputmap.active_profile = new_profile;
+		inputmap.profile_name = godot::String();
+		inputmap.bound_action_mask = inputmap.action_mask;
+
+		if (new_profile == XR_NULL_PATH) {
+			Godot::print("OpenXR No interaction profile for {0}", inputmap.name.c_str());
+		} else {
+			InteractionProfile *profile = get_interaction_profile_info(new_profile);
+			if (profile != nullptr) {
+				inputmap.profile_name = profile->name;
+				inputmap.bound_action_mask = get_bound_action_mask(*profile, inputmap);
+			}
+
+#ifdef DEBUG
+			Godot::print("OpenXR Event: Interaction profile changed for {0}: {1}", inputmap.name.c_str(), inputmap.profile_name);
+#endif
+		}
+
+		emit_plugin_signal(SIGNAL_INTERACTION_PROFILE_CHANGED, godot::String(inputmap.name.c_str()), inputmap.profile_name);
+	}
+}
+
+const OpenXRApi::InputMap *OpenXRApi::get_input_map(XrPath p_toplevel_path) const {
+	for (const InputMap &inputmap : inputmaps) {
+		if (inputmap.toplevel_path == p_toplevel_path) {
+			return &inputmap;
+		}
+	}
+
+	return nullptr;
+}
+
+void OpenXRApi::unbindActionSets() {
+	active_action_sets.clear();
+	active_action_sets_dirty = true;
+	interaction_profiles.clear();
+
+	// cleanup our controller mapping
+	for (const InputMap &inputmap : inputmaps) {
+		if (inputmap.godot_controller >= 0) {
+			arvr_api->godot_arvr_remove_controller(inputmap.godot_controller);
+		}
+	}
+	inputmaps.clear();
+
+	// reset our default actions
+	for (uint64_t i = 0; i < ACTION_MAX; i++) {
+		default_actions[i].action = nullptr;
+	}
+
+	// reset our spaces
+	for (uint64_t i = 0; i < action_sets.size(); i++) {
+		ActionSet *action_set = action_sets[i];
+
+		action_set->reset_spaces();
+	}
+}
+
+void OpenXRApi::cleanupActionSets() {
+	unbindActionSets();
+
+	// anything that holds on to our actions needs to look them up again
+	action_sets_generation++;
+
+	// our scheduler references our actions
+	haptic_scheduler.clear();
+
+	// clear out our action sets
+	while (!action_sets.empty()) {
+		ActionSet *action_set = action_sets.back();
+		delete action_set;
+
+		action_sets.pop_back();
+	}
+
+	// our changes hold on to our actions dictionaries
+	action_changes.clear();
+}
+
+OpenXRApi::OpenXRApi() {
+	// We set this to true if we init everything correctly
+	initialised = false;
+
+	// set our defaults
+	action_sets_json = default_action_sets_json;
+	interaction_profiles_json = default_interaction_profiles_json;
+
+	swapchain_format_preference.push_back(SWAPCHAIN_FORMAT_SRGB8_ALPHA8);
+	swapchain_format_preference.push_back(SWAPCHAIN_FORMAT_RGBA8);
+}
+
+bool OpenXRApi::initialize() {
+	if (initialised) {
+		// Already initialised, shouldn't be called in this case..
+#ifdef DEBUG
+		Godot::print("Initialize called when interface is already initialized.");
+#endif
+		return true;
+	}
+
+#ifdef WIN32
+	if (!gladLoadGL()) {
+		Godot::print_error("OpenXR Failed to initialize GLAD", __FUNCTION__, __FILE__, __LINE__);
+		return false;
+	}
+#endif
+
+	// get our video driver setting from Godot.
+	OS *os = OS::get_singleton();
+	video_driver = os->get_current_video_driver();
+
+	if (!initialiseInstance()) {
+		// cleanup and exit
+		uninitialize();
+		return false;
+	}
+
+	// Propagate the callback to the registered extension wrappers.
+	for (XRExtensionWrapper *wrapper : registered_extension_wrappers) {
+		wrapper->on_instance_initialized(instance);
+	}
+
+	if (!initialiseSession()) {
+		// cleanup and exit
+		uninitialize();
+		return false;
+	}
+
+	// Propagate the callback to the registered extension wrappers.
+	for (XRExtensionWrapper *wrapper : registered_extension_wrappers) {
+		wrapper->on_session_initialized(session);
+	}
+
+	if (!loadActionSets()) {
 		// cleanup and exit
 		uninitialize();
 		return false;
@@ -2442,8 +2842,10 @@ OpenXRApi::~OpenXRApi() {
 	uninitialize();
 }
 
-void OpenXRApi::uninitialize() {
-	if (running && session != XR_NULL_HANDLE) {
+void OpenXRApi::cleanupSession() {
+	// We can only end our session once it's stopping, normally on_state_stopping() has done so already,
+	// otherwise we destroy it while running which the runtime must handle.
+	if (running && session != XR_NULL_HANDLE && state == XR_SESSION_STATE_STOPPING) {
 		xrEndSession(session);
 		// we destroy this further down..
 	}
@@ -2451,12 +2853,11 @@ void OpenXRApi::uninitialize() {
 	cleanupActionSets();
 	cleanupSwapChains();
 	cleanupSpaces();
+	play_area_bounds.clear();
 
-	// cleanup our session and instance
-	if (buffer_index != nullptr) {
-		free(buffer_index);
-		buffer_index = nullptr;
-	}
+	// cleanup our session
+	buffer_index.clear();
+	swapchain_format = 0;
 	if (session != XR_NULL_HANDLE) {
 		for (XRExtensionWrapper *wrapper : registered_extension_wrappers) {
 			wrapper->on_session_destroyed();
@@ -2465,6 +2866,17 @@ void OpenXRApi::uninitialize() {
 		xrDestroySession(session);
 		session = XR_NULL_HANDLE;
 	}
+
+	state = XR_SESSION_STATE_UNKNOWN;
+	view_pose_valid = false;
+	head_pose_valid = false;
+	running = false;
+}
+
+void OpenXRApi::uninitialize() {
+	cleanupSession();
+
+	// cleanup our instance
 	if (instance != XR_NULL_HANDLE) {
 		for (XRExtensionWrapper *wrapper : registered_extension_wrappers) {
 			wrapper->on_instance_destroyed();
@@ -2472,18 +2884,116 @@ void OpenXRApi::uninitialize() {
 
 		xrDestroyInstance(instance);
 		instance = XR_NULL_HANDLE;
+
+		// our paths are no longer valid
+		std::lock_guard<std::mutex> lock(paths_mutex);
+		paths_by_string.clear();
+		strings_by_path.clear();
 	}
 	enabled_extensions.clear();
 
+	// finish any recording we were making
+	input_recorder.stop();
+
 	// reset a bunch of things
-	state = XR_SESSION_STATE_UNKNOWN;
-	view_pose_valid = false;
-	head_pose_valid = false;
+	action_map_reload_pending = false;
 	monado_stick_on_ball_ext = false;
-	running = false;
 	initialised = false;
 }
 
+bool OpenXRApi::reload_action_map(const godot::String &p_action_sets_json, const godot::String &p_interaction_profiles_json) {
+	if (!initialised) {
+		// we'll load these when we initialise
+		action_sets_json = p_action_sets_json;
+		interaction_profiles_json = p_interaction_profiles_json;
+		return true;
+	}
+
+	// Compare the parsed JSON so formatting changes don't cause a reload
+	JSON *json_parser = JSON::get_singleton();
+	Ref<JSONParseResult> new_action_sets = json_parser->parse(p_action_sets_json);
+	Ref<JSONParseResult> new_interaction_profiles = json_parser->parse(p_interaction_profiles_json);
+	if (new_action_sets->get_error() != Error::OK || new_interaction_profiles->get_error() != Error::OK) {
+		Godot::print_error("OpenXR couldn't parse the new action map, keeping our current action map", __FUNCTION__, __FILE__, __LINE__);
+		return false;
+	}
+
+	// If we're already waiting to reload we compare with the action map we're about to load
+	Ref<JSONParseResult> old_action_sets = json_parser->parse(action_map_reload_pending ? pending_action_sets_json : action_sets_json);
+	Ref<JSONParseResult> old_interaction_profiles = json_parser->parse(action_map_reload_pending ? pending_interaction_profiles_json : interaction_profiles_json);
+	if (json_parser->print(new_action_sets->get_result(), "", true) == json_parser->print(old_action_sets->get_result(), "", true) &&
+			json_parser->print(new_interaction_profiles->get_result(), "", true) == json_parser->print(old_interaction_profiles->get_result(), "", true)) {
+		// nothing changed
+		return true;
+	}
+
+	pending_action_sets_json = p_action_sets_json;
+	pending_interaction_profiles_json = p_interaction_profiles_json;
+	if (action_map_reload_pending) {
+		// we'll load this action map instead once our session has stopped
+		return true;
+	}
+
+	Godot::print("OpenXR reloading action map");
+
+	// Once attached our action sets and bindings can't be changed for our session, so we recreate our session.
+	// A running session can only be ended once the runtime has moved it to the stopping state, so we request
+	// it to exit and recreate it when it's exiting, see on_state_exiting().
+	action_map_reload_pending = true;
+	if (running) {
+		XrResult result = xrRequestExitSession(session);
+		if (!xr_result(result, "Failed to request our session to exit, keeping our current action map")) {
+			action_map_reload_pending = false;
+			return false;
+		}
+		return true;
+	}
+
+	// our session hasn't begun so we can destroy it right away
+	return apply_pending_action_map();
+}
+
+bool OpenXRApi::recreate_session() {
+	if (!initialiseSession()) {
+		return false;
+	}
+
+	for (XRExtensionWrapper *wrapper : registered_extension_wrappers) {
+		wrapper->on_session_initialized(session);
+	}
+
+	// Our action sets are bound once our session becomes ready
+	return loadActionSets();
+}
+
+bool OpenXRApi::apply_pending_action_map() {
+	action_map_reload_pending = false;
+
+	// We keep our instance and with it our path cache
+	cleanupSession();
+
+	godot::String previous_action_sets_json = action_sets_json;
+	godot::String previous_interaction_profiles_json = interaction_profiles_json;
+	action_sets_json = pending_action_sets_json;
+	interaction_profiles_json = pending_interaction_profiles_json;
+	if (recreate_session()) {
+		return true;
+	}
+
+	Godot::print_error("OpenXR couldn't load our new action map, restoring our previous action map", __FUNCTION__, __FILE__, __LINE__);
+	cleanupSession();
+
+	action_sets_json = previous_action_sets_json;
+	interaction_profiles_json = previous_interaction_profiles_json;
+	if (!recreate_session()) {
+		// we can't continue without a session
+		Godot::print_error("OpenXR couldn't recreate our session", __FUNCTION__, __FILE__, __LINE__);
+		uninitialize();
+	}
+
+	return false;
+}
+
 bool OpenXRApi::is_running() {
 	if (!initialised) {
 		return false;
@@ -2646,6 +3156,11 @@ bool OpenXRApi::on_state_exiting() {
 #ifdef DEBUG
 	Godot::print("OpenXR: On state exiting");
 #endif
+	if (action_map_reload_pending) {
+		// we requested to exit so we can load our new action map, we're not quitting
+		return apply_pending_action_map();
+	}
+
 	for (XRExtensionWrapper *wrapper : registered_extension_wrappers) {
 		wrapper->on_state_exiting();
 	}
@@ -2686,22 +3201,96 @@ void OpenXRApi::set_form_factor(const XrFormFactor p_form_factor) {
 	}
 }
 
+const OpenXRApi::PlayAreaBounds *OpenXRApi::get_play_area_bounds() {
+	if (!is_initialised()) {
+		return nullptr;
+	}
+
+	std::map<XrReferenceSpaceType, PlayAreaBounds>::iterator it = play_area_bounds.find(play_space_type);
+	if (it != play_area_bounds.end()) {
+		return &it->second;
+	}
+
+	XrExtent2Df extends = { 0.0, 0.0 };
+	XrResult result = xrGetReferenceSpaceBoundsRect(session, play_space_type, &extends);
+	if (!xr_result(result, "Couldn't obtain play space bounds!")) {
+		// don't cache this, we'll try again
+		return nullptr;
+	}
+
+	// Note, XR_SPACE_BOUNDS_UNAVAILABLE is cached as empty bounds, we get an event if they become available
+	PlayAreaBounds &bounds = play_area_bounds[play_space_type];
+	if (result == XR_SUCCESS && extends.width > 0.0 && extends.height > 0.0) {
+		bounds.extents = Size2(extends.width, extends.height);
+
+		// our bounds are a rectangle centered on our reference space
+		const float hw = 0.5 * extends.width;
+		const float hh = 0.5 * extends.height;
+		bounds.boundary.push_back(Vector2(-hw, -hh));
+		bounds.boundary.push_back(Vector2(hw, -hh));
+		bounds.boundary.push_back(Vector2(hw, hh));
+		bounds.boundary.push_back(Vector2(-hw, hh));
+	}
+
+	return &bounds;
+}
+
 Size2 OpenXRApi::get_play_space_bounds() {
-	Size2 ret;
+	const PlayAreaBounds *bounds = get_play_area_bounds();
+	if (bounds == nullptr) {
+		return Size2();
+	}
 
-	if (is_initialised()) {
-		XrExtent2Df extends;
+	return bounds->extents;
+}
+
+godot::PoolVector2Array OpenXRApi::get_play_space_boundary() {
+	PoolVector2Array arr;
 
-		XrResult result = xrGetReferenceSpaceBoundsRect(session, play_space_type, &extends);
-		if (!xr_result(result, "Couldn't obtain play space bounds!")) {
-			return ret;
+	const PlayAreaBounds *bounds = get_play_area_bounds();
+	if (bounds != nullptr) {
+		for (const Vector2 &point : bounds->boundary) {
+			arr.push_back(point);
 		}
+	}
 
-		ret.width = extends.width;
-		ret.height = extends.height;
+	return arr;
+}
+
+float OpenXRApi::get_distance_to_play_space_boundary(const Vector3 &p_position) {
+	const PlayAreaBounds *bounds = get_play_area_bounds();
+	if (bounds == nullptr || bounds->boundary.size() < 3) {
+		return 0.0;
+	}
+
+	const Vector2 p(p_position.x, p_position.z);
+	const std::vector<Vector2> &boundary = bounds->boundary;
+	float distance_squared = -1.0;
+	bool inside = false;
+
+	for (size_t i = 0, j = boundary.size() - 1; i < boundary.size(); j = i++) {
+		const Vector2 &a = boundary[j];
+		const Vector2 &b = boundary[i];
+
+		// closest point on this edge
+		const Vector2 edge = b - a;
+		const float length_squared = edge.dot(edge);
+		float t = length_squared > 0.0 ? (p - a).dot(edge) / length_squared : 0.0;
+		t = t < 0.0 ? 0.0 : (t > 1.0 ? 1.0 : t);
+		const Vector2 d = p - (a + edge * t);
+		const float edge_distance_squared = d.dot(d);
+		if (distance_squared < 0.0 || edge_distance_squared < distance_squared) {
+			distance_squared = edge_distance_squared;
+		}
+
+		// even-odd rule for inside test
+		if ((a.y > p.y) != (b.y > p.y) && p.x < a.x + (p.y - a.y) * (b.x - a.x) / (b.y - a.y)) {
+			inside = !inside;
+		}
 	}
 
-	return ret;
+	const float distance = sqrt(distance_squared);
+	return inside ? distance : -distance;
 }
 
 godot::Array OpenXRApi::get_enabled_extensions() const {
@@ -2733,6 +3322,20 @@ TrackingConfidence OpenXRApi::get_controller_tracking_confidence(const int p_god
 	return TRACKING_CONFIDENCE_NONE;
 }
 
+bool OpenXRApi::get_controller_velocity(const int p_godot_controller, float p_world_scale, Vector3 &r_linear_velocity, Vector3 &r_angular_velocity) const {
+	// our controllers are positioned using their pose action so that is what we report
+	for (const auto &inputmap : inputmaps) {
+		if (inputmap.godot_controller == p_godot_controller) {
+			if (!(inputmap.action_mask & (1 << inputmap.pose_action))) {
+				return false;
+			}
+			return default_actions[inputmap.pose_action].action->get_velocity(inputmap.toplevel_path, p_world_scale, r_linear_velocity, r_angular_velocity);
+		}
+	}
+
+	return false;
+}
+
 godot::String OpenXRApi::get_action_sets_json() const {
 	return action_sets_json;
 }
@@ -2750,16 +3353,109 @@ godot::String OpenXRApi::get_interaction_profiles_json() const {
 	return interaction_profiles_json;
 }
 
-void OpenXRApi::set_interaction_profiles_json(const godot::String &p_interaction_profiles_json) {
-	if (is_initialised()) {
-		Godot::print("OpenXR can't change the interaction profiles once OpenXR is initialised.");
-		return;
-	} else {
-		interaction_profiles_json = p_interaction_profiles_json;
+void OpenXRApi::set_interaction_profiles_json(const godot::String &p_interaction_profiles_json) {
+	if (is_initialised()) {
+		Godot::print("OpenXR can't change the interaction profiles once OpenXR is initialised.");
+		return;
+	} else {
+		interaction_profiles_json = p_interaction_profiles_json;
+	}
+}
+
+// actions
+
+void OpenXRApi::update_active_action_sets() {
+	active_action_sets.clear();
+	for (uint64_t s = 0; s < action_sets.size(); s++) {
+		if (action_sets[s]->is_active()) {
+			XrActionSet action_set = action_sets[s]->get_action_set();
+			if (action_set != XR_NULL_HANDLE) {
+				const std::vector<XrPath> &subaction_paths = action_sets[s]->get_subaction_paths();
+				if (subaction_paths.empty()) {
+					XrActiveActionSet active_set = {
+						.actionSet = action_set,
+						.subactionPath = XR_NULL_PATH
+					};
+					active_action_sets.push_back(active_set);
+				} else {
+					for (XrPath path : subaction_paths) {
+						XrActiveActionSet active_set = {
+							.actionSet = action_set,
+							.subactionPath = path
+						};
+						active_action_sets.push_back(active_set);
+					}
+				}
+			}
+		}
+	}
+
+	active_action_sets_dirty = false;
+}
+
+godot::Array OpenXRApi::get_action_set_names() const {
+	godot::Array names;
+
+	for (uint64_t i = 0; i < action_sets.size(); i++) {
+		names.push_back(action_sets[i]->get_name());
+	}
+
+	return names;
+}
+
+bool OpenXRApi::is_action_set_active(const godot::String &p_name) {
+	ActionSet *action_set = get_action_set(p_name);
+	if (action_set == nullptr) {
+		return false;
+	}
+
+	return action_set->is_active();
+}
+
+bool OpenXRApi::set_action_set_active(const godot::String &p_name, bool p_active) {
+	ActionSet *action_set = get_action_set(p_name);
+	if (action_set == nullptr) {
+		Godot::print_error(String("OpenXR unknown action set ") + p_name, __FUNCTION__, __FILE__, __LINE__);
+		return false;
+	}
+
+	action_set->set_active(p_active);
+	return true;
+}
+
+bool OpenXRApi::set_action_set_subaction_paths(const godot::String &p_name, const godot::PoolStringArray &p_paths) {
+	ActionSet *action_set = get_action_set(p_name);
+	if (action_set == nullptr) {
+		Godot::print_error(String("OpenXR unknown action set ") + p_name, __FUNCTION__, __FILE__, __LINE__);
+		return false;
+	}
+
+	std::vector<XrPath> subaction_paths;
+	for (int i = 0; i < p_paths.size(); i++) {
+		XrPath new_path = get_path(p_paths[i]);
+		if (new_path == XR_NULL_PATH) {
+			return false;
+		}
+
+		// xrSyncActions fails with XR_ERROR_PATH_UNSUPPORTED on top level paths none of our actions use
+		bool is_used = false;
+		for (Action *action : action_set->get_actions()) {
+			if (action->has_toplevel_path(new_path)) {
+				is_used = true;
+				break;
+			}
+		}
+		if (!is_used) {
+			Godot::print_error(String("OpenXR no action in ") + p_name + String(" uses ") + p_paths[i], __FUNCTION__, __FILE__, __LINE__);
+			return false;
+		}
+
+		subaction_paths.push_back(new_path);
 	}
-}
 
-// actions
+	action_set->set_subaction_paths(subaction_paths);
+	return true;
+}
 
 ActionSet *OpenXRApi::get_action_set(const godot::String &p_name) {
 	// Find it...
@@ -2856,10 +3552,13 @@ bool OpenXRApi::parse_action_sets(const godot::String &p_json) {
 			Array paths = action["paths"];
 			std::vector<XrPath> toplevel_paths;
 			for (int p = 0; p < paths.size(); p++) {
-				String path = paths[p];
-				XrPath new_path;
-				XrResult res = xrStringToPath(instance, path.utf8().get_data(), &new_path);
-				if (xr_result(res, "OpenXR couldn't register path {0}", path)) {
+				if (!is_path_supported(paths[p])) {
+					// i.e. Vive tracker roles when XR_HTCX_vive_tracker_interaction isn't available
+					continue;
+				}
+
+				XrPath new_path = get_path(String(paths[p]));
+				if (new_path != XR_NULL_PATH) {
 					toplevel_paths.push_back(new_path);
 				}
 			}
@@ -2876,6 +3575,17 @@ bool OpenXRApi::parse_action_sets(const godot::String &p_json) {
 	return true;
 }
 
+bool OpenXRApi::is_path_supported(const godot::String &p_path) const {
+	for (XRExtensionWrapper *wrapper : registered_extension_wrappers) {
+		if (!wrapper->path_is_supported(p_path)) {
+			// Only the extension that controlls optional paths will return false if the path is not supported.
+			return false;
+		}
+	}
+
+	return true;
+}
+
 bool OpenXRApi::parse_interaction_profiles(const godot::String &p_json) {
 	// We can push our interaction profiles directly to OpenXR. No need to keep them in memory.
 
@@ -2906,10 +3616,13 @@ bool OpenXRApi::parse_interaction_profiles(const godot::String &p_json) {
 
 		Dictionary profile = interaction_profiles[i];
 		String path_string = profile["path"];
+		if (!is_path_supported(path_string)) {
+			// profile belongs to an extension we don't have
+			continue;
+		}
 
-		XrPath interaction_profile_path;
-		XrResult res = xrStringToPath(instance, path_string.utf8().get_data(), &interaction_profile_path);
-		if (!xr_result(res, "OpenXR couldn't create path for {0}", path_string)) {
+		XrPath interaction_profile_path = get_path(path_string);
+		if (interaction_profile_path == XR_NULL_PATH) {
 			continue;
 		}
 
@@ -2941,27 +3654,15 @@ bool OpenXRApi::parse_interaction_profiles(const godot::String &p_json) {
 				String io_path_str = io_paths[p];
 				XrPath io_path = XR_NULL_PATH;
 
-				bool is_supported = true;
-				for (XRExtensionWrapper *wrapper : registered_extension_wrappers) {
-					if (!wrapper->path_is_supported(io_path_str)) {
-						// Only the extension that controlls optional io paths will return false if the path is not supported.
-						is_supported = false;
-						break;
-					}
-				}
-
-				if (!is_supported) {
+				if (!is_path_supported(io_path_str)) {
 					// If we include these interaction profiles can be rejected.
 					// This kind of makes sense but in our case seeing we're using a fixed action set we will exclude the entries.
 					Godot::print_warning(String("OpenXR ") + io_path_str + String(" is not supported by this runtime."), __FUNCTION__, __FILE__, __LINE__);
 					continue;
 				}
 
-				XrResult res = xrStringToPath(instance, io_path_str.utf8().get_data(), &io_path);
-				if (!xr_result(res, "OpenXR couldn't create path for {0}", io_path_str)) {
-					continue;
-				} else if (io_path == XR_NULL_PATH) {
-					Godot::print_warning(String("OpenXR ") + io_path_str + String(" is not supported by this runtime."), __FUNCTION__, __FILE__, __LINE__);
+				io_path = get_path(io_path_str);
+				if (io_path == XR_NULL_PATH) {
 					continue;
 				}
 
@@ -2970,6 +3671,11 @@ bool OpenXRApi::parse_interaction_profiles(const godot::String &p_json) {
 			}
 		}
 
+		if (xr_bindings.empty()) {
+			// nothing left to suggest for this profile
+			continue;
+		}
+
 		// update our profile
 		const XrInteractionProfileSuggestedBinding suggestedBindings = {
 			.type = XR_TYPE_INTERACTION_PROFILE_SUGGESTED_BINDING,
@@ -3056,6 +3762,30 @@ XrTime OpenXRApi::get_next_frame_time() const {
 	return frameState.predictedDisplayTime + frameState.predictedDisplayPeriod;
 }
 
+XrTime OpenXRApi::get_physics_frame_time() {
+	XrTime next_frame_time = get_next_frame_time();
+	if (next_frame_time == 0) {
+		return 0;
+	}
+
+	// We advance our physics time by one step for every physics tick. Godot runs physics ticks to keep up
+	// with real time so this follows our display time, we re-anchor if we drift too far.
+	Engine *engine = Engine::get_singleton();
+	int64_t frame = engine->get_physics_frames();
+	if (frame != physics_frame) {
+		const XrDuration step = 1000000000 / (engine->get_iterations_per_second() > 0 ? engine->get_iterations_per_second() : 60);
+		const XrDuration max_drift = 2 * (step > frameState.predictedDisplayPeriod ? step : frameState.predictedDisplayPeriod);
+
+		physics_frame_time += step;
+		if (physics_frame_time < next_frame_time - max_drift || physics_frame_time > next_frame_time + max_drift) {
+			physics_frame_time = next_frame_time;
+		}
+		physics_frame = frame;
+	}
+
+	return physics_frame_time;
+}
+
 XrResult OpenXRApi::acquire_image(int eye) {
 	XrResult result;
 	XrSwapchainImageAcquireInfo swapchainImageAcquireInfo = {
@@ -3082,7 +3812,7 @@ XrResult OpenXRApi::acquire_image(int eye) {
 }
 
 bool OpenXRApi::release_swapchain(int eye) {
-	if (swapchain_acquired[eye]) {
+	if (eye < (int)swapchain_acquired.size() && swapchain_acquired[eye]) {
 		swapchain_acquired[eye] = false; // mark as false whether we succeed or not...
 
 		XrSwapchainImageReleaseInfo swapchainImageReleaseInfo = {
@@ -3091,9 +3821,10 @@ bool OpenXRApi::release_swapchain(int eye) {
 		};
 		XrResult result = xrReleaseSwapchainImage(swapchains[eye], &swapchainImageReleaseInfo);
 
-		// Workaround for dealing with swapchain not getting released properly after screen recording
+		// Workaround for dealing with swapchain not getting released properly after screen recording,
+		// we rebuild this swapchain at the start of the next frame.
 		if (result != XR_SUCCESS) {
-			swapchain_error = true;
+			swapchain_error[eye] = true;
 		}
 
 		return xr_result(result, "failed to release swapchain image!");
@@ -3122,6 +3853,8 @@ void OpenXRApi::render_openxr(int eye, uint32_t texid, bool has_external_texture
 		return;
 	}
 
+	AllocationTracker::Scope allocation_scope;
+
 	XrResult result;
 
 	// TODO: save resources don't react on rendering if we're not running (session hasn't begun or has ended)
@@ -3129,7 +3862,8 @@ void OpenXRApi::render_openxr(int eye, uint32_t texid, bool has_external_texture
 		return;
 
 	// must have valid view pose for projection_views[eye].pose to submit layer
-	if (!frameState.shouldRender || !view_pose_valid) {
+	// and valid swapchains for both eyes, if we're waiting on a rebuild we submit an empty frame
+	if (!frameState.shouldRender || !view_pose_valid || !swapchains_valid()) {
 		/* Godot 3.1: we acquire and release the image below in this function.
 		 * Godot 3.2+: get_external_texture_for_eye() on acquires the image,
 		 * therefore we have to release it here.
@@ -3189,22 +3923,70 @@ void OpenXRApi::render_openxr(int eye, uint32_t texid, bool has_external_texture
 	projection_views[eye].fov = views[eye].fov;
 	projection_views[eye].pose = views[eye].pose;
 
+	// Give our extension wrappers a chance to add info to our projection view.
+	projection_views[eye].next = nullptr;
+	void **projection_view_pointer = const_cast<void **>(&projection_views[eye].next);
+	for (XRExtensionWrapper *wrapper : registered_extension_wrappers) {
+		void **projection_view_next_pointer = wrapper->set_projection_view_and_get_next_pointer(eye, projection_view_pointer);
+		if (*projection_view_pointer && projection_view_next_pointer && !*projection_view_next_pointer) {
+			projection_view_pointer = projection_view_next_pointer;
+		} else {
+			// Invalid return values.
+			// Reset the value stored by the projection_view_pointer so it can be reused in the next loop.
+			*projection_view_pointer = nullptr;
+		}
+	}
+
 	if (eye == 1) {
-		projectionLayer->views = projection_views;
+		uint64_t layers_start = frame_timing_start();
+
+		projectionLayer.views = projection_views.data();
 
-		std::vector<const XrCompositionLayerBaseHeader *> layers_list;
+		// Give our extension wrappers a chance to add info to our projection layer.
+		projectionLayer.next = nullptr;
+		void **projection_layer_pointer = const_cast<void **>(&projectionLayer.next);
+		for (XRExtensionWrapper *wrapper : registered_extension_wrappers) {
+			void **projection_layer_next_pointer = wrapper->set_projection_layer_and_get_next_pointer(projection_layer_pointer);
+			if (*projection_layer_pointer && projection_layer_next_pointer && !*projection_layer_next_pointer) {
+				projection_layer_pointer = projection_layer_next_pointer;
+			} else {
+				// Invalid return values.
+				// Reset the value stored by the projection_layer_pointer so it can be reused in the next loop.
+				*projection_layer_pointer = nullptr;
+			}
+		}
 
 		// Add composition layers from providers
+		provided_layers.clear();
 		for (XRCompositionLayerProvider *provider : composition_layer_providers) {
 			XrCompositionLayerBaseHeader *layer = provider->get_composition_layer();
 			if (layer) {
-				layers_list.push_back(layer);
+				provided_layers.push_back(std::make_pair(provider->get_composition_layer_order(), (const XrCompositionLayerBaseHeader *)layer));
 			}
 		}
 
-		layers_list.push_back((const XrCompositionLayerBaseHeader *)projectionLayer);
+		// Layers are composited in order, our projection layer sits at order 0.
+		std::stable_sort(provided_layers.begin(), provided_layers.end(), [](const std::pair<int, const XrCompositionLayerBaseHeader *> &a, const std::pair<int, const XrCompositionLayerBaseHeader *> &b) {
+			return a.first < b.first;
+		});
+
+		layers_list.clear();
+		uint64_t layer = 0;
+		for (; layer < provided_layers.size() && provided_layers[layer].first < 0; layer++) {
+			layers_list.push_back(provided_layers[layer].second);
+		}
+
+		// Only blend our projection layer if there is something behind it.
+		bool has_underlay = !layers_list.empty();
+		layers_list.push_back((const XrCompositionLayerBaseHeader *)&projectionLayer);
 
-		projectionLayer->layerFlags = layers_list.size() > 1 ? XR_COMPOSITION_LAYER_BLEND_TEXTURE_SOURCE_ALPHA_BIT | XR_COMPOSITION_LAYER_CORRECT_CHROMATIC_ABERRATION_BIT : XR_COMPOSITION_LAYER_CORRECT_CHROMATIC_ABERRATION_BIT;
+		for (; layer < provided_layers.size(); layer++) {
+			layers_list.push_back(provided_layers[layer].second);
+		}
+
+		projectionLayer.layerFlags = has_underlay ? XR_COMPOSITION_LAYER_BLEND_TEXTURE_SOURCE_ALPHA_BIT | XR_COMPOSITION_LAYER_CORRECT_CHROMATIC_ABERRATION_BIT : XR_COMPOSITION_LAYER_CORRECT_CHROMATIC_ABERRATION_BIT;
+
+		frame_timing_end(FRAME_TIMING_LAYERS, layers_start);
 
 		end_frame(static_cast<uint32_t>(layers_list.size()), layers_list.data());
 	}
@@ -3224,7 +4006,7 @@ void OpenXRApi::render_openxr(int eye, uint32_t texid, bool has_external_texture
 void OpenXRApi::fill_projection_matrix(int eye, godot_real p_z_near, godot_real p_z_far, godot_real *p_projection) {
 	XrMatrix4x4f matrix;
 
-	if (!initialised || !running) {
+	if (!initialised || !running || views.empty()) {
 		CameraMatrix *cm = (CameraMatrix *)p_projection;
 
 		cm->set_perspective(60.0, 1.0, p_z_near, p_z_far, false);
@@ -3247,7 +4029,7 @@ void OpenXRApi::fill_projection_matrix(int eye, godot_real p_z_near, godot_real
 	};
 	uint32_t viewCountOutput;
 	XrResult result;
-	result = xrLocateViews(session, &viewLocateInfo, &viewState, view_count, &viewCountOutput, views);
+	result = xrLocateViews(session, &viewLocateInfo, &viewState, view_count, &viewCountOutput, views.data());
 	if (!xr_result(result, "Could not locate views")) {
 		return;
 	}
@@ -3255,7 +4037,13 @@ void OpenXRApi::fill_projection_matrix(int eye, godot_real p_z_near, godot_real
 		return;
 	}
 
+	if (input_recorder.is_replaying()) {
+		input_recorder.replay_views(viewState.viewStateFlags, viewCountOutput, views.data());
+	}
+
 	XrMatrix4x4f_CreateProjectionFov(&matrix, GRAPHICS_OPENGL, views[eye].fov, p_z_near, p_z_far);
+	z_near = p_z_near;
+	z_far = p_z_far;
 
 	for (int i = 0; i < 16; i++) {
 		p_projection[i] = matrix.m[i];
@@ -3279,173 +4067,169 @@ void OpenXRApi::update_actions() {
 		return;
 	}
 
-	// loop through our action sets
-	std::vector<XrActiveActionSet> active_sets;
-	for (uint64_t s = 0; s < action_sets.size(); s++) {
-		if (action_sets[s]->is_active()) {
-			XrActionSet action_set = action_sets[s]->get_action_set();
-			if (action_set != XR_NULL_HANDLE) {
-				XrActiveActionSet active_set = {
-					.actionSet = action_set,
-					.subactionPath = XR_NULL_PATH
-				};
-				active_sets.push_back(active_set);
-			}
-		}
+	if (active_action_sets_dirty) {
+		update_active_action_sets();
 	}
 
-	if (active_sets.size() == 0) {
+	if (active_action_sets.size() == 0) {
 		// no active sets, no reason to sync.
 		return;
 	}
 
 	XrActionsSyncInfo syncInfo = {
 		.type = XR_TYPE_ACTIONS_SYNC_INFO,
-		.countActiveActionSets = (uint32_t)active_sets.size(),
-		.activeActionSets = active_sets.data()
+		.countActiveActionSets = (uint32_t)active_action_sets.size(),
+		.activeActionSets = active_action_sets.data()
 	};
 
 	result = xrSyncActions(session, &syncInfo);
 	xr_result(result, "failed to sync actions!");
 
-	/*
 	// now handle our actions
-	for (uint64_t s = 0; s < action_sets.size(); s++) {
-		if (action_sets[s]->is_active()) {
-			XrActionSet action_set = action_sets[s]->get_action_set();
-			if (action_set != XR_NULL_HANDLE) {
-				// Here we should do our generic handling of actions,
-				// but this is not supported in Godot 3 yet,
-				// we may add an intermediate solution
-				// In Godot 4 we'll be sending out events depending on state changes
-
-				// The problem here is that Godots action system is based on receiving events for our trigger points.
-				// But OpenXR is already doing this for us and is already providing us with action
-				// So we'll have to see how we make this work...
+	if (action_events_enabled && !action_changes.empty()) {
+		// Godots action system is based on receiving events for our trigger points,
+		// so we check our actions for changes and report those in one go.
+		// We collect into our largest array and copy the changes into the array that fits.
+		godot::Array &all_changes = action_changes.back();
+		uint32_t change_count = 0;
+		for (uint64_t s = 0; s < action_sets.size(); s++) {
+			if (action_sets[s]->is_active() && action_sets[s]->get_action_set() != XR_NULL_HANDLE) {
+				for (Action *action : action_sets[s]->get_actions()) {
+					action->collect_changes(all_changes, change_count);
+				}
+			}
+		}
+
+		if (change_count > 0) {
+			godot::Array &changes = action_changes[change_count];
+			if (change_count < action_changes.size() - 1) {
+				for (uint32_t i = 0; i < change_count; i++) {
+					changes[i] = all_changes[i];
+				}
 			}
+			emit_plugin_signal(SIGNAL_ACTIONS_CHANGED, changes);
 		}
 	}
-	*/
 
 	// now loop through our controllers, updated our positional trackers
 	// and perform our backwards compatibility layer
 
-	const float ws = ARVRServer::get_singleton()->get_world_scale();
+	for (InputMap &inputmap : inputmaps) {
+		XrPath input_path = inputmap.toplevel_path;
+		const uint32_t action_mask = inputmap.bound_action_mask;
 
-	for (uint64_t i = 0; i < USER_INPUT_MAX; i++) {
-		XrPath input_path = inputmaps[i].toplevel_path;
-		if (input_path == XR_NULL_PATH) {
-			// no path, skip this
-		} else {
-			bool is_active = false;
+		bool is_active = false;
 
-			// If our aim pose is active, our controller is active
-			// note, if the user has removed this action then our old controller approach becomes defunct
-			if (default_actions[ACTION_AIM_POSE].action != nullptr) {
-				is_active = default_actions[ACTION_AIM_POSE].action->is_pose_active(input_path);
-			}
+		// If our pose is active, our controller is active
+		// note, if the user has removed this action then our old controller approach becomes defunct
+		Action *pose_action = default_actions[inputmap.pose_action].action;
+		if (action_mask & (1 << inputmap.pose_action)) {
+			is_active = pose_action->is_pose_active(input_path);
+		}
 
-			if (is_active) {
-				if (inputmaps[i].godot_controller == -1) {
-					// hate using const_cast here but godot_arvr_add_controller should have it's parameter defined as const, it doesn't change it...
-					inputmaps[i].godot_controller = arvr_api->godot_arvr_add_controller(const_cast<char *>(inputmaps[i].name), (godot_int)i + 1, true, true);
+		if (is_active) {
+			if (inputmap.godot_controller == -1) {
+				// hate using const_cast here but godot_arvr_add_controller should have it's parameter defined as const, it doesn't change it...
+				inputmap.godot_controller = arvr_api->godot_arvr_add_controller(const_cast<char *>(inputmap.name.c_str()), inputmap.hand, true, true);
 
 #ifdef DEBUG
-					Godot::print("OpenXR mapped {0} to {1}", inputmaps[i].name, inputmaps[i].godot_controller);
+				Godot::print("OpenXR mapped {0} to {1}", inputmap.name.c_str(), inputmap.godot_controller);
 #endif
-				}
+			}
 
-				// copy for readability
-				int godot_controller = inputmaps[i].godot_controller;
+			// copy for readability
+			int godot_controller = inputmap.godot_controller;
 
-				// Start with our pose, we put our ARVRController on our aim pose (may need to change this to our grip pose...)
-				godot_transform controller_transform;
-				Transform *t = (Transform *)&controller_transform;
-				inputmaps[i].tracking_confidence = default_actions[ACTION_AIM_POSE].action->get_as_pose(input_path, ws, *t);
+			// Start with our pose, we put our ARVRController on our aim pose for hands (may need to change this to our grip pose...)
+			// Note that Godot applies world scale to controller positions itself so we must not scale them here.
+			godot_transform controller_transform;
+			Transform *t = (Transform *)&controller_transform;
+			inputmap.tracking_confidence = pose_action->get_as_pose(input_path, 1.0, *t);
 
-				if (inputmaps[i].tracking_confidence != TRACKING_CONFIDENCE_NONE) {
-					arvr_api->godot_arvr_set_controller_transform(godot_controller, &controller_transform, true, true);
-				}
+			if (inputmap.tracking_confidence != TRACKING_CONFIDENCE_NONE) {
+				arvr_api->godot_arvr_set_controller_transform(godot_controller, &controller_transform, true, true);
+			}
 
-				// OK, so OpenXR will tell us if the value has changed and we could skip sending our value
-				// but Godot also checks it so... just let Godot do it
+			// OK, so OpenXR will tell us if the value has changed and we could skip sending our value
+			// but Godot also checks it so... just let Godot do it
 
-				// Button and axis are hardcoded..
-				// Axis
-				if (default_actions[ACTION_FRONT_TRIGGER].action != nullptr) {
-					arvr_api->godot_arvr_set_controller_axis(godot_controller, 2, default_actions[ACTION_FRONT_TRIGGER].action->get_as_float(input_path), true); // 0.0 -> 1.0
-				}
-				if (default_actions[ACTION_SIDE_TRIGGER].action != nullptr) {
-					arvr_api->godot_arvr_set_controller_axis(godot_controller, 4, default_actions[ACTION_SIDE_TRIGGER].action->get_as_float(input_path), true); // 0.0 -> 1.0
-				}
-				if (default_actions[ACTION_PRIMARY].action != nullptr) {
-					Vector2 v = default_actions[ACTION_PRIMARY].action->get_as_vector(input_path);
-					arvr_api->godot_arvr_set_controller_axis(godot_controller, 0, v.x, true); // -1.0 -> 1.0
-					arvr_api->godot_arvr_set_controller_axis(godot_controller, 1, v.y, true); // -1.0 -> 1.0
-				}
-				if (default_actions[ACTION_SECONDARY].action != nullptr) {
-					Vector2 v = default_actions[ACTION_SECONDARY].action->get_as_vector(input_path);
-					arvr_api->godot_arvr_set_controller_axis(godot_controller, 6, v.x, true); // -1.0 -> 1.0
-					arvr_api->godot_arvr_set_controller_axis(godot_controller, 7, v.y, true); // -1.0 -> 1.0
-				}
-				// Buttons
-				if (default_actions[ACTION_AX_BUTTON].action != nullptr) {
-					arvr_api->godot_arvr_set_controller_button(godot_controller, 7, default_actions[ACTION_AX_BUTTON].action->get_as_bool(input_path));
-				}
-				if (default_actions[ACTION_BY_BUTTON].action != nullptr) {
-					arvr_api->godot_arvr_set_controller_button(godot_controller, 1, default_actions[ACTION_BY_BUTTON].action->get_as_bool(input_path));
-				}
-				if (default_actions[ACTION_AX_TOUCH].action != nullptr) {
-					arvr_api->godot_arvr_set_controller_button(godot_controller, 5, default_actions[ACTION_AX_TOUCH].action->get_as_bool(input_path));
-				}
-				if (default_actions[ACTION_BY_TOUCH].action != nullptr) {
-					arvr_api->godot_arvr_set_controller_button(godot_controller, 6, default_actions[ACTION_BY_TOUCH].action->get_as_bool(input_path));
-				}
-				if (default_actions[ACTION_MENU_BUTTON].action != nullptr) {
-					arvr_api->godot_arvr_set_controller_button(godot_controller, 3, default_actions[ACTION_MENU_BUTTON].action->get_as_bool(input_path));
-				}
-				if (default_actions[ACTION_SELECT_BUTTON].action != nullptr) {
-					arvr_api->godot_arvr_set_controller_button(godot_controller, 4, default_actions[ACTION_SELECT_BUTTON].action->get_as_bool(input_path));
-				}
-				if (default_actions[ACTION_FRONT_BUTTON].action != nullptr) {
-					arvr_api->godot_arvr_set_controller_button(godot_controller, 15, default_actions[ACTION_FRONT_BUTTON].action->get_as_bool(input_path));
-				}
-				if (default_actions[ACTION_FRONT_TOUCH].action != nullptr) {
-					arvr_api->godot_arvr_set_controller_button(godot_controller, 16, default_actions[ACTION_FRONT_TOUCH].action->get_as_bool(input_path));
-				}
-				if (default_actions[ACTION_SIDE_BUTTON].action != nullptr) {
-					arvr_api->godot_arvr_set_controller_button(godot_controller, 2, default_actions[ACTION_SIDE_BUTTON].action->get_as_bool(input_path));
-				}
-				if (default_actions[ACTION_PRIMARY_BUTTON].action != nullptr) {
-					arvr_api->godot_arvr_set_controller_button(godot_controller, 14, default_actions[ACTION_PRIMARY_BUTTON].action->get_as_bool(input_path));
-				}
-				if (default_actions[ACTION_SECONDARY_BUTTON].action != nullptr) {
-					arvr_api->godot_arvr_set_controller_button(godot_controller, 13, default_actions[ACTION_SECONDARY_BUTTON].action->get_as_bool(input_path));
-				}
-				if (default_actions[ACTION_PRIMARY_TOUCH].action != nullptr) {
-					arvr_api->godot_arvr_set_controller_button(godot_controller, 12, default_actions[ACTION_PRIMARY_TOUCH].action->get_as_bool(input_path));
-				}
-				if (default_actions[ACTION_SECONDARY_TOUCH].action != nullptr) {
-					arvr_api->godot_arvr_set_controller_button(godot_controller, 11, default_actions[ACTION_SECONDARY_TOUCH].action->get_as_bool(input_path));
-				}
+			// Button and axis are hardcoded..
+			// Axis
+			if (action_mask & (1 << ACTION_FRONT_TRIGGER)) {
+				arvr_api->godot_arvr_set_controller_axis(godot_controller, 2, default_actions[ACTION_FRONT_TRIGGER].action->get_as_float(input_path), true); // 0.0 -> 1.0
+			}
+			if (action_mask & (1 << ACTION_SIDE_TRIGGER)) {
+				arvr_api->godot_arvr_set_controller_axis(godot_controller, 4, default_actions[ACTION_SIDE_TRIGGER].action->get_as_float(input_path), true); // 0.0 -> 1.0
+			}
+			if (action_mask & (1 << ACTION_PRIMARY)) {
+				Vector2 v = default_actions[ACTION_PRIMARY].action->get_as_vector(input_path);
+				arvr_api->godot_arvr_set_controller_axis(godot_controller, 0, v.x, true); // -1.0 -> 1.0
+				arvr_api->godot_arvr_set_controller_axis(godot_controller, 1, v.y, true); // -1.0 -> 1.0
+			}
+			if (action_mask & (1 << ACTION_SECONDARY)) {
+				Vector2 v = default_actions[ACTION_SECONDARY].action->get_as_vector(input_path);
+				arvr_api->godot_arvr_set_controller_axis(godot_controller, 6, v.x, true); // -1.0 -> 1.0
+				arvr_api->godot_arvr_set_controller_axis(godot_controller, 7, v.y, true); // -1.0 -> 1.0
+			}
+			// Buttons
+			if (action_mask & (1 << ACTION_AX_BUTTON)) {
+				arvr_api->godot_arvr_set_controller_button(godot_controller, 7, default_actions[ACTION_AX_BUTTON].action->get_as_bool(input_path));
+			}
+			if (action_mask & (1 << ACTION_BY_BUTTON)) {
+				arvr_api->godot_arvr_set_controller_button(godot_controller, 1, default_actions[ACTION_BY_BUTTON].action->get_as_bool(input_path));
+			}
+			if (action_mask & (1 << ACTION_AX_TOUCH)) {
+				arvr_api->godot_arvr_set_controller_button(godot_controller, 5, default_actions[ACTION_AX_TOUCH].action->get_as_bool(input_path));
+			}
+			if (action_mask & (1 << ACTION_BY_TOUCH)) {
+				arvr_api->godot_arvr_set_controller_button(godot_controller, 6, default_actions[ACTION_BY_TOUCH].action->get_as_bool(input_path));
+			}
+			if (action_mask & (1 << ACTION_MENU_BUTTON)) {
+				arvr_api->godot_arvr_set_controller_button(godot_controller, 3, default_actions[ACTION_MENU_BUTTON].action->get_as_bool(input_path));
+			}
+			if (action_mask & (1 << ACTION_SELECT_BUTTON)) {
+				arvr_api->godot_arvr_set_controller_button(godot_controller, 4, default_actions[ACTION_SELECT_BUTTON].action->get_as_bool(input_path));
+			}
+			if (action_mask & (1 << ACTION_FRONT_BUTTON)) {
+				arvr_api->godot_arvr_set_controller_button(godot_controller, 15, default_actions[ACTION_FRONT_BUTTON].action->get_as_bool(input_path));
+			}
+			if (action_mask & (1 << ACTION_FRONT_TOUCH)) {
+				arvr_api->godot_arvr_set_controller_button(godot_controller, 16, default_actions[ACTION_FRONT_TOUCH].action->get_as_bool(input_path));
+			}
+			if (action_mask & (1 << ACTION_SIDE_BUTTON)) {
+				arvr_api->godot_arvr_set_controller_button(godot_controller, 2, default_actions[ACTION_SIDE_BUTTON].action->get_as_bool(input_path));
+			}
+			if (action_mask & (1 << ACTION_PRIMARY_BUTTON)) {
+				arvr_api->godot_arvr_set_controller_button(godot_controller, 14, default_actions[ACTION_PRIMARY_BUTTON].action->get_as_bool(input_path));
+			}
+			if (action_mask & (1 << ACTION_SECONDARY_BUTTON)) {
+				arvr_api->godot_arvr_set_controller_button(godot_controller, 13, default_actions[ACTION_SECONDARY_BUTTON].action->get_as_bool(input_path));
+			}
+			if (action_mask & (1 << ACTION_PRIMARY_TOUCH)) {
+				arvr_api->godot_arvr_set_controller_button(godot_controller, 12, default_actions[ACTION_PRIMARY_TOUCH].action->get_as_bool(input_path));
+			}
+			if (action_mask & (1 << ACTION_SECONDARY_TOUCH)) {
+				arvr_api->godot_arvr_set_controller_button(godot_controller, 11, default_actions[ACTION_SECONDARY_TOUCH].action->get_as_bool(input_path));
+			}
 
-				if (default_actions[ACTION_HAPTIC].action != nullptr) {
-					// Godot currently only gives us a float between 0.0 and 1.0 for rumble strength.
-					// Full haptic control will be offered through another object
-					float haptic = arvr_api->godot_arvr_get_controller_rumble(godot_controller);
-					if (haptic > 0.0) {
-						// 17,000,000.0 nanoseconds (17ms) is slightly more then the duration of one frame if we're outputting at 60fps
-						// so if we sustain our pulse we should be issuing a new pulse before the old one ends
-						default_actions[ACTION_HAPTIC].action->do_haptic_pulse(input_path, 17.0 * 1000 * 1000, XR_FREQUENCY_UNSPECIFIED, haptic);
-					}
-				}
-			} else if (inputmaps[i].godot_controller != -1) {
-				// Remove our controller, it's no longer active
-				arvr_api->godot_arvr_remove_controller(inputmaps[i].godot_controller);
-				inputmaps[i].godot_controller = -1;
+			if (action_mask & (1 << ACTION_HAPTIC)) {
+				// Godot currently only gives us a float between 0.0 and 1.0 for rumble strength.
+				// Full haptic control is offered through OpenXRHaptics, our scheduler only calls into the runtime when this changes.
+				float haptic = arvr_api->godot_arvr_get_controller_rumble(godot_controller);
+				haptic_scheduler.set_sustained_amplitude(default_actions[ACTION_HAPTIC].action, input_path, haptic);
+			}
+		} else if (inputmap.godot_controller != -1) {
+			// Remove our controller, it's no longer active
+			arvr_api->godot_arvr_remove_controller(inputmap.godot_controller);
+			inputmap.godot_controller = -1;
+
+			if (action_mask & (1 << ACTION_HAPTIC)) {
+				haptic_scheduler.set_sustained_amplitude(default_actions[ACTION_HAPTIC].action, input_path, 0.0);
 			}
 		}
 	}
+
+	haptic_scheduler.process();
 }
 
 void OpenXRApi::recommended_rendertarget_size(uint32_t *width, uint32_t *height) {
@@ -3495,7 +4279,7 @@ bool OpenXRApi::get_view_transform(int eye, float world_scale, godot_transform *
 		return false;
 	}
 
-	if (views == nullptr || !view_pose_valid) {
+	if (views.empty() || !view_pose_valid) {
 		return false;
 	}
 
@@ -3517,9 +4301,13 @@ bool OpenXRApi::get_head_center(float world_scale, godot_transform *transform) {
 	}
 
 	XrResult result;
+	// We get our velocity in the same call
+	head_velocity.next = nullptr;
+	head_velocity.velocityFlags = 0;
+
 	XrSpaceLocation location = {
 		.type = XR_TYPE_SPACE_LOCATION,
-		.next = nullptr
+		.next = &head_velocity
 	};
 
 	XrTime time;
@@ -3540,6 +4328,12 @@ bool OpenXRApi::get_head_center(float world_scale, godot_transform *transform) {
 		return false;
 	}
 
+	if (input_recorder.is_recording()) {
+		input_recorder.record_head(location, head_velocity);
+	} else if (input_recorder.is_replaying()) {
+		input_recorder.replay_head(location, head_velocity);
+	}
+
 	bool pose_valid = (location.locationFlags & (XR_SPACE_LOCATION_ORIENTATION_VALID_BIT + XR_SPACE_LOCATION_POSITION_VALID_BIT)) == (XR_SPACE_LOCATION_ORIENTATION_VALID_BIT + XR_SPACE_LOCATION_POSITION_VALID_BIT);
 	if (head_pose_valid != pose_valid) {
 		// prevent error spam
@@ -3563,6 +4357,28 @@ bool OpenXRApi::get_head_center(float world_scale, godot_transform *transform) {
 	return true;
 }
 
+bool OpenXRApi::get_head_velocity(float world_scale, Vector3 &r_linear_velocity, Vector3 &r_angular_velocity) const {
+	if (!head_pose_valid || head_velocity.velocityFlags == 0) {
+		return false;
+	}
+
+	if (head_velocity.velocityFlags & XR_SPACE_VELOCITY_LINEAR_VALID_BIT) {
+		const XrVector3f &v = head_velocity.linearVelocity;
+		r_linear_velocity = Vector3(v.x, v.y, v.z) * world_scale;
+	} else {
+		r_linear_velocity = Vector3();
+	}
+
+	if (head_velocity.velocityFlags & XR_SPACE_VELOCITY_ANGULAR_VALID_BIT) {
+		const XrVector3f &v = head_velocity.angularVelocity;
+		r_angular_velocity = Vector3(v.x, v.y, v.z);
+	} else {
+		r_angular_velocity = Vector3();
+	}
+
+	return true;
+}
+
 int OpenXRApi::get_external_texture_for_eye(int eye, bool *has_support) {
 	if (!initialised) {
 		return 0;
@@ -3572,7 +4388,7 @@ int OpenXRApi::get_external_texture_for_eye(int eye, bool *has_support) {
 	if (!running || state >= XR_SESSION_STATE_STOPPING)
 		return 0;
 
-	if (!frameState.shouldRender) {
+	if (!frameState.shouldRender || !swapchains_valid()) {
 		// We shouldn't be rendering at all but this prevents acquiring and rendering to our swap chain (Quest doesn't seem to like this)
 		// instead we render to Godots internal buffers. Also good for desktop as we still get our preview.
 
@@ -3600,7 +4416,7 @@ int OpenXRApi::get_external_texture_for_eye(int eye, bool *has_support) {
 #endif
 
 	// process should be called by now but just in case...
-	if (state > XR_SESSION_STATE_UNKNOWN && buffer_index != nullptr) {
+	if (state > XR_SESSION_STATE_UNKNOWN && !buffer_index.empty()) {
 		// make sure we know that we're rendering directly to our
 		// texture chain
 		*has_support = true;
@@ -3646,6 +4462,10 @@ bool OpenXRApi::poll_events() {
 			} break;
 			case XR_TYPE_EVENT_DATA_SESSION_STATE_CHANGED: {
 				XrEventDataSessionStateChanged *event = (XrEventDataSessionStateChanged *)&runtimeEvent;
+				if (event->session != session) {
+					// queued for a session we've since destroyed (i.e. when reloading our action map)
+					break;
+				}
 
 				state = event->state;
 				if (state >= XR_SESSION_STATE_MAX_ENUM) {
@@ -3696,6 +4516,9 @@ bool OpenXRApi::poll_events() {
 #ifdef DEBUG
 				Godot::print("OpenXR EVENT: reference space type {0} change pending!", event->referenceSpaceType);
 #endif
+				// our bounds may have changed
+				play_area_bounds.erase(event->referenceSpaceType);
+
 				if (event->poseValid) {
 					emit_plugin_signal(SIGNAL_POSE_RECENTERED);
 				}
@@ -3705,47 +4528,7 @@ bool OpenXRApi::poll_events() {
 				Godot::print("OpenXR EVENT: interaction profile changed!");
 #endif
 
-				XrEventDataInteractionProfileChanged *event = (XrEventDataInteractionProfileChanged *)&runtimeEvent;
-
-				XrInteractionProfileState profile_state = {
-					.type = XR_TYPE_INTERACTION_PROFILE_STATE,
-					.next = nullptr
-				};
-
-				for (int i = 0; i < USER_INPUT_MAX; i++) {
-					XrPath input_path = inputmaps[i].toplevel_path;
-					if (input_path == XR_NULL_PATH) {
-						// incorrect path
-						continue;
-					}
-
-					XrResult res = xrGetCurrentInteractionProfile(event->session, input_path, &profile_state);
-					if (!xr_result(res, "Failed to get interaction profile for {0}", inputmaps[i].name)) {
-						continue;
-					}
-
-					XrPath new_profile = profile_state.interactionProfile;
-					if (inputmaps[i].active_profile != new_profile) {
-						inputmaps[i].active_profile = new_profile;
-						if (new_profile == XR_NULL_PATH) {
-							Godot::print("OpenXR No interaction profile for {0}", inputmaps[i].name);
-							continue;
-						}
-
-						uint32_t strl;
-						char profile_str[XR_MAX_PATH_LENGTH];
-						res = xrPathToString(instance, new_profile, XR_MAX_PATH_LENGTH, &strl, profile_str);
-						if (!xr_result(res, "Failed to get interaction profile path str for {0}", inputmaps[i].name)) {
-							continue;
-						}
-
-#ifdef DEBUG
-						Godot::print("OpenXR Event: Interaction profile changed for {0}: {1}", inputmaps[i].name, profile_str);
-#endif
-					}
-				}
-
-				// TODO: do something
+				update_interaction_profiles();
 			} break;
 			default:
 				if (!handled) {
@@ -3771,9 +4554,17 @@ void OpenXRApi::process_openxr() {
 		return;
 	}
 
+	// Only allocations made in process_openxr and render_openxr count against our frame loop
+	AllocationTracker::Scope allocation_scope;
+
+	frame_timing_next_frame();
+	report_error_summary();
+
+	uint64_t timing_start = frame_timing_start();
 	if (!poll_events()) {
 		return;
 	}
+	frame_timing_end(FRAME_TIMING_POLL_EVENTS, timing_start);
 
 	XrResult result;
 
@@ -3807,18 +4598,34 @@ void OpenXRApi::process_openxr() {
 		frameState.predictedDisplayPeriod = 0;
 	}
 
-	// Workaround for dealing with swapchain not getting released properly after screen recording
-	if (swapchain_error) {
-		swapchain_error = false;
-		Godot::print("Swapchains need reinitialization");
-		cleanupSwapChains();
-		initialiseSwapChains();
+	if (input_recorder.get_mode() != InputRecorder::MODE_OFF) {
+		input_recorder.begin_frame(frameState);
 	}
 
+	// Workaround for dealing with swapchain not getting released properly after screen recording
+	rebuild_failed_swapchains();
+
+	timing_start = frame_timing_start();
 	update_actions();
+	frame_timing_end(FRAME_TIMING_UPDATE_ACTIONS, timing_start);
+
+	timing_start = frame_timing_start();
 	for (XRExtensionWrapper *wrapper : registered_extension_wrappers) {
 		wrapper->on_process_openxr();
 	}
+	frame_timing_end(FRAME_TIMING_EXTENSIONS, timing_start);
+
+	// update all our pose nodes in one go
+	if (!pose_listeners.empty()) {
+		timing_start = frame_timing_start();
+		ARVRServer *server = ARVRServer::get_singleton();
+		const float ws = server->get_world_scale();
+		const Transform reference_frame = server->get_reference_frame();
+		for (XRPoseListener *listener : pose_listeners) {
+			listener->on_poses_updated(ws, reference_frame);
+		}
+		frame_timing_end(FRAME_TIMING_POSE_LISTENERS, timing_start);
+	}
 
 	XrViewLocateInfo viewLocateInfo = {
 		.type = XR_TYPE_VIEW_LOCATE_INFO,
@@ -3832,11 +4639,19 @@ void OpenXRApi::process_openxr() {
 		.next = nullptr
 	};
 	uint32_t viewCountOutput;
-	result = xrLocateViews(session, &viewLocateInfo, &viewState, view_count, &viewCountOutput, views);
+	timing_start = frame_timing_start();
+	result = xrLocateViews(session, &viewLocateInfo, &viewState, view_count, &viewCountOutput, views.data());
+	frame_timing_end(FRAME_TIMING_LOCATE_VIEWS, timing_start);
 	if (!xr_result(result, "Could not locate views")) {
 		return;
 	}
 
+	if (input_recorder.is_recording()) {
+		input_recorder.record_views(viewState.viewStateFlags, viewCountOutput, views.data());
+	} else if (input_recorder.is_replaying()) {
+		input_recorder.replay_views(viewState.viewStateFlags, viewCountOutput, views.data());
+	}
+
 	bool pose_valid = true;
 	for (uint64_t i = 0; i < viewCountOutput; i++) {
 		if ((viewState.viewStateFlags & XR_VIEW_STATE_ORIENTATION_VALID_BIT) == 0 ||
@@ -3883,79 +4698,274 @@ void OpenXRApi::process_openxr() {
 #endif
 }
 
+void OpenXRApi::set_frame_timings_enabled(bool p_enabled) {
+	frame_timings_enabled = p_enabled;
+
+	// Start with a clean slate
+	frame_timing_frame_count = 0;
+	for (int i = 0; i < FRAME_TIMING_MAX; i++) {
+		frame_timing_accumulated_ns[i] = 0;
+		frame_timing_peak_ns[i] = 0;
+		frame_timing_average_ns[i] = 0;
+		frame_timing_max_ns[i] = 0;
+	}
+	frame_timing_allocation_count = AllocationTracker::get_allocation_count();
+	frame_timing_allocations = 0;
+	frame_timing_allocation_failures = 0;
+}
+
+void OpenXRApi::frame_timing_end(FrameTiming p_timing, uint64_t p_start) {
+	if (!frame_timings_enabled || p_start == 0) {
+		return;
+	}
+
+	uint64_t elapsed = frame_timing_start() - p_start;
+	frame_timing_accumulated_ns[p_timing] += elapsed;
+	if (elapsed > frame_timing_peak_ns[p_timing]) {
+		frame_timing_peak_ns[p_timing] = elapsed;
+	}
+}
+
+void OpenXRApi::frame_timing_next_frame() {
+	if (!frame_timings_enabled) {
+		return;
+	}
+
+	frame_timing_frame_count++;
+	if (frame_timing_frame_count < FRAME_TIMING_WINDOW) {
+		return;
+	}
+
+	uint64_t total_ns = 0;
+	for (int i = 0; i < FRAME_TIMING_MAX; i++) {
+		frame_timing_average_ns[i] = frame_timing_accumulated_ns[i] / frame_timing_frame_count;
+		frame_timing_max_ns[i] = frame_timing_peak_ns[i];
+		total_ns += frame_timing_average_ns[i];
+
+		frame_timing_accumulated_ns[i] = 0;
+		frame_timing_peak_ns[i] = 0;
+	}
+	frame_timing_frame_count = 0;
+
+	// Everything we allocated in process_openxr and render_openxr, including our nodes processing, since the last window
+	uint64_t allocation_count = AllocationTracker::get_allocation_count();
+	frame_timing_allocations = allocation_count - frame_timing_allocation_count;
+	frame_timing_allocation_count = allocation_count;
+
+	// We only check our budget once per window so we don't flood the output
+	if (frame_timing_budget_ns > 0 && total_ns > frame_timing_budget_ns) {
+		Godot::print_warning(String("OpenXR frame loop is using ") + String::num_int64(total_ns) + String("ns per frame, exceeding our budget of ") + String::num_int64(frame_timing_budget_ns) + String("ns"), __FUNCTION__, __FILE__, __LINE__);
+		emit_plugin_signal(SIGNAL_FRAME_BUDGET_EXCEEDED, (int64_t)total_ns);
+	}
+
+	// Once running our frame loop must not allocate any memory, this is an error and counted so tests can fail on it
+	if (running && frame_timing_allocations > 0) {
+		frame_timing_allocation_failures++;
+		Godot::print_error(String("OpenXR made ") + String::num_int64(frame_timing_allocations) + String(" heap allocations in the last ") + String::num_int64(FRAME_TIMING_WINDOW) + String(" frames"), __FUNCTION__, __FILE__, __LINE__);
+	}
+}
+
+const char *OpenXRApi::get_frame_timing_name(FrameTiming p_timing) {
+	switch (p_timing) {
+		case FRAME_TIMING_POLL_EVENTS: {
+			return "poll_events";
+		} break;
+		case FRAME_TIMING_UPDATE_ACTIONS: {
+			return "update_actions";
+		} break;
+		case FRAME_TIMING_EXTENSIONS: {
+			return "extensions";
+		} break;
+		case FRAME_TIMING_POSE_LISTENERS: {
+			return "pose_listeners";
+		} break;
+		case FRAME_TIMING_LOCATE_VIEWS: {
+			return "locate_views";
+		} break;
+		case FRAME_TIMING_LAYERS: {
+			return "layers";
+		} break;
+		default: {
+			return "unknown";
+		} break;
+	}
+}
+
+bool OpenXRApi::count_error(const char *p_format, XrResult p_result, uint64_t &r_count) const {
+	std::lock_guard<std::mutex> lock(error_sites_mutex);
+
+	for (uint32_t i = 0; i < error_site_count; i++) {
+		ErrorSite &site = error_sites[i];
+		if (site.format == p_format && site.result == p_result) {
+			site.count++;
+			r_count = site.count;
+			if (site.count < site.next_report) {
+				return false;
+			}
+
+			// log again after twice as many errors
+			site.next_report = site.count * 2;
+			site.reported_count = site.count;
+			return true;
+		}
+	}
+
+	r_count = 1;
+	if (error_site_count < MAX_ERROR_SITES) {
+		ErrorSite &site = error_sites[error_site_count++];
+		site.format = p_format;
+		site.result = p_result;
+		site.count = 1;
+		site.reported_count = 1;
+		site.next_report = 2;
+	}
+
+	// first time we see this error (or our table is full), always log it
+	return true;
+}
+
+void OpenXRApi::report_error_summary() {
+	uint64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	if (now - error_summary_time < ERROR_SUMMARY_INTERVAL_NS) {
+		return;
+	}
+	error_summary_time = now;
+
+	std::lock_guard<std::mutex> lock(error_sites_mutex);
+
+	for (uint32_t i = 0; i < error_site_count; i++) {
+		ErrorSite &site = error_sites[i];
+		if (site.count > site.reported_count) {
+			char resultString[XR_MAX_RESULT_STRING_SIZE];
+			if (XR_FAILED(xrResultToString(instance, site.result, resultString))) {
+				snprintf(resultString, XR_MAX_RESULT_STRING_SIZE, "%d", site.result);
+			}
+
+			Godot::print_error(String("OpenXR ") + String(site.format) + String(" [") + String(resultString) + String("] suppressed ") + String::num_int64(site.count - site.reported_count) + String(" times, ") + String::num_int64(site.count) + String(" in total"), __FUNCTION__, __FILE__, __LINE__);
+			site.reported_count = site.count;
+		}
+	}
+}
+
+Array OpenXRApi::get_error_counts() const {
+	std::lock_guard<std::mutex> lock(error_sites_mutex);
+
+	Array errors;
+	for (uint32_t i = 0; i < error_site_count; i++) {
+		const ErrorSite &site = error_sites[i];
+
+		char resultString[XR_MAX_RESULT_STRING_SIZE];
+		if (XR_FAILED(xrResultToString(instance, site.result, resultString))) {
+			// our instance may already be gone
+			snprintf(resultString, XR_MAX_RESULT_STRING_SIZE, "%d", site.result);
+		}
+
+		Dictionary error;
+		error["message"] = String(site.format);
+		error["result"] = String(resultString);
+		error["count"] = (int64_t)site.count;
+		errors.push_back(error);
+	}
+
+	return errors;
+}
+
+void OpenXRApi::clear_error_counts() {
+	std::lock_guard<std::mutex> lock(error_sites_mutex);
+
+	error_site_count = 0;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // Utility functions
 
+// Same as Basis(Quat) but OpenXR gives us unit quaternions so we can skip normalising.
+static inline void basis_from_orientation(const XrQuaternionf &p_orientation, Basis &r_basis) {
+	const real_t xs = p_orientation.x * 2.0;
+	const real_t ys = p_orientation.y * 2.0;
+	const real_t zs = p_orientation.z * 2.0;
+	const real_t wx = p_orientation.w * xs;
+	const real_t wy = p_orientation.w * ys;
+	const real_t wz = p_orientation.w * zs;
+	const real_t xx = p_orientation.x * xs;
+	const real_t xy = p_orientation.x * ys;
+	const real_t xz = p_orientation.x * zs;
+	const real_t yy = p_orientation.y * ys;
+	const real_t yz = p_orientation.y * zs;
+	const real_t zz = p_orientation.z * zs;
+
+	r_basis.elements[0] = Vector3(1.0 - (yy + zz), xy - wz, xz + wy);
+	r_basis.elements[1] = Vector3(xy + wz, 1.0 - (xx + zz), yz - wx);
+	r_basis.elements[2] = Vector3(xz - wy, yz + wx, 1.0 - (xx + yy));
+}
+
 Transform OpenXRApi::transform_from_pose(const XrPosef &p_pose, float p_world_scale) {
-	Quat q(p_pose.orientation.x, p_pose.orientation.y, p_pose.orientation.z, p_pose.orientation.w);
-	Basis basis(q);
-	Vector3 origin(p_pose.position.x * p_world_scale, p_pose.position.y * p_world_scale, p_pose.position.z * p_world_scale);
+	Transform transform;
+	basis_from_orientation(p_pose.orientation, transform.basis);
+	transform.origin = Vector3(p_pose.position.x * p_world_scale, p_pose.position.y * p_world_scale, p_pose.position.z * p_world_scale);
 
-	return Transform(basis, origin);
+	return transform;
 }
 
 template <typename T>
-TrackingConfidence _transform_from_location(const T &p_location, Transform &r_transform) {
-	Basis basis;
-	Vector3 origin;
+TrackingConfidence OpenXRApi::transform_from_location(const T &p_location, float p_world_scale, Transform &r_transform, const Transform *p_reference_frame) {
+	const XrSpaceLocationFlags flags = p_location.locationFlags;
+	if ((flags & (XR_SPACE_LOCATION_ORIENTATION_VALID_BIT | XR_SPACE_LOCATION_POSITION_VALID_BIT)) == 0) {
+		// No tracking data, leave our transform as is
+		return TRACKING_CONFIDENCE_NONE;
+	}
+
 	TrackingConfidence confidence = TRACKING_CONFIDENCE_NONE;
-	const auto &pose = p_location.pose;
+	Transform t;
 
 	// Check orientation
-	if (p_location.locationFlags & XR_SPACE_LOCATION_ORIENTATION_VALID_BIT) {
-		Quat q(pose.orientation.x, pose.orientation.y, pose.orientation.z, pose.orientation.w);
-		r_transform.basis = Basis(q);
+	if (flags & XR_SPACE_LOCATION_ORIENTATION_VALID_BIT) {
+		basis_from_orientation(p_location.pose.orientation, t.basis);
 
-		if (p_location.locationFlags & XR_SPACE_LOCATION_ORIENTATION_TRACKED_BIT) {
+		if (flags & XR_SPACE_LOCATION_ORIENTATION_TRACKED_BIT) {
 			// Fully valid orientation, so either 3DOF or 6DOF tracking with high confidence so default to HIGH_TRACKING
 			confidence = TRACKING_CONFIDENCE_HIGH;
 		} else {
 			// Orientation is being tracked but we're using old/predicted data, so low tracking confidence
 			confidence = TRACKING_CONFIDENCE_LOW;
 		}
-	} else {
-		r_transform.basis = Basis();
 	}
 
-	// Check location
-	if (p_location.locationFlags & XR_SPACE_LOCATION_POSITION_VALID_BIT) {
-		r_transform.origin = Vector3(pose.position.x, pose.position.y, pose.position.z);
+	// Check location, without it we're 3DOF and stay at our origin
+	if (flags & XR_SPACE_LOCATION_POSITION_VALID_BIT) {
+		const XrVector3f &position = p_location.pose.position;
+		t.origin = Vector3(position.x * p_world_scale, position.y * p_world_scale, position.z * p_world_scale);
 
-		if (!(p_location.locationFlags & XR_SPACE_LOCATION_ORIENTATION_TRACKED_BIT)) {
+		if (!(flags & XR_SPACE_LOCATION_POSITION_TRACKED_BIT)) {
 			// Location is being tracked but we're using old/predicted data, so low tracking confidence
 			confidence = TRACKING_CONFIDENCE_LOW;
 		} else if (confidence == TRACKING_CONFIDENCE_NONE) {
 			// Position tracking without orientation tracking?
 			confidence = TRACKING_CONFIDENCE_HIGH;
 		}
-	} else {
-		// No tracking or 3DOF I guess..
-		r_transform.origin = Vector3();
 	}
 
-	return confidence;
-}
+	r_transform = p_reference_frame != nullptr ? *p_reference_frame * t : t;
 
-TrackingConfidence OpenXRApi::transform_from_location(const XrSpaceLocation &p_location, float p_world_scale, Transform &r_transform) {
-	Transform t;
-	TrackingConfidence confidence = _transform_from_location(p_location, t);
-	if (confidence != TRACKING_CONFIDENCE_NONE) {
-		// only update if we have tracking data
-		r_transform = t;
-	}
 	return confidence;
 }
 
-TrackingConfidence OpenXRApi::transform_from_location(const XrHandJointLocationEXT &p_location, float p_world_scale, Transform &r_transform) {
-	Transform t;
-	TrackingConfidence confidence = _transform_from_location(p_location, t);
-	if (confidence != TRACKING_CONFIDENCE_NONE) {
-		// only update if we have tracking data
-		r_transform = t;
+template <typename T>
+void OpenXRApi::transform_from_locations(const T *p_locations, uint32_t p_count, float p_world_scale, Transform *r_transforms, TrackingConfidence *r_confidences, const Transform *p_reference_frame) {
+	for (uint32_t i = 0; i < p_count; i++) {
+		TrackingConfidence confidence = transform_from_location(p_locations[i], p_world_scale, r_transforms[i], p_reference_frame);
+		if (r_confidences != nullptr) {
+			r_confidences[i] = confidence;
+		}
 	}
-	return confidence;
 }
 
+// These are the location types OpenXR gives us
+template TrackingConfidence OpenXRApi::transform_from_location<XrSpaceLocation>(const XrSpaceLocation &p_location, float p_world_scale, Transform &r_transform, const Transform *p_reference_frame);
+template TrackingConfidence OpenXRApi::transform_from_location<XrHandJointLocationEXT>(const XrHandJointLocationEXT &p_location, float p_world_scale, Transform &r_transform, const Transform *p_reference_frame);
+template void OpenXRApi::transform_from_locations<XrSpaceLocation>(const XrSpaceLocation *p_locations, uint32_t p_count, float p_world_scale, Transform *r_transforms, TrackingConfidence *r_confidences, const Transform *p_reference_frame);
+template void OpenXRApi::transform_from_locations<XrHandJointLocationEXT>(const XrHandJointLocationEXT *p_locations, uint32_t p_count, float p_world_scale, Transform *r_transforms, TrackingConfidence *r_confidences, const Transform *p_reference_frame);
+
 godot::String OpenXRApi::get_swapchain_format_name(int64_t p_swapchain_format) {
 	// These are somewhat different per platform, will need to weed some stuff out...
 	switch (p_swapchain_format) {
@@ -4117,6 +5127,7 @@ godot::String OpenXRApi::get_swapchain_format_name(int64_t p_swapchain_format) {
 		ENUM_TO_STRING_CASE(GL_RGB10_A2_EXT)
 		ENUM_TO_STRING_CASE(GL_RGBA12_EXT)
 		ENUM_TO_STRING_CASE(GL_RGBA16_EXT)
+		ENUM_TO_STRING_CASE(GL_RGBA16F_ARB)
 		ENUM_TO_STRING_CASE(GL_SRGB_EXT)
 		ENUM_TO_STRING_CASE(GL_SRGB8_EXT)
 		ENUM_TO_STRING_CASE(GL_SRGB_ALPHA_EXT)
@@ -21,9 +21,14 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <chrono>
+#include <map>
+#include <mutex>
 #include <set>
+#include <string>
 #include <vector>
 
+#include "allocation_tracker.h"
 #include "xrmath.h"
 
 #ifdef WIN32
@@ -46,9 +51,18 @@
 
 #include "openxr/extensions/xr_composition_layer_provider.h"
 #include "openxr/extensions/xr_extension_wrapper.h"
+#include "openxr/extensions/xr_pose_listener.h"
 #include "openxr/include/openxr_inc.h"
 #include <openxr/openxr_platform.h>
 
+#ifdef ANDROID
+typedef XrSwapchainImageOpenGLESKHR XrSwapchainImageGL;
+#define XR_TYPE_SWAPCHAIN_IMAGE_GL XR_TYPE_SWAPCHAIN_IMAGE_OPENGL_ES_KHR
+#else
+typedef XrSwapchainImageOpenGLKHR XrSwapchainImageGL;
+#define XR_TYPE_SWAPCHAIN_IMAGE_GL XR_TYPE_SWAPCHAIN_IMAGE_OPENGL_KHR
+#endif
+
 // forward declare this
 class OpenXRApi;
 
@@ -58,10 +72,32 @@ enum TrackingConfidence {
 	TRACKING_CONFIDENCE_HIGH
 };
 
+// Swapchain formats we know how to request, mapped to the GL format for each platform.
+enum SwapchainFormat {
+	SWAPCHAIN_FORMAT_SRGB8_ALPHA8,
+	SWAPCHAIN_FORMAT_RGBA8,
+	SWAPCHAIN_FORMAT_RGB10_A2,
+	SWAPCHAIN_FORMAT_RGBA16F,
+	SWAPCHAIN_FORMAT_MAX
+};
+
+// CPU time we measure for each part of our frame loop
+enum FrameTiming {
+	FRAME_TIMING_POLL_EVENTS,
+	FRAME_TIMING_UPDATE_ACTIONS,
+	FRAME_TIMING_EXTENSIONS, // on_process_openxr on our extension wrappers, this includes hand tracking
+	FRAME_TIMING_POSE_LISTENERS, // updating our pose nodes
+	FRAME_TIMING_LOCATE_VIEWS,
+	FRAME_TIMING_LAYERS, // assembling the layers we submit in xrEndFrame
+	FRAME_TIMING_MAX
+};
+
+#include "openxr/actions/pose_history.h"
+#include "openxr/input_recorder.h"
+
 #include "openxr/actions/action.h"
 #include "openxr/actions/actionset.h"
-
-#define USER_INPUT_MAX 2
+#include "openxr/actions/haptic_scheduler.h"
 
 using namespace godot;
 
@@ -70,26 +106,6 @@ class OpenXRApi {
 	friend class ActionSet;
 
 public:
-	// These are hardcoded and meant for our backwards compatibility layer
-	// If not configured in our action sets they will be defunct
-
-	struct InputMap {
-		const char *name;
-		XrPath toplevel_path;
-		godot_int godot_controller;
-		XrPath active_profile; // note, this can be a profile added in the OpenXR runtime unknown to our default mappings
-		TrackingConfidence tracking_confidence;
-	};
-
-	InputMap inputmaps[USER_INPUT_MAX] = {
-		{ "/user/hand/left", XR_NULL_PATH, -1, XR_NULL_PATH, TRACKING_CONFIDENCE_NONE },
-		{ "/user/hand/right", XR_NULL_PATH, -1, XR_NULL_PATH, TRACKING_CONFIDENCE_NONE },
-		// gamepad is already supported in Godots own joystick handling, head we're using directly
-		// { "/user/foot/left", XR_NULL_PATH, -1, XR_NULL_PATH, TRACKING_CONFIDENCE_NONE },
-		// { "/user/foot/right", XR_NULL_PATH, -1, XR_NULL_PATH, TRACKING_CONFIDENCE_NONE },
-		// { "/user/treadmill", XR_NULL_PATH, -1, XR_NULL_PATH, TRACKING_CONFIDENCE_NONE },
-	};
-
 	// Default actions we support so we can mimic our old ARVRController handling
 	enum DefaultActions {
 		// Poses
@@ -152,6 +168,32 @@ public:
 		{ "haptic", XR_ACTION_TYPE_VIBRATION_OUTPUT, nullptr },
 	};
 
+	// Top level paths we expose as ARVRControllers for our backwards compatibility layer.
+	// These are discovered from our action sets and from runtime events (i.e. Vive trackers),
+	// godot controllers are added when a device becomes active.
+	struct InputMap {
+		std::string name;
+		XrPath toplevel_path;
+		godot_int hand; // 1 = left hand, 2 = right hand, 0 = other devices
+		DefaultActions pose_action; // aim pose for hands, grip pose for other devices
+		uint32_t action_mask; // bit set for each default action that has this top level path
+		godot_int godot_controller;
+		XrPath active_profile; // note, this can be a profile added in the OpenXR runtime unknown to our default mappings
+		godot::String profile_name; // name of our active profile, empty if we have none
+		uint32_t bound_action_mask; // part of action_mask that our active profile binds to an input
+		TrackingConfidence tracking_confidence;
+	};
+
+	// Only contains valid entries so update_actions can loop through it without checks
+	std::vector<InputMap> inputmaps;
+
+	// Add a top level path to our input maps, returns false if it's a path we don't expose.
+	bool register_input_map(XrPath p_toplevel_path);
+	const InputMap *get_input_map(XrPath p_toplevel_path) const;
+
+	// Name of the interaction profile currently active for this top level path (i.e. /user/hand/left)
+	godot::String get_interaction_profile(const godot::String &p_toplevel_path) const;
+
 private:
 	enum ActionSetStatus {
 		ACTION_SET_UNINITIALISED,
@@ -167,7 +209,6 @@ private:
 	static OpenXRApi *singleton;
 	bool initialised = false;
 	bool running = false;
-	bool swapchain_error = false;
 	int use_count = 1;
 	godot::OS::VideoDriver video_driver = godot::OS::VIDEO_DRIVER_GLES3;
 
@@ -177,6 +218,36 @@ private:
 	std::vector<const char *> enabled_extensions;
 	std::set<XRExtensionWrapper *> registered_extension_wrappers;
 	std::set<XRCompositionLayerProvider *> composition_layer_providers;
+	std::set<XRPoseListener *> pose_listeners;
+
+	// What we know about the interaction profiles we've encountered, our bindings can't change
+	// once our action sets are attached so this is only cleared when we unbind them.
+	struct InteractionProfile {
+		godot::String name;
+		std::map<XrPath, uint32_t> bound_action_masks; // per top level path, see InputMap::bound_action_mask
+	};
+	std::map<XrPath, InteractionProfile> interaction_profiles;
+	InteractionProfile *get_interaction_profile_info(XrPath p_profile);
+	uint32_t get_bound_action_mask(InteractionProfile &p_profile, const InputMap &p_inputmap);
+	void update_interaction_profiles();
+
+	// Play area bounds per reference space type, these only change when the runtime tells us
+	// through a reference space change event so we don't query the runtime every time.
+	// Our boundary is a closed polygon on the floor (x/z), in meters without world scale applied.
+	struct PlayAreaBounds {
+		godot::Size2 extents; // zero if the runtime has no bounds for this reference space
+		std::vector<godot::Vector2> boundary;
+	};
+	std::map<XrReferenceSpaceType, PlayAreaBounds> play_area_bounds;
+	const PlayAreaBounds *get_play_area_bounds();
+
+	// Only rebuilt when our action sets are (de)activated, see update_active_action_sets()
+	std::vector<XrActiveActionSet> active_action_sets;
+	bool active_action_sets_dirty = true;
+
+	// Reused every frame so we don't allocate memory in our frame loop
+	std::vector<std::pair<int, const XrCompositionLayerBaseHeader *> > provided_layers;
+	std::vector<const XrCompositionLayerBaseHeader *> layers_list;
 
 	// feature flags
 	XrViewConfigurationType view_config_type = XR_VIEW_CONFIGURATION_TYPE_PRIMARY_STEREO;
@@ -192,34 +263,95 @@ private:
 	bool keep_3d_linear = false;
 #ifdef WIN32
 	XrGraphicsBindingOpenGLWin32KHR graphics_binding_gl;
-	XrSwapchainImageOpenGLKHR **images = nullptr;
 #elif ANDROID
 	XrGraphicsBindingOpenGLESAndroidKHR graphics_binding_gl;
-	XrSwapchainImageOpenGLESKHR **images = nullptr;
 #else
 	XrGraphicsBindingOpenGLXlibKHR graphics_binding_gl;
-	XrSwapchainImageOpenGLKHR **images = nullptr;
 #endif
+	std::vector<std::vector<XrSwapchainImageGL> > images;
 	float render_target_size_multiplier = 1.0f;
 	uint32_t render_target_width = 1024;
 	uint32_t render_target_height = 1024;
-	uint32_t swapchain_sample_count = 1;
 
-	XrSwapchain *swapchains = nullptr;
-	bool *swapchain_acquired = nullptr;
+	// Formats we'd like to use from most to least preferred.
+	std::vector<SwapchainFormat> swapchain_format_preference;
+
+	// Format selected the first time we create our swapchains, reused when we rebuild them.
+	int64_t swapchain_format = 0;
+
+	// Frame timings are averaged over a number of frames so they can be queried at any time.
+	static const uint32_t FRAME_TIMING_WINDOW = 90;
+	bool frame_timings_enabled = false;
+	uint64_t frame_timing_budget_ns = 0; // 0 = don't check
+	uint32_t frame_timing_frame_count = 0;
+	uint64_t frame_timing_accumulated_ns[FRAME_TIMING_MAX] = {};
+	uint64_t frame_timing_peak_ns[FRAME_TIMING_MAX] = {};
+	uint64_t frame_timing_average_ns[FRAME_TIMING_MAX] = {};
+	uint64_t frame_timing_max_ns[FRAME_TIMING_MAX] = {};
+	uint64_t frame_timing_allocation_count = 0;
+	uint64_t frame_timing_allocations = 0;
+	uint64_t frame_timing_allocation_failures = 0; // number of windows in which we allocated while running
+
+	uint64_t frame_timing_start() const {
+		if (!frame_timings_enabled) {
+			return 0;
+		}
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+	void frame_timing_end(FrameTiming p_timing, uint64_t p_start);
+	void frame_timing_next_frame();
+
+	// Errors are counted per call site (identified by the format string passed to xr_result) and result.
+	// We log the first occurrence and then back off exponentially, suppressed errors are summarised periodically.
+	static const uint32_t MAX_ERROR_SITES = 64;
+	static const uint64_t ERROR_SUMMARY_INTERVAL_NS = 10000000000; // 10 seconds
+	struct ErrorSite {
+		const char *format;
+		XrResult result;
+		uint64_t count;
+		uint64_t reported_count;
+		uint64_t next_report;
+	};
+	mutable std::mutex error_sites_mutex;
+	mutable ErrorSite error_sites[MAX_ERROR_SITES];
+	mutable uint32_t error_site_count = 0;
+	uint64_t error_summary_time = 0;
+	bool count_error(const char *p_format, XrResult p_result, uint64_t &r_count) const;
+	void report_error_summary();
+
+	// Paths we've converted in either direction, XrPaths remain valid until our instance is destroyed.
+	std::mutex paths_mutex;
+	std::map<std::string, XrPath> paths_by_string;
+	std::map<XrPath, godot::String> strings_by_path;
+
+	std::vector<XrSwapchain> swapchains;
+	std::vector<bool> swapchain_acquired;
+	// Swapchains that failed to release properly, these are rebuilt at the start of the next frame.
+	std::vector<bool> swapchain_error;
+	// Swapchains we failed to rebuild, we keep trying each frame but only log the first attempt.
+	std::vector<bool> swapchain_rebuild_failed;
 	uint32_t view_count;
 
-	XrCompositionLayerProjection *projectionLayer = nullptr;
+	XrCompositionLayerProjection projectionLayer = {};
 	XrFrameState frameState = {};
 
-	uint32_t *buffer_index = nullptr;
+	// near and far planes of the projection we last rendered with
+	float z_near = 0.05f;
+	float z_far = 100.0f;
+
+	std::vector<uint32_t> buffer_index;
 
-	XrView *views = nullptr;
-	XrCompositionLayerProjectionView *projection_views = nullptr;
+	std::vector<XrView> views;
+	std::vector<XrCompositionLayerProjectionView> projection_views;
 	XrSpace play_space = XR_NULL_HANDLE;
 	XrSpace view_space = XR_NULL_HANDLE;
 	bool view_pose_valid = false;
 	bool head_pose_valid = false;
+	XrSpaceVelocity head_velocity = {
+		.type = XR_TYPE_SPACE_VELOCITY,
+		.next = nullptr,
+		.velocityFlags = 0,
+	};
 
 	// config
 	/*
@@ -236,10 +368,39 @@ private:
 	 */
 	XrFormFactor form_factor = XR_FORM_FACTOR_HEAD_MOUNTED_DISPLAY;
 
+	/*
+	 * When headless we create our session without a graphics binding (XR_MND_headless),
+	 * we process input and tracking but never submit any images.
+	 */
+	bool headless = false;
+
+	// Records the data we get from the runtime or replays a previous recording
+	InputRecorder input_recorder;
+
+	// Time our current physics tick is simulating, see get_physics_frame_time()
+	XrTime physics_frame_time = 0;
+	int64_t physics_frame = 0;
+
+	// If enabled we report changes to our actions through signals and input events.
+	// We report exactly the changes made each frame, action_changes[n] holds n changes so this never
+	// resizes an array, the last entry is big enough for every input action to change at once.
+	bool action_events_enabled = false;
+	std::vector<godot::Array> action_changes;
+	void prepare_action_changes();
+
+	// Plays haptic effects on our vibration actions
+	HapticScheduler haptic_scheduler = HapticScheduler(this);
+
 	godot::String action_sets_json;
 	godot::String interaction_profiles_json;
 
+	// Action map we load once our session has stopped, see reload_action_map
+	bool action_map_reload_pending = false;
+	godot::String pending_action_sets_json;
+	godot::String pending_interaction_profiles_json;
+
 	std::vector<ActionSet *> action_sets;
+	uint64_t action_sets_generation = 0;
 
 	bool isExtensionSupported(const char *extensionName, XrExtensionProperties *instanceExtensionProperties, uint32_t instanceExtensionCount);
 	bool isViewConfigSupported(XrViewConfigurationType type, XrSystemId systemId);
@@ -247,15 +408,25 @@ private:
 
 	bool initialiseInstance();
 	bool initialiseSession();
+	bool initialiseGraphicsBinding();
 	bool initialiseSpaces();
 	void cleanupSpaces();
 	bool initialiseSwapChains();
 	void cleanupSwapChains();
+	bool select_swapchain_format();
+	bool create_swapchain(uint32_t eye);
+	void destroy_swapchain(uint32_t eye);
+	void rebuild_failed_swapchains();
+	bool swapchains_valid() const;
 
 	bool loadActionSets();
 	bool bindActionSets();
 	void unbindActionSets();
 	void cleanupActionSets();
+	void cleanupSession();
+	bool recreate_session();
+	bool apply_pending_action_map();
+	void update_active_action_sets();
 
 	bool poll_events();
 	bool on_state_idle();
@@ -275,9 +446,11 @@ private:
 	bool release_swapchain(int eye);
 	void end_frame(uint32_t p_layer_count, const XrCompositionLayerBaseHeader *const *p_layers);
 
+	bool is_path_supported(const godot::String &p_path) const;
 	bool parse_action_sets(const godot::String &p_json);
 	bool parse_interaction_profiles(const godot::String &p_json);
 
+	bool get_requested_swapchain_format(SwapchainFormat p_format, RequestedSwapchainFormat &r_requested_format) const;
 	godot::String get_swapchain_format_name(int64_t p_swapchain_format);
 
 public:
@@ -302,12 +475,24 @@ public:
 
 	void register_composition_layer_provider(XRCompositionLayerProvider *provider) {
 		composition_layer_providers.insert(provider);
+
+		// Make sure we don't need to grow these while rendering
+		provided_layers.reserve(composition_layer_providers.size());
+		layers_list.reserve(composition_layer_providers.size() + 1);
 	}
 
 	void unregister_composition_layer_provider(XRCompositionLayerProvider *provider) {
 		composition_layer_providers.erase(provider);
 	}
 
+	void register_pose_listener(XRPoseListener *listener) {
+		pose_listeners.insert(listener);
+	}
+
+	void unregister_pose_listener(XRPoseListener *listener) {
+		pose_listeners.erase(listener);
+	}
+
 	bool is_initialised();
 	bool initialize();
 	void uninitialize();
@@ -317,20 +502,53 @@ public:
 	void on_pause();
 
 	XrInstance get_instance() { return instance; };
+
+	// Convert between path strings and XrPaths, each path is only converted by OpenXR once.
+	// These return XR_NULL_PATH or an empty string if the conversion fails, and are thread safe.
+	XrPath get_path(const char *p_path);
+	XrPath get_path(const godot::String &p_path);
+	godot::String get_path_string(XrPath p_path);
 	XrSession get_session() { return session; };
 	XrSystemId get_system_id() { return systemId; }
 	XrSpace get_play_space() { return play_space; }
 	XrFrameState get_frame_state() { return frameState; }
+	float get_z_near() const { return z_near; }
+	float get_z_far() const { return z_far; }
 	String get_system_name() const { return system_name; }
 	uint32_t get_vendor_id() const { return vendor_id; }
 	XrTime get_next_frame_time() const;
+	XrTime get_physics_frame_time();
 
 	XrReferenceSpaceType get_play_space_type() { return play_space_type; }
 	void set_play_space_type(XrReferenceSpaceType p_type);
 
+	bool is_headless() const { return headless; }
+	void set_headless(bool p_headless);
+
+	InputRecorder *get_input_recorder() { return &input_recorder; }
+	HapticScheduler *get_haptic_scheduler() { return &haptic_scheduler; }
+
+	bool get_action_events_enabled() const { return action_events_enabled; }
+	void set_action_events_enabled(bool p_enabled);
+
 	float get_render_target_size_multiplier() { return render_target_size_multiplier; }
 	bool set_render_target_size_multiplier(float multiplier);
 
+	const std::vector<SwapchainFormat> &get_swapchain_format_preference() const { return swapchain_format_preference; }
+	bool set_swapchain_format_preference(const std::vector<SwapchainFormat> &p_formats);
+	int64_t get_swapchain_format() const { return swapchain_format; }
+	godot::String get_selected_swapchain_format_name();
+
+	bool get_frame_timings_enabled() const { return frame_timings_enabled; }
+	void set_frame_timings_enabled(bool p_enabled);
+	uint64_t get_frame_timing_budget_ns() const { return frame_timing_budget_ns; }
+	void set_frame_timing_budget_ns(uint64_t p_budget_ns) { frame_timing_budget_ns = p_budget_ns; }
+	uint64_t get_frame_timing_average_ns(FrameTiming p_timing) const { return frame_timing_average_ns[p_timing]; }
+	uint64_t get_frame_timing_max_ns(FrameTiming p_timing) const { return frame_timing_max_ns[p_timing]; }
+	uint64_t get_frame_timing_allocations() const { return frame_timing_allocations; }
+	uint64_t get_frame_timing_allocation_failures() const { return frame_timing_allocation_failures; }
+	static const char *get_frame_timing_name(FrameTiming p_timing);
+
 	uint32_t get_view_count() const { return view_count; }
 	const XrSwapchain &get_swapchain(uint32_t eye) { return swapchains[eye]; }
 
@@ -341,18 +559,29 @@ public:
 		if (XR_SUCCEEDED(result))
 			return true;
 
+		// Errors that repeat every frame are only logged occasionally
+		uint64_t count;
+		if (!count_error(format, result, count)) {
+			return false;
+		}
+
 		char resultString[XR_MAX_RESULT_STRING_SIZE];
 		xrResultToString(instance, result, resultString);
 
-		godot::Godot::print_error(
-				godot::String("OpenXR ") + godot::String(format).format(godot::Array::make(values...)) + godot::String(" [") + godot::String(resultString) + godot::String("]"),
-				__FUNCTION__,
-				__FILE__,
-				__LINE__);
+		godot::String message = godot::String("OpenXR ") + godot::String(format).format(godot::Array::make(values...)) + godot::String(" [") + godot::String(resultString) + godot::String("]");
+		if (count > 1) {
+			message += godot::String(" (occurred ") + godot::String::num_int64(count) + godot::String(" times)");
+		}
+
+		godot::Godot::print_error(message, __FUNCTION__, __FILE__, __LINE__);
 
 		return false;
 	};
 
+	// Returns an array with a dictionary for each error we've encountered
+	godot::Array get_error_counts() const;
+	void clear_error_counts();
+
 	// config
 	XrViewConfigurationType get_view_configuration_type() const;
 	void set_view_configuration_type(const XrViewConfigurationType p_view_configuration_type);
@@ -361,12 +590,18 @@ public:
 	void set_form_factor(const XrFormFactor p_form_factor);
 
 	Size2 get_play_space_bounds();
+	godot::PoolVector2Array get_play_space_boundary();
+
+	// Distance from p_position (in our play space, without world scale) to our boundary, measured on the floor.
+	// Positive inside our play area, negative outside, 0.0 if we don't have bounds.
+	float get_distance_to_play_space_boundary(const godot::Vector3 &p_position);
 
 	godot::Array get_enabled_extensions() const;
 
 	bool is_input_map_controller(int p_godot_controller);
 
 	TrackingConfidence get_controller_tracking_confidence(const int p_godot_controller) const;
+	bool get_controller_velocity(const int p_godot_controller, float p_world_scale, godot::Vector3 &r_linear_velocity, godot::Vector3 &r_angular_velocity) const;
 
 	static const char *default_action_sets_json;
 	godot::String get_action_sets_json() const;
@@ -377,7 +612,16 @@ public:
 	void set_interaction_profiles_json(const godot::String &p_interaction_profiles_json);
 
 	bool has_action_sets() { return action_sets.size() > 0; };
+	// Incremented whenever our action sets are destroyed, pointers to our actions are no longer valid when this changes.
+	uint64_t get_action_sets_generation() const { return action_sets_generation; }
+	// Replace our action sets and interaction profiles, recreates our session if they've changed.
+	// If our session is running we first request it to exit, the new action map is loaded once it has stopped.
+	bool reload_action_map(const godot::String &p_action_sets_json, const godot::String &p_interaction_profiles_json);
 	ActionSet *get_action_set(const godot::String &p_name);
+	godot::Array get_action_set_names() const;
+	bool is_action_set_active(const godot::String &p_name);
+	bool set_action_set_active(const godot::String &p_name, bool p_active);
+	bool set_action_set_subaction_paths(const godot::String &p_name, const godot::PoolStringArray &p_paths);
 	Action *get_action(const char *p_name);
 
 	/* render_openxr() should be called once per eye.
@@ -400,6 +644,8 @@ public:
 
 	// get_head_center() can be called at any time after init
 	bool get_head_center(float world_scale, godot_transform *transform);
+	// velocities obtained during our last get_head_center() call
+	bool get_head_velocity(float world_scale, godot::Vector3 &r_linear_velocity, godot::Vector3 &r_angular_velocity) const;
 
 	// get_external_texture_for_eye() acquires images and sets has_support to true
 	int get_external_texture_for_eye(int eye, bool *has_support);
@@ -410,9 +656,14 @@ public:
 	// helper method to get a transform from an openxr pose
 	godot::Transform transform_from_pose(const XrPosef &p_pose, float p_world_scale);
 
-	// helper method to get a valid transform from an openxr space location
-	TrackingConfidence transform_from_location(const XrSpaceLocation &p_location, float p_world_scale, Transform &r_transform);
-	TrackingConfidence transform_from_location(const XrHandJointLocationEXT &p_location, float p_world_scale, Transform &r_transform);
+	// helper method to get a valid transform from an openxr space location (XrSpaceLocation or XrHandJointLocationEXT),
+	// applies our world scale and, if provided, our reference frame. r_transform is left untouched if we have no tracking data.
+	template <typename T>
+	TrackingConfidence transform_from_location(const T &p_location, float p_world_scale, Transform &r_transform, const Transform *p_reference_frame = nullptr);
+
+	// same as above for an array of locations, r_confidences is optional
+	template <typename T>
+	void transform_from_locations(const T *p_locations, uint32_t p_count, float p_world_scale, Transform *r_transforms, TrackingConfidence *r_confidences = nullptr, const Transform *p_reference_frame = nullptr);
 };
 
 #endif /* !OPENXR_API_H */
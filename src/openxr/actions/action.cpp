@@ -1,19 +1,53 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////
 // Class for OpenXR Actions
 
+#include <Input.hpp>
+#include <InputEventAction.hpp>
+#include <InputMap.hpp>
+#include <cmath>
+
 #include "openxr/OpenXRApi.h"
 
 using namespace godot;
 
-Action::Action(OpenXRApi *p_api, XrActionSet p_action_set, XrActionType p_type, const godot::String &p_name, const godot::String &p_localised_name, int p_toplevel_path_count, const XrPath *p_toplevel_paths) {
+// Analog values are only reported when they change this much since we last reported them, or reach the end of their range
+static const float ANALOG_CHANGE_EPSILON = 0.01f;
+
+static bool analog_value_changed(float p_value, float p_last_value) {
+	if (p_value == p_last_value) {
+		return false;
+	} else if (p_value == 0.0f || p_value == 1.0f || p_value == -1.0f) {
+		// always report a released trigger or a thumbstick pushed all the way
+		return true;
+	}
+
+	return fabs(p_value - p_last_value) >= ANALOG_CHANGE_EPSILON;
+}
+
+Action::Action(OpenXRApi *p_api, XrActionSet p_action_set, const godot::String &p_action_set_name, XrActionType p_type, const godot::String &p_name, const godot::String &p_localised_name, int p_toplevel_path_count, const XrPath *p_toplevel_paths) {
 	xr_api = p_api;
 	type = p_type;
 	name = p_name;
+	action_set_name = p_action_set_name;
+	full_name = action_set_name + String("/") + name;
+	change_value_key = String("value");
 
 	for (int i = 0; i < p_toplevel_path_count; i++) {
-		path_with_space tlp = {
-			p_toplevel_paths[i], XR_NULL_HANDLE, false
-		};
+		path_with_space tlp;
+		tlp.toplevel_path = p_toplevel_paths[i];
+		tlp.space = XR_NULL_HANDLE;
+		tlp.wasLocationvalid = false;
+		tlp.recording_keys[0] = InputRecorder::INVALID_KEY;
+		tlp.recording_keys[1] = InputRecorder::INVALID_KEY;
+		tlp.recording_generation = 0;
+		tlp.last_value[0] = 0.0;
+		tlp.last_value[1] = 0.0;
+
+		tlp.path_name = p_api->get_path_string(tlp.toplevel_path);
+
+		tlp.change["action"] = full_name;
+		tlp.change["path"] = tlp.path_name;
+		tlp.change[change_value_key] = Variant();
 
 		toplevel_paths.push_back(tlp);
 	}
@@ -50,7 +84,42 @@ void Action::reset_spaces() {
 			xrDestroySpace(toplevel_paths[i].space);
 			toplevel_paths[i].space = XR_NULL_HANDLE;
 		}
+
+		toplevel_paths[i].history.clear();
+	}
+}
+
+int64_t Action::find_path_index(const XrPath p_path) const {
+	for (uint64_t i = 0; i < toplevel_paths.size(); i++) {
+		if (toplevel_paths[i].toplevel_path == p_path) {
+			return (int64_t)i;
+		}
+	}
+
+	return -1;
+}
+
+uint32_t Action::get_recording_key(const XrPath p_path, bool p_location) {
+	InputRecorder *recorder = xr_api->get_input_recorder();
+	if (recorder->get_mode() == InputRecorder::MODE_OFF) {
+		return InputRecorder::INVALID_KEY;
 	}
+
+	int64_t index = find_path_index(p_path);
+	if (index == -1) {
+		return InputRecorder::INVALID_KEY;
+	}
+
+	path_with_space &tlp = toplevel_paths[index];
+	if (tlp.recording_generation != recorder->get_generation()) {
+		// we started a new recording or replay, look up our keys once
+		String key_name = action_set_name + String("/") + name + tlp.path_name;
+		tlp.recording_keys[0] = recorder->get_key(key_name);
+		tlp.recording_keys[1] = recorder->get_key(key_name + String("/location"));
+		tlp.recording_generation = recorder->get_generation();
+	}
+
+	return tlp.recording_keys[p_location ? 1 : 0];
 }
 
 XrActionType Action::get_type() const {
@@ -65,6 +134,22 @@ XrAction Action::get_action() const {
 	return handle;
 }
 
+uint32_t Action::get_toplevel_path_count() const {
+	return (uint32_t)toplevel_paths.size();
+}
+
+XrPath Action::get_toplevel_path(uint32_t p_index) const {
+	if (p_index >= toplevel_paths.size()) {
+		return XR_NULL_PATH;
+	}
+
+	return toplevel_paths[p_index].toplevel_path;
+}
+
+bool Action::has_toplevel_path(const XrPath p_path) const {
+	return find_path_index(p_path) != -1;
+}
+
 bool Action::get_as_bool(XrPath p_path) {
 	if (!xr_api->is_running()) {
 		// not running
@@ -83,6 +168,13 @@ bool Action::get_as_bool(XrPath p_path) {
 			.subactionPath = p_path
 		};
 
+		InputRecorder *recorder = xr_api->get_input_recorder();
+		uint32_t recording_key = get_recording_key(p_path);
+		InputRecorder::ActionRecord record = {};
+		if (recorder->is_replaying()) {
+			return recorder->replay_action(recording_key, record) && record.value[0] != 0.0;
+		}
+
 		XrActionStateBoolean resultState;
 		resultState.type = XR_TYPE_ACTION_STATE_BOOLEAN,
 		resultState.next = nullptr;
@@ -91,6 +183,12 @@ bool Action::get_as_bool(XrPath p_path) {
 			resultState.isActive = false;
 		}
 
+		if (recorder->is_recording()) {
+			record.is_active = resultState.isActive;
+			record.value[0] = resultState.currentState ? 1.0 : 0.0;
+			recorder->record_action(recording_key, record);
+		}
+
 		// we should do something with resultState.isActive
 
 		return resultState.currentState;
@@ -115,6 +213,14 @@ float Action::get_as_float(XrPath p_path) {
 			.subactionPath = p_path
 		};
 
+		InputRecorder *recorder = xr_api->get_input_recorder();
+		uint32_t recording_key = get_recording_key(p_path);
+		InputRecorder::ActionRecord record = {};
+		if (recorder->is_replaying()) {
+			recorder->replay_action(recording_key, record);
+			return record.value[0];
+		}
+
 		XrActionStateFloat resultState;
 		resultState.type = XR_TYPE_ACTION_STATE_FLOAT,
 		resultState.next = nullptr;
@@ -132,6 +238,12 @@ float Action::get_as_float(XrPath p_path) {
 			resultState.currentState = 1.0;
 		}
 
+		if (recorder->is_recording()) {
+			record.is_active = resultState.isActive;
+			record.value[0] = resultState.currentState;
+			recorder->record_action(recording_key, record);
+		}
+
 		return resultState.currentState;
 	}
 }
@@ -154,6 +266,14 @@ Vector2 Action::get_as_vector(XrPath p_path) {
 			.subactionPath = p_path
 		};
 
+		InputRecorder *recorder = xr_api->get_input_recorder();
+		uint32_t recording_key = get_recording_key(p_path);
+		InputRecorder::ActionRecord record = {};
+		if (recorder->is_replaying()) {
+			recorder->replay_action(recording_key, record);
+			return Vector2(record.value[0], record.value[1]);
+		}
+
 		XrActionStateVector2f resultState;
 		resultState.type = XR_TYPE_ACTION_STATE_VECTOR2F,
 		resultState.next = nullptr;
@@ -162,6 +282,13 @@ Vector2 Action::get_as_vector(XrPath p_path) {
 			resultState.isActive = false;
 		}
 
+		if (recorder->is_recording()) {
+			record.is_active = resultState.isActive;
+			record.value[0] = resultState.currentState.x;
+			record.value[1] = resultState.currentState.y;
+			recorder->record_action(recording_key, record);
+		}
+
 		// we should do something with resultState.isActive
 
 		return Vector2(resultState.currentState.x, resultState.currentState.y);
@@ -188,6 +315,13 @@ bool Action::is_pose_active(XrPath p_path) {
 			.subactionPath = p_path
 		};
 
+		InputRecorder *recorder = xr_api->get_input_recorder();
+		uint32_t recording_key = get_recording_key(p_path);
+		InputRecorder::ActionRecord record = {};
+		if (recorder->is_replaying()) {
+			return recorder->replay_action(recording_key, record) && record.is_active;
+		}
+
 		XrActionStatePose resultState;
 		resultState.type = XR_TYPE_ACTION_STATE_POSE,
 		resultState.next = nullptr;
@@ -196,6 +330,11 @@ bool Action::is_pose_active(XrPath p_path) {
 			resultState.isActive = false;
 		}
 
+		if (recorder->is_recording()) {
+			record.is_active = resultState.isActive;
+			recorder->record_action(recording_key, record);
+		}
+
 		return resultState.isActive;
 	}
 }
@@ -211,19 +350,39 @@ TrackingConfidence Action::get_as_pose(XrPath p_path, float p_world_scale, Trans
 		// wrong type
 		return TRACKING_CONFIDENCE_NONE;
 	} else {
-		// find out the index for our path, note, thanks to register_path we can use our pointers here
-		uint64_t index = 0xFFFFFFFF;
-		for (uint64_t i = 0; i < toplevel_paths.size() && index == 0xFFFFFFFF; i++) {
-			if (toplevel_paths[i].toplevel_path == p_path) {
-				index = i;
-			}
-		}
-
-		if (index == 0xFFFFFFFF) {
+		// find out the index for our path
+		int64_t index = find_path_index(p_path);
+		if (index == -1) {
 			// couldn't find it?
 			return TRACKING_CONFIDENCE_NONE;
 		}
 
+		InputRecorder *recorder = xr_api->get_input_recorder();
+		uint32_t recording_key = get_recording_key(p_path, true);
+		if (recorder->is_replaying()) {
+			InputRecorder::ActionRecord record;
+			if (!recorder->replay_action(recording_key, record)) {
+				return TRACKING_CONFIDENCE_NONE;
+			}
+
+			XrSpaceVelocity velocity = {
+				.type = XR_TYPE_SPACE_VELOCITY,
+				.next = nullptr,
+				.velocityFlags = record.velocity_flags,
+				.linearVelocity = record.linear_velocity,
+				.angularVelocity = record.angular_velocity,
+			};
+			XrSpaceLocation location = {
+				.type = XR_TYPE_SPACE_LOCATION,
+				.next = nullptr,
+				.locationFlags = record.location_flags,
+				.pose = record.pose,
+			};
+			toplevel_paths[index].history.add_sample(xr_api->get_next_frame_time(), location, &velocity);
+
+			return xr_api->transform_from_location(location, p_world_scale, r_transform);
+		}
+
 		if (toplevel_paths[index].space == XR_NULL_HANDLE) {
 			// if this is a pose we need to define spaces
 
@@ -244,15 +403,43 @@ TrackingConfidence Action::get_as_pose(XrPath p_path, float p_world_scale, Trans
 			}
 		}
 
+		// We get our velocities in the same call, they end up in our pose history
+		XrSpaceVelocity velocity = {
+			.type = XR_TYPE_SPACE_VELOCITY,
+			.next = nullptr,
+			.velocityFlags = 0,
+		};
+
 		XrSpaceLocation location;
 
 		location.type = XR_TYPE_SPACE_LOCATION;
-		location.next = nullptr;
+		location.next = &velocity;
 
 		XrTime time = xr_api->get_next_frame_time(); // This data will be used for the next frame we render
-		XrResult result = xrLocateSpace(toplevel_paths[index].space, xr_api->play_space, time, &location);
-		if (!xr_api->xr_result(result, "failed to locate space!")) {
-			return TRACKING_CONFIDENCE_NONE;
+
+		// If we've already located this space for this frame, reuse it
+		const PoseHistory::PoseSample *latest = toplevel_paths[index].history.get_latest();
+		if (latest != nullptr && latest->time == time) {
+			location.locationFlags = latest->flags;
+			location.pose = latest->pose;
+		} else {
+			XrResult result = xrLocateSpace(toplevel_paths[index].space, xr_api->play_space, time, &location);
+			if (!xr_api->xr_result(result, "failed to locate space!")) {
+				return TRACKING_CONFIDENCE_NONE;
+			}
+
+			toplevel_paths[index].history.add_sample(time, location, &velocity);
+
+			if (recorder->is_recording()) {
+				InputRecorder::ActionRecord record = {};
+				record.is_active = 1;
+				record.location_flags = location.locationFlags;
+				record.pose = location.pose;
+				record.velocity_flags = velocity.velocityFlags;
+				record.linear_velocity = velocity.linearVelocity;
+				record.angular_velocity = velocity.angularVelocity;
+				recorder->record_action(recording_key, record);
+			}
 		}
 
 		return xr_api->transform_from_location(location, p_world_scale, r_transform);
@@ -283,6 +470,131 @@ TrackingConfidence Action::get_as_pose(XrPath p_path, float p_world_scale, Trans
 	}
 }
 
+TrackingConfidence Action::get_pose_at_time(const XrPath p_path, XrTime p_time, float p_world_scale, Transform &r_transform) const {
+	if (type != XR_ACTION_TYPE_POSE_INPUT) {
+		// wrong type
+		return TRACKING_CONFIDENCE_NONE;
+	}
+
+	int64_t index = find_path_index(p_path);
+	if (index == -1) {
+		return TRACKING_CONFIDENCE_NONE;
+	}
+
+	// Note, we only look at our history here, we never call into the runtime
+	XrSpaceLocation location = {
+		.type = XR_TYPE_SPACE_LOCATION,
+		.next = nullptr,
+		.locationFlags = 0,
+	};
+	if (!toplevel_paths[index].history.get_location_at_time(p_time, location)) {
+		return TRACKING_CONFIDENCE_NONE;
+	}
+
+	return xr_api->transform_from_location(location, p_world_scale, r_transform);
+}
+
+bool Action::get_velocity(const XrPath p_path, float p_world_scale, Vector3 &r_linear_velocity, Vector3 &r_angular_velocity) const {
+	if (type != XR_ACTION_TYPE_POSE_INPUT) {
+		// wrong type
+		return false;
+	}
+
+	int64_t index = find_path_index(p_path);
+	if (index == -1) {
+		return false;
+	}
+
+	// Our velocities were obtained when we last located our pose in get_as_pose
+	const PoseHistory::PoseSample *latest = toplevel_paths[index].history.get_latest();
+	if (latest == nullptr || latest->velocity_flags == 0) {
+		return false;
+	}
+
+	if (latest->velocity_flags & XR_SPACE_VELOCITY_LINEAR_VALID_BIT) {
+		const XrVector3f &v = latest->linear_velocity;
+		r_linear_velocity = Vector3(v.x, v.y, v.z) * p_world_scale;
+	} else {
+		r_linear_velocity = Vector3();
+	}
+
+	if (latest->velocity_flags & XR_SPACE_VELOCITY_ANGULAR_VALID_BIT) {
+		// radians per second, not affected by world scale
+		const XrVector3f &v = latest->angular_velocity;
+		r_angular_velocity = Vector3(v.x, v.y, v.z);
+	} else {
+		r_angular_velocity = Vector3();
+	}
+
+	return true;
+}
+
+uint32_t Action::get_max_change_count() const {
+	if (type != XR_ACTION_TYPE_BOOLEAN_INPUT && type != XR_ACTION_TYPE_FLOAT_INPUT && type != XR_ACTION_TYPE_VECTOR2F_INPUT) {
+		// we only report input values
+		return 0;
+	}
+
+	return (uint32_t)toplevel_paths.size();
+}
+
+void Action::collect_changes(Array &r_changes, uint32_t &r_change_count) {
+	if (type != XR_ACTION_TYPE_BOOLEAN_INPUT && type != XR_ACTION_TYPE_FLOAT_INPUT && type != XR_ACTION_TYPE_VECTOR2F_INPUT) {
+		// we only report input values
+		return;
+	}
+
+	for (path_with_space &tlp : toplevel_paths) {
+		float value[2] = { 0.0, 0.0 };
+		Variant variant_value;
+
+		switch (type) {
+			case XR_ACTION_TYPE_BOOLEAN_INPUT: {
+				bool pressed = get_as_bool(tlp.toplevel_path);
+				value[0] = pressed ? 1.0 : 0.0;
+				variant_value = pressed;
+			} break;
+			case XR_ACTION_TYPE_FLOAT_INPUT: {
+				value[0] = get_as_float(tlp.toplevel_path);
+				variant_value = value[0];
+			} break;
+			default: {
+				Vector2 v = get_as_vector(tlp.toplevel_path);
+				value[0] = v.x;
+				value[1] = v.y;
+				variant_value = v;
+			} break;
+		}
+
+		if (!analog_value_changed(value[0], tlp.last_value[0]) && !analog_value_changed(value[1], tlp.last_value[1])) {
+			// no change worth reporting
+			continue;
+		}
+		const bool was_pressed = tlp.last_value[0] > 0.0;
+		tlp.last_value[0] = value[0];
+		tlp.last_value[1] = value[1];
+
+		if (r_change_count >= (uint32_t)r_changes.size()) {
+			// our caller sizes r_changes using get_max_change_count
+			continue;
+		}
+		tlp.change[change_value_key] = variant_value;
+		r_changes[r_change_count++] = tlp.change;
+
+		// If the project has an input action with the same name we also send an input event when it's pressed or released,
+		// the analog value is reported through our changes.
+		const bool pressed = value[0] > 0.0;
+		if (type != XR_ACTION_TYPE_VECTOR2F_INPUT && pressed != was_pressed && InputMap::get_singleton()->has_action(full_name)) {
+			Ref<InputEventAction> event;
+			event.instance();
+			event->set_action(full_name);
+			event->set_pressed(pressed);
+			event->set_strength(value[0]);
+			Input::get_singleton()->parse_input_event(event);
+		}
+	}
+}
+
 void Action::do_haptic_pulse(const XrPath p_path, XrDuration p_duration, float p_frequency, float p_amplitude) {
 	if (!xr_api->is_running()) {
 		// not running
@@ -312,3 +624,26 @@ void Action::do_haptic_pulse(const XrPath p_path, XrDuration p_duration, float p
 		xr_api->xr_result(res, "Applying haptic pulse");
 	}
 }
+
+void Action::stop_haptic_feedback(const XrPath p_path) {
+	if (!xr_api->is_running()) {
+		// not running
+		return;
+	} else if (handle == XR_NULL_HANDLE || p_path == XR_NULL_PATH) {
+		// not initialised or setup fully
+		return;
+	} else if (type != XR_ACTION_TYPE_VIBRATION_OUTPUT) {
+		// wrong type
+		return;
+	} else {
+		XrHapticActionInfo action_info = {
+			.type = XR_TYPE_HAPTIC_ACTION_INFO,
+			.next = nullptr,
+			.action = handle,
+			.subactionPath = p_path,
+		};
+
+		XrResult res = xrStopHapticFeedback(xr_api->get_session(), &action_info);
+		xr_api->xr_result(res, "Stopping haptic feedback");
+	}
+}
@@ -13,20 +13,32 @@ private:
 	OpenXRApi *xr_api;
 	XrActionType type = XR_ACTION_TYPE_BOOLEAN_INPUT;
 	godot::String name;
+	godot::String action_set_name;
+	godot::String full_name; // action_set/action as reported in collect_changes
+	godot::Variant change_value_key; // cached so updating our changes doesn't create a new string
 
 	struct path_with_space {
 		XrPath toplevel_path;
 		XrSpace space;
 		bool wasLocationvalid;
+		PoseHistory history;
+		uint32_t recording_keys[2]; // state and location keys for our input recorder
+		uint32_t recording_generation;
+		godot::String path_name;
+		float last_value[2]; // last value we reported in collect_changes
+		godot::Dictionary change; // reused for every change we report for this path
 	};
 
+	int64_t find_path_index(const XrPath p_path) const;
+	uint32_t get_recording_key(const XrPath p_path, bool p_location = false);
+
 	std::vector<path_with_space> toplevel_paths;
 
 	// OpenXR
 	XrAction handle = XR_NULL_HANDLE;
 
 public:
-	Action(OpenXRApi *p_api, XrActionSet p_action_set, XrActionType p_type, const godot::String &p_name, const godot::String &p_localised_name, int p_toplevel_path_count, const XrPath *p_toplevel_paths);
+	Action(OpenXRApi *p_api, XrActionSet p_action_set, const godot::String &p_action_set_name, XrActionType p_type, const godot::String &p_name, const godot::String &p_localised_name, int p_toplevel_path_count, const XrPath *p_toplevel_paths);
 	~Action();
 
 	void reset_spaces();
@@ -35,12 +47,23 @@ public:
 	godot::String get_name() const;
 
 	XrAction get_action() const;
+	uint32_t get_toplevel_path_count() const;
+	XrPath get_toplevel_path(uint32_t p_index) const;
+	bool has_toplevel_path(const XrPath p_path) const;
 	bool get_as_bool(const XrPath p_path);
 	float get_as_float(const XrPath p_path);
 	godot::Vector2 get_as_vector(const XrPath p_path);
 	bool is_pose_active(const XrPath p_path);
 	TrackingConfidence get_as_pose(const XrPath p_path, float p_world_scale, godot::Transform &r_transform);
+	TrackingConfidence get_pose_at_time(const XrPath p_path, XrTime p_time, float p_world_scale, godot::Transform &r_transform) const;
+	bool get_velocity(const XrPath p_path, float p_world_scale, godot::Vector3 &r_linear_velocity, godot::Vector3 &r_angular_velocity) const;
+	// Number of entries collect_changes can report, one for each top level path of an input action
+	uint32_t get_max_change_count() const;
+	// Sets r_changes[r_change_count++] for every top level path where our value changed since we last reported it.
+	// Analog values must change by at least ANALOG_CHANGE_EPSILON. Our dictionaries are reused for every change.
+	void collect_changes(godot::Array &r_changes, uint32_t &r_change_count);
 	void do_haptic_pulse(const XrPath p_path, XrDuration p_duration, float p_frequency, float p_amplitude);
+	void stop_haptic_feedback(const XrPath p_path);
 };
 
 #endif /* !OPENXR_ACTION_H */
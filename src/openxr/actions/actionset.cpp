@@ -42,7 +42,17 @@ bool ActionSet::is_active() const {
 }
 
 void ActionSet::set_active(bool p_is_active) {
-	active = p_is_active;
+	if (active != p_is_active) {
+		active = p_is_active;
+		xr_api->active_action_sets_dirty = true;
+	}
+}
+
+void ActionSet::set_subaction_paths(const std::vector<XrPath> &p_subaction_paths) {
+	if (subaction_paths != p_subaction_paths) {
+		subaction_paths = p_subaction_paths;
+		xr_api->active_action_sets_dirty = true;
+	}
 }
 
 godot::String ActionSet::get_name() const {
@@ -62,7 +72,7 @@ Action *ActionSet::add_action(XrActionType p_type, const godot::String &p_name,
 		}
 	}
 
-	Action *new_action = new Action(xr_api, handle, p_type, p_name, p_localised_name, p_toplevel_path_count, p_toplevel_paths);
+	Action *new_action = new Action(xr_api, handle, name, p_type, p_name, p_localised_name, p_toplevel_path_count, p_toplevel_paths);
 	actions.push_back(new_action);
 
 	return new_action;
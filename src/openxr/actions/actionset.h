@@ -13,6 +13,7 @@ class ActionSet {
 private:
 	bool active = true;
 	bool is_attached = false;
+	std::vector<XrPath> subaction_paths; // only sync for these top level paths, empty means all paths
 	OpenXRApi *xr_api;
 	godot::String name;
 
@@ -29,10 +30,14 @@ public:
 	bool is_active() const;
 	void set_active(bool p_is_active);
 
+	const std::vector<XrPath> &get_subaction_paths() const { return subaction_paths; }
+	void set_subaction_paths(const std::vector<XrPath> &p_subaction_paths);
+
 	godot::String get_name() const;
 
 	Action *add_action(XrActionType p_type, const godot::String &p_name, const godot::String &p_localised_name, int p_toplevel_path_count, const XrPath *p_toplevel_paths);
 	Action *get_action(const godot::String &p_name);
+	const std::vector<Action *> &get_actions() const { return actions; }
 
 	XrActionSet get_action_set();
 	bool attach();
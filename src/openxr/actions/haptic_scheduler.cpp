@@ -0,0 +1,177 @@
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Class for scheduling haptic effects
+
+#include "openxr/OpenXRApi.h"
+
+#include <cmath>
+
+HapticScheduler::HapticScheduler(OpenXRApi *p_api) {
+	xr_api = p_api;
+}
+
+void HapticScheduler::clear() {
+	// our actions are about to be destroyed, the runtime stops any vibration when they are
+	channels.clear();
+}
+
+HapticScheduler::Channel *HapticScheduler::find_channel(Action *p_action, XrPath p_path, bool p_create) {
+	for (Channel &channel : channels) {
+		if (channel.action == p_action && channel.path == p_path) {
+			return &channel;
+		}
+	}
+
+	if (!p_create) {
+		return nullptr;
+	}
+
+	Channel channel;
+	channel.action = p_action;
+	channel.path = p_path;
+	channels.push_back(channel);
+
+	return &channels.back();
+}
+
+void HapticScheduler::submit(Action *p_action, XrPath p_path, const HapticSegment *p_segments, uint32_t p_count, bool p_replace) {
+	if (p_action == nullptr || p_path == XR_NULL_PATH) {
+		return;
+	}
+
+	Channel *channel = find_channel(p_action, p_path, true);
+
+	if (p_replace || channel->current >= channel->segments.size()) {
+		// start fresh, note that we keep vibrating until process() decides otherwise
+		channel->segments.clear();
+		channel->current = 0;
+		channel->segment_started = false;
+	}
+
+	channel->segments.insert(channel->segments.end(), p_segments, p_segments + p_count);
+}
+
+void HapticScheduler::stop(Action *p_action, XrPath p_path) {
+	Channel *channel = find_channel(p_action, p_path, false);
+	if (channel == nullptr) {
+		return;
+	}
+
+	channel->segments.clear();
+	channel->current = 0;
+	channel->segment_started = false;
+	channel->sustained_amplitude = 0.0;
+
+	if (channel->vibrating) {
+		stop_vibrating(*channel);
+	}
+}
+
+bool HapticScheduler::is_playing(Action *p_action, XrPath p_path) const {
+	for (const Channel &channel : channels) {
+		if (channel.action == p_action && channel.path == p_path) {
+			return channel.current < channel.segments.size();
+		}
+	}
+
+	return false;
+}
+
+void HapticScheduler::set_sustained_amplitude(Action *p_action, XrPath p_path, float p_amplitude) {
+	// don't create channels just to tell them there is nothing to do
+	Channel *channel = find_channel(p_action, p_path, p_amplitude > 0.0);
+	if (channel != nullptr) {
+		channel->sustained_amplitude = p_amplitude;
+	}
+}
+
+void HapticScheduler::apply(Channel &p_channel, int64_t p_now, XrDuration p_duration, float p_frequency, float p_amplitude) {
+	p_channel.action->do_haptic_pulse(p_channel.path, p_duration, p_frequency, p_amplitude);
+
+	p_channel.vibrating = true;
+	p_channel.applied_frequency = p_frequency;
+	p_channel.applied_amplitude = p_amplitude;
+	p_channel.applied_until = p_now + p_duration;
+}
+
+void HapticScheduler::stop_vibrating(Channel &p_channel) {
+	p_channel.action->stop_haptic_feedback(p_channel.path);
+
+	p_channel.vibrating = false;
+	p_channel.applied_amplitude = 0.0;
+}
+
+void HapticScheduler::process() {
+	if (channels.empty()) {
+		return;
+	}
+
+	const int64_t now = get_time_ns();
+
+	for (Channel &channel : channels) {
+		bool want_vibration = false;
+
+		// play our queued segments
+		while (channel.current < channel.segments.size()) {
+			const HapticSegment &segment = channel.segments[channel.current];
+			if (!channel.segment_started) {
+				channel.segment_start = now;
+				channel.segment_started = true;
+			}
+
+			const int64_t elapsed = now - channel.segment_start;
+			if (elapsed >= segment.duration) {
+				// on to our next segment, which started when this one ended
+				channel.segment_start += segment.duration;
+				channel.current++;
+				continue;
+			}
+
+			const float t = float(elapsed) / float(segment.duration);
+			const float amplitude = segment.amplitude + (segment.amplitude_end - segment.amplitude) * t;
+			if (amplitude > 0.0) {
+				want_vibration = true;
+
+				// Only call into the runtime if what we want changed or our last pulse has run out
+				if (!channel.vibrating || now >= channel.applied_until || channel.applied_frequency != segment.frequency || fabs(channel.applied_amplitude - amplitude) >= AMPLITUDE_STEP) {
+					XrDuration duration = segment.duration - elapsed;
+
+					// A constant vibration continues into following segments that vibrate the same,
+					// so repeated effects play as one pulse instead of going quiet after the first.
+					if (segment.amplitude == segment.amplitude_end) {
+						for (size_t i = channel.current + 1; i < channel.segments.size(); i++) {
+							const HapticSegment &next = channel.segments[i];
+							if (next.frequency != segment.frequency || next.amplitude != segment.amplitude || next.amplitude_end != segment.amplitude) {
+								break;
+							}
+							duration += next.duration;
+						}
+					}
+
+					apply(channel, now, duration, segment.frequency, amplitude);
+				}
+			}
+			break;
+		}
+
+		if (channel.current >= channel.segments.size() && !channel.segments.empty()) {
+			// done, clear keeps our capacity
+			channel.segments.clear();
+			channel.current = 0;
+			channel.segment_started = false;
+		}
+
+		if (!want_vibration && channel.segments.empty() && channel.sustained_amplitude > 0.0) {
+			want_vibration = true;
+
+			// Refresh halfway through so we keep vibrating even at low frame rates
+			if (!channel.vibrating || channel.applied_frequency != XR_FREQUENCY_UNSPECIFIED || fabs(channel.applied_amplitude - channel.sustained_amplitude) >= AMPLITUDE_STEP || now - channel.sustain_applied > SUSTAIN_DURATION / 2) {
+				apply(channel, now, SUSTAIN_DURATION, XR_FREQUENCY_UNSPECIFIED, channel.sustained_amplitude);
+				channel.sustain_applied = now;
+			}
+		}
+
+		if (!want_vibration && channel.vibrating) {
+			stop_vibrating(channel);
+		}
+	}
+}
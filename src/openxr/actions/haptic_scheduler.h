@@ -0,0 +1,82 @@
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Class for scheduling haptic effects
+// Note, included through OpenXRApi.h
+//
+// Haptic effects are queued per action and top level path (a channel) and played back by
+// our scheduler which is updated every frame. We only call into the OpenXR runtime when
+// the vibration we want changes or when the last pulse we applied runs out. A constant vibration
+// is applied once for its full duration, including any following segments that vibrate the same,
+// and we stop vibrating with xrStopHapticFeedback when we run out of effects.
+
+#ifndef OPENXR_HAPTIC_SCHEDULER_H
+#define OPENXR_HAPTIC_SCHEDULER_H
+
+class HapticScheduler {
+public:
+	// One segment of an effect, the amplitude changes linearly from amplitude to amplitude_end.
+	struct HapticSegment {
+		XrDuration duration;
+		float frequency;
+		float amplitude;
+		float amplitude_end;
+	};
+
+	// Don't reapply a changing amplitude until it has changed by at least this much
+	static constexpr float AMPLITUDE_STEP = 0.05f;
+
+	// A sustained vibration is applied for this long and refreshed halfway through
+	static const XrDuration SUSTAIN_DURATION = 1000000000; // 1 second
+
+	HapticScheduler(OpenXRApi *p_api);
+
+	// Remove all our channels, must be called before our actions are destroyed.
+	void clear();
+
+	// Add segments to the queue for this channel, if p_replace is true we replace what is queued.
+	void submit(Action *p_action, XrPath p_path, const HapticSegment *p_segments, uint32_t p_count, bool p_replace);
+
+	// Stop anything playing on this channel.
+	void stop(Action *p_action, XrPath p_path);
+
+	bool is_playing(Action *p_action, XrPath p_path) const;
+
+	// Vibrate with this amplitude until it's set to 0.0, queued effects take precedence.
+	// This is used for Godot's controller rumble.
+	void set_sustained_amplitude(Action *p_action, XrPath p_path, float p_amplitude);
+
+	// Called every frame
+	void process();
+
+private:
+	struct Channel {
+		Action *action;
+		XrPath path;
+
+		std::vector<HapticSegment> segments;
+		size_t current = 0;
+		bool segment_started = false;
+		int64_t segment_start = 0;
+
+		float sustained_amplitude = 0.0;
+		int64_t sustain_applied = 0;
+
+		// what we last asked the runtime for
+		bool vibrating = false;
+		float applied_frequency = 0.0;
+		float applied_amplitude = 0.0;
+		int64_t applied_until = 0; // when the runtime stops the pulse we applied
+	};
+
+	OpenXRApi *xr_api;
+	std::vector<Channel> channels;
+
+	Channel *find_channel(Action *p_action, XrPath p_path, bool p_create);
+	void apply(Channel &p_channel, int64_t p_now, XrDuration p_duration, float p_frequency, float p_amplitude);
+	void stop_vibrating(Channel &p_channel);
+
+	static int64_t get_time_ns() {
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+};
+
+#endif /* !OPENXR_HAPTIC_SCHEDULER_H */
@@ -0,0 +1,177 @@
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Class for keeping a short history of located poses
+
+#include "openxr/OpenXRApi.h"
+
+#include <cmath>
+
+void PoseHistory::clear() {
+	count = 0;
+	newest = 0;
+}
+
+void PoseHistory::add_sample(XrTime p_time, const XrSpaceLocation &p_location, const XrSpaceVelocity *p_velocity) {
+	if (count > 0 && p_time <= get_sample(0).time) {
+		// we already have this one
+		return;
+	}
+
+	newest = count == 0 ? 0 : (newest + 1) % MAX_SAMPLES;
+	if (count < MAX_SAMPLES) {
+		count++;
+	}
+
+	PoseSample &sample = samples[newest];
+	sample.time = p_time;
+	sample.flags = p_location.locationFlags;
+	sample.pose = p_location.pose;
+	if (p_velocity != nullptr) {
+		sample.velocity_flags = p_velocity->velocityFlags;
+		sample.linear_velocity = p_velocity->linearVelocity;
+		sample.angular_velocity = p_velocity->angularVelocity;
+	} else {
+		sample.velocity_flags = 0;
+		sample.linear_velocity = { 0.0, 0.0, 0.0 };
+		sample.angular_velocity = { 0.0, 0.0, 0.0 };
+	}
+}
+
+const PoseHistory::PoseSample *PoseHistory::get_latest() const {
+	if (count == 0) {
+		return nullptr;
+	}
+
+	return &get_sample(0);
+}
+
+void PoseHistory::blend(const PoseSample &p_from, const PoseSample &p_to, XrTime p_time, XrPosef &r_pose) {
+	// note, t can be larger then 1.0 when we're extrapolating
+	const double t = double(p_time - p_from.time) / double(p_to.time - p_from.time);
+
+	const XrVector3f &from_pos = p_from.pose.position;
+	const XrVector3f &to_pos = p_to.pose.position;
+	r_pose.position.x = from_pos.x + (to_pos.x - from_pos.x) * t;
+	r_pose.position.y = from_pos.y + (to_pos.y - from_pos.y) * t;
+	r_pose.position.z = from_pos.z + (to_pos.z - from_pos.z) * t;
+
+	// slerp our orientation, taking the shortest path
+	XrQuaternionf from = p_from.pose.orientation;
+	const XrQuaternionf &to = p_to.pose.orientation;
+	double cosom = from.x * to.x + from.y * to.y + from.z * to.z + from.w * to.w;
+	if (cosom < 0.0) {
+		cosom = -cosom;
+		from.x = -from.x;
+		from.y = -from.y;
+		from.z = -from.z;
+		from.w = -from.w;
+	}
+
+	double scale0, scale1;
+	if (cosom < 0.9999) {
+		const double omega = acos(cosom);
+		const double sinom = sin(omega);
+		scale0 = sin((1.0 - t) * omega) / sinom;
+		scale1 = sin(t * omega) / sinom;
+	} else {
+		// nearly identical orientations, lerp and normalise below
+		scale0 = 1.0 - t;
+		scale1 = t;
+	}
+
+	XrQuaternionf &q = r_pose.orientation;
+	q.x = scale0 * from.x + scale1 * to.x;
+	q.y = scale0 * from.y + scale1 * to.y;
+	q.z = scale0 * from.z + scale1 * to.z;
+	q.w = scale0 * from.w + scale1 * to.w;
+
+	const double length = sqrt(q.x * q.x + q.y * q.y + q.z * q.z + q.w * q.w);
+	if (length > 0.0) {
+		q.x /= length;
+		q.y /= length;
+		q.z /= length;
+		q.w /= length;
+	}
+}
+
+void PoseHistory::extrapolate(const PoseSample &p_sample, XrTime p_time, XrPosef &r_pose) {
+	const double dt = double(p_time - p_sample.time) / 1000000000.0;
+
+	r_pose = p_sample.pose;
+
+	if (p_sample.velocity_flags & XR_SPACE_VELOCITY_LINEAR_VALID_BIT) {
+		r_pose.position.x += p_sample.linear_velocity.x * dt;
+		r_pose.position.y += p_sample.linear_velocity.y * dt;
+		r_pose.position.z += p_sample.linear_velocity.z * dt;
+	}
+
+	if (p_sample.velocity_flags & XR_SPACE_VELOCITY_ANGULAR_VALID_BIT) {
+		// angular velocity is an axis scaled by radians per second in our base space,
+		// so we rotate our orientation by that axis and angle
+		const XrVector3f &av = p_sample.angular_velocity;
+		const double speed = sqrt(av.x * av.x + av.y * av.y + av.z * av.z);
+		if (speed > 0.0) {
+			const double half_angle = 0.5 * speed * dt;
+			const double s = sin(half_angle) / speed;
+			const double dx = av.x * s;
+			const double dy = av.y * s;
+			const double dz = av.z * s;
+			const double dw = cos(half_angle);
+
+			const XrQuaternionf &q = p_sample.pose.orientation;
+			r_pose.orientation.x = dw * q.x + dx * q.w + dy * q.z - dz * q.y;
+			r_pose.orientation.y = dw * q.y - dx * q.z + dy * q.w + dz * q.x;
+			r_pose.orientation.z = dw * q.z + dx * q.y - dy * q.x + dz * q.w;
+			r_pose.orientation.w = dw * q.w - dx * q.x - dy * q.y - dz * q.z;
+		}
+	}
+}
+
+bool PoseHistory::get_location_at_time(XrTime p_time, XrSpaceLocation &r_location) const {
+	if (count == 0) {
+		return false;
+	}
+
+	const PoseSample &latest = get_sample(0);
+	if (p_time == latest.time) {
+		r_location.locationFlags = latest.flags;
+		r_location.pose = latest.pose;
+		return true;
+	} else if (p_time > latest.time) {
+		if (p_time - latest.time > MAX_EXTRAPOLATION) {
+			// too far into the future
+			return false;
+		}
+
+		// we're predicting so this is no longer tracked data
+		const XrSpaceLocationFlags predicted_mask = ~(XR_SPACE_LOCATION_ORIENTATION_TRACKED_BIT | XR_SPACE_LOCATION_POSITION_TRACKED_BIT);
+		const XrSpaceVelocityFlags both_valid = XR_SPACE_VELOCITY_LINEAR_VALID_BIT | XR_SPACE_VELOCITY_ANGULAR_VALID_BIT;
+		if ((latest.velocity_flags & both_valid) == both_valid) {
+			// the runtime knows better then our finite differences
+			extrapolate(latest, p_time, r_location.pose);
+			r_location.locationFlags = latest.flags & predicted_mask;
+		} else if (count == 1) {
+			r_location.pose = latest.pose;
+			r_location.locationFlags = latest.flags & predicted_mask;
+		} else {
+			const PoseSample &previous = get_sample(1);
+			blend(previous, latest, p_time, r_location.pose);
+			r_location.locationFlags = previous.flags & latest.flags & predicted_mask;
+		}
+
+		return true;
+	}
+
+	// find the two samples surrounding our time
+	for (uint32_t age = 1; age < count; age++) {
+		const PoseSample &from = get_sample(age);
+		if (from.time <= p_time) {
+			const PoseSample &to = get_sample(age - 1);
+			blend(from, to, p_time, r_location.pose);
+			r_location.locationFlags = from.flags & to.flags;
+			return true;
+		}
+	}
+
+	// older then our history
+	return false;
+}
@@ -0,0 +1,56 @@
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Class for keeping a short history of located poses
+// Note, included through OpenXRApi.h
+//
+// Every time we locate a space we record the result keyed by the time we located it for.
+// This lets us look up poses at other times without calling into the runtime again.
+
+#ifndef OPENXR_POSE_HISTORY_H
+#define OPENXR_POSE_HISTORY_H
+
+class PoseHistory {
+public:
+	// Roughly a third of a second at 90Hz
+	static const uint32_t MAX_SAMPLES = 32;
+
+	// How far past our latest sample we're willing to predict
+	static const XrDuration MAX_EXTRAPOLATION = 50000000; // 50ms
+
+	struct PoseSample {
+		XrTime time;
+		XrSpaceLocationFlags flags;
+		XrPosef pose;
+		XrSpaceVelocityFlags velocity_flags; // 0 if the runtime didn't give us velocities
+		XrVector3f linear_velocity;
+		XrVector3f angular_velocity;
+	};
+
+	void clear();
+
+	// Samples should be added in chronological order, older or duplicate samples are ignored.
+	// If p_velocity is set its velocities are stored with the sample.
+	void add_sample(XrTime p_time, const XrSpaceLocation &p_location, const XrSpaceVelocity *p_velocity = nullptr);
+
+	// Returns our most recent sample or nullptr if we don't have any.
+	const PoseSample *get_latest() const;
+
+	// Interpolates between our samples or extrapolates from our latest samples,
+	// using the runtimes velocities for our latest sample when we have them.
+	// Extrapolated locations lose their tracked bits so they are reported with low confidence.
+	bool get_location_at_time(XrTime p_time, XrSpaceLocation &r_location) const;
+
+private:
+	PoseSample samples[MAX_SAMPLES];
+	uint32_t count = 0;
+	uint32_t newest = 0;
+
+	// 0 is our newest sample, count - 1 our oldest
+	const PoseSample &get_sample(uint32_t p_age) const {
+		return samples[(newest + MAX_SAMPLES - p_age) % MAX_SAMPLES];
+	}
+
+	static void blend(const PoseSample &p_from, const PoseSample &p_to, XrTime p_time, XrPosef &r_pose);
+	static void extrapolate(const PoseSample &p_sample, XrTime p_time, XrPosef &r_pose);
+};
+
+#endif /* !OPENXR_POSE_HISTORY_H */
@@ -0,0 +1,214 @@
+#include "openxr/allocation_tracker.h"
+
+#ifdef OPENXR_TRACK_ALLOCATIONS
+#include <Godot.hpp>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+static std::atomic<uint64_t> allocation_count(0);
+
+// Number of Scopes active on this thread
+static thread_local uint32_t scope_depth = 0;
+
+static inline void count_allocation() {
+	if (scope_depth > 0) {
+		allocation_count++;
+	}
+}
+
+// Godot allocates inside of the engine so we can't see those allocations through operator new.
+// Instead we give godot-cpp a copy of the core API where the functions that allocate are replaced
+// by hooks that count the call and then call the original function.
+static const godot_gdnative_core_api_struct *original_api = nullptr;
+static godot_gdnative_core_api_struct counting_api;
+
+template <typename T, T godot_gdnative_core_api_struct::*p_member, typename R, typename... Args>
+static R counting_hook(Args... p_args) {
+	count_allocation();
+
+	return (original_api->*p_member)(p_args...);
+}
+
+template <typename T, T godot_gdnative_core_api_struct::*p_member, typename R, typename... Args>
+static void install_counting_hook(R (*&r_function)(Args...)) {
+	r_function = &counting_hook<T, p_member, R, Args...>;
+}
+
+#define COUNT_GODOT_ALLOCATIONS(m_function) \
+	install_counting_hook<decltype(godot_gdnative_core_api_struct::m_function), &godot_gdnative_core_api_struct::m_function>(counting_api.m_function)
+
+// Dictionaries only allocate when we add a key, we reuse dictionaries by setting existing keys
+static void counting_dictionary_set(godot_dictionary *p_self, const godot_variant *p_key, const godot_variant *p_value) {
+	if (!original_api->godot_dictionary_has(p_self, p_key)) {
+		count_allocation();
+	}
+
+	original_api->godot_dictionary_set(p_self, p_key, p_value);
+}
+
+static godot_variant *counting_dictionary_operator_index(godot_dictionary *p_self, const godot_variant *p_key) {
+	if (!original_api->godot_dictionary_has(p_self, p_key)) {
+		count_allocation();
+	}
+
+	return original_api->godot_dictionary_operator_index(p_self, p_key);
+}
+
+void *operator new(std::size_t p_size) {
+	count_allocation();
+
+	void *ptr = malloc(p_size > 0 ? p_size : 1);
+	if (ptr == nullptr) {
+		throw std::bad_alloc();
+	}
+	return ptr;
+}
+
+void *operator new[](std::size_t p_size) {
+	return operator new(p_size);
+}
+
+void *operator new(std::size_t p_size, const std::nothrow_t &) noexcept {
+	count_allocation();
+
+	return malloc(p_size > 0 ? p_size : 1);
+}
+
+void *operator new[](std::size_t p_size, const std::nothrow_t &p_nothrow) noexcept {
+	return operator new(p_size, p_nothrow);
+}
+
+void operator delete(void *p_ptr) noexcept {
+	free(p_ptr);
+}
+
+void operator delete[](void *p_ptr) noexcept {
+	free(p_ptr);
+}
+
+void operator delete(void *p_ptr, const std::nothrow_t &) noexcept {
+	free(p_ptr);
+}
+
+void operator delete[](void *p_ptr, const std::nothrow_t &) noexcept {
+	free(p_ptr);
+}
+
+#ifdef __cpp_sized_deallocation
+void operator delete(void *p_ptr, std::size_t) noexcept {
+	free(p_ptr);
+}
+
+void operator delete[](void *p_ptr, std::size_t) noexcept {
+	free(p_ptr);
+}
+#endif
+
+uint64_t AllocationTracker::get_allocation_count() {
+	return allocation_count.load();
+}
+
+AllocationTracker::Scope::Scope() {
+	scope_depth++;
+}
+
+AllocationTracker::Scope::~Scope() {
+	scope_depth--;
+}
+
+AllocationTracker::Pause::Pause() {
+	depth = scope_depth;
+	scope_depth = 0;
+}
+
+AllocationTracker::Pause::~Pause() {
+	scope_depth = depth;
+}
+
+void AllocationTracker::start_tracking_godot_api() {
+	if (original_api != nullptr || godot::api == nullptr) {
+		return;
+	}
+
+	original_api = godot::api;
+	counting_api = *original_api;
+
+	// raw memory
+	COUNT_GODOT_ALLOCATIONS(godot_alloc);
+	COUNT_GODOT_ALLOCATIONS(godot_realloc);
+
+	// strings, copies only increase a reference count but anything creating new string data allocates
+	COUNT_GODOT_ALLOCATIONS(godot_string_new_with_wide_string);
+	COUNT_GODOT_ALLOCATIONS(godot_string_parse_utf8);
+	COUNT_GODOT_ALLOCATIONS(godot_string_parse_utf8_with_len);
+	COUNT_GODOT_ALLOCATIONS(godot_string_chars_to_utf8);
+	COUNT_GODOT_ALLOCATIONS(godot_string_chars_to_utf8_with_len);
+	COUNT_GODOT_ALLOCATIONS(godot_string_operator_plus);
+	COUNT_GODOT_ALLOCATIONS(godot_string_num);
+	COUNT_GODOT_ALLOCATIONS(godot_string_num_int64);
+	COUNT_GODOT_ALLOCATIONS(godot_string_num_real);
+	COUNT_GODOT_ALLOCATIONS(godot_string_utf8);
+	COUNT_GODOT_ALLOCATIONS(godot_string_ascii);
+	COUNT_GODOT_ALLOCATIONS(godot_string_name_new);
+	COUNT_GODOT_ALLOCATIONS(godot_string_name_new_data);
+	COUNT_GODOT_ALLOCATIONS(godot_node_path_new);
+
+	// containers, a new array or dictionary allocates its shared data, adding entries may grow it
+	COUNT_GODOT_ALLOCATIONS(godot_array_new);
+	COUNT_GODOT_ALLOCATIONS(godot_array_append);
+	COUNT_GODOT_ALLOCATIONS(godot_array_push_back);
+	COUNT_GODOT_ALLOCATIONS(godot_array_insert);
+	COUNT_GODOT_ALLOCATIONS(godot_array_resize);
+	COUNT_GODOT_ALLOCATIONS(godot_dictionary_new);
+	counting_api.godot_dictionary_set = &counting_dictionary_set;
+	counting_api.godot_dictionary_operator_index = &counting_dictionary_operator_index;
+	COUNT_GODOT_ALLOCATIONS(godot_pool_byte_array_push_back);
+	COUNT_GODOT_ALLOCATIONS(godot_pool_byte_array_resize);
+	COUNT_GODOT_ALLOCATIONS(godot_pool_int_array_push_back);
+	COUNT_GODOT_ALLOCATIONS(godot_pool_int_array_resize);
+	COUNT_GODOT_ALLOCATIONS(godot_pool_real_array_push_back);
+	COUNT_GODOT_ALLOCATIONS(godot_pool_real_array_resize);
+	COUNT_GODOT_ALLOCATIONS(godot_pool_vector2_array_push_back);
+	COUNT_GODOT_ALLOCATIONS(godot_pool_vector2_array_resize);
+	COUNT_GODOT_ALLOCATIONS(godot_pool_vector3_array_push_back);
+	COUNT_GODOT_ALLOCATIONS(godot_pool_vector3_array_resize);
+
+	// objects, godot-cpp looks up the constructor every time it creates an object
+	COUNT_GODOT_ALLOCATIONS(godot_get_class_constructor);
+
+	godot::api = &counting_api;
+}
+
+void AllocationTracker::stop_tracking_godot_api() {
+	if (original_api == nullptr) {
+		return;
+	}
+
+	godot::api = original_api;
+	original_api = nullptr;
+}
+#else
+uint64_t AllocationTracker::get_allocation_count() {
+	return 0;
+}
+
+AllocationTracker::Scope::Scope() {
+}
+
+AllocationTracker::Scope::~Scope() {
+}
+
+AllocationTracker::Pause::Pause() :
+		depth(0) {
+}
+
+AllocationTracker::Pause::~Pause() {
+}
+
+void AllocationTracker::start_tracking_godot_api() {
+}
+
+void AllocationTracker::stop_tracking_godot_api() {
+}
+#endif
@@ -0,0 +1,46 @@
+#ifndef ALLOCATION_TRACKER_H
+#define ALLOCATION_TRACKER_H
+
+#include <stdint.h>
+
+// Counts the heap allocations made through operator new by this library, and the calls we make into
+// the Godot API that allocate on our behalf (i.e. creating a godot::String or adding to a godot::Array).
+// This is only compiled in when building with track_allocations=yes (OPENXR_TRACK_ALLOCATIONS),
+// which replaces operator new for our library and routes godot::api through a counting copy.
+//
+// We only count allocations made on the thread that holds a Scope, we use this to bracket our frame loop
+// so calls the application makes into our library (i.e. OpenXRConfig getters) don't count against it.
+class AllocationTracker {
+public:
+	class Scope {
+	public:
+		Scope();
+		~Scope();
+	};
+
+	// Stops counting within a Scope, i.e. while the application handles a signal we emit.
+	class Pause {
+	public:
+		Pause();
+		~Pause();
+
+	private:
+		uint32_t depth;
+	};
+
+	static bool is_enabled() {
+#ifdef OPENXR_TRACK_ALLOCATIONS
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	static uint64_t get_allocation_count();
+
+	// Call right after Godot::gdnative_init and before Godot::gdnative_terminate
+	static void start_tracking_godot_api();
+	static void stop_tracking_godot_api();
+};
+
+#endif // ALLOCATION_TRACKER_H
@@ -7,6 +7,9 @@
 class XRCompositionLayerProvider {
 public:
 	virtual XrCompositionLayerBaseHeader *get_composition_layer() = 0;
+
+	// Our projection layer is at order 0, layers with a negative order are placed behind it.
+	virtual int get_composition_layer_order() { return -1; }
 };
 
 #endif // XR_COMPOSITION_LAYER_PROVIDER_H
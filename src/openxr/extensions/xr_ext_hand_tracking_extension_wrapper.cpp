@@ -1,5 +1,3 @@
-#include <ARVRServer.hpp>
-
 #include "xr_ext_hand_tracking_extension_wrapper.h"
 
 #include "openxr/include/util.h"
@@ -296,6 +294,13 @@ void XRExtHandTrackingExtensionWrapper::update_handtracking() {
 				continue;
 			}
 
+			InputRecorder *recorder = openxr_api->get_input_recorder();
+			if (recorder->is_recording()) {
+				recorder->record_hand(i, hand_trackers[i].locations.isActive, hand_trackers[i].joint_locations, hand_trackers[i].joint_velocities);
+			} else if (recorder->is_replaying()) {
+				recorder->replay_hand(i, hand_trackers[i].locations.isActive, hand_trackers[i].joint_locations, hand_trackers[i].joint_velocities);
+			}
+
 			// For some reason an inactive controller isn't coming back as inactive but has coordinates either as NAN or very large
 			const XrPosef &palm = hand_trackers[i].joint_locations[XR_HAND_JOINT_PALM_EXT].pose;
 			if (
@@ -318,11 +323,11 @@ void XRExtHandTrackingExtensionWrapper::update_handtracking() {
 
 				int controller = hand_trackers[i].aim_state_godot_controller;
 
-				const float ws = ARVRServer::get_singleton()->get_world_scale();
+				// Godot applies world scale to controller positions itself
 				godot_transform controller_transform;
 				auto *t = (Transform *)&controller_transform;
 
-				*t = openxr_api->transform_from_pose(hand_trackers[i].aimState.aimPose, ws);
+				*t = openxr_api->transform_from_pose(hand_trackers[i].aimState.aimPose, 1.0);
 				arvr_api->godot_arvr_set_controller_transform(
 						controller,
 						&controller_transform,
@@ -24,6 +24,10 @@ public:
 
 	virtual void **set_swapchain_create_info_and_get_next_pointer(void **swapchain_create_info) { return nullptr; }
 
+	virtual void **set_projection_view_and_get_next_pointer(uint32_t eye, void **projection_view) { return nullptr; }
+
+	virtual void **set_projection_layer_and_get_next_pointer(void **projection_layer) { return nullptr; }
+
 	virtual void on_session_initialized(const XrSession session) {}
 
 	virtual void on_state_idle() {}
@@ -0,0 +1,80 @@
+#include "xr_fb_composition_layer_settings_extension_wrapper.h"
+
+XRFbCompositionLayerSettingsExtensionWrapper *XRFbCompositionLayerSettingsExtensionWrapper::singleton = nullptr;
+
+XRFbCompositionLayerSettingsExtensionWrapper *XRFbCompositionLayerSettingsExtensionWrapper::get_singleton() {
+	if (!singleton) {
+		singleton = new XRFbCompositionLayerSettingsExtensionWrapper();
+	}
+
+	return singleton;
+}
+
+XRFbCompositionLayerSettingsExtensionWrapper::XRFbCompositionLayerSettingsExtensionWrapper() {
+	openxr_api = OpenXRApi::openxr_get_api();
+	request_extensions[XR_FB_COMPOSITION_LAYER_SETTINGS_EXTENSION_NAME] = &fb_composition_layer_settings_ext;
+}
+
+XRFbCompositionLayerSettingsExtensionWrapper::~XRFbCompositionLayerSettingsExtensionWrapper() {
+	cleanup();
+	OpenXRApi::openxr_release_api();
+}
+
+void XRFbCompositionLayerSettingsExtensionWrapper::cleanup() {
+	fb_composition_layer_settings_ext = false;
+}
+
+void XRFbCompositionLayerSettingsExtensionWrapper::on_instance_destroyed() {
+	cleanup();
+}
+
+void **XRFbCompositionLayerSettingsExtensionWrapper::set_projection_layer_and_get_next_pointer(void **projection_layer) {
+	// No need to add our structure if we're not asking for anything.
+	if (fb_composition_layer_settings_ext && composition_layer_settings.layerFlags != 0) {
+		composition_layer_settings.next = nullptr;
+
+		*projection_layer = &composition_layer_settings;
+		return const_cast<void **>(&composition_layer_settings.next);
+	} else {
+		return nullptr;
+	}
+}
+
+void XRFbCompositionLayerSettingsExtensionWrapper::set_supersampling_mode(FilterMode p_mode) {
+	supersampling_mode = p_mode;
+	update_layer_flags();
+}
+
+void XRFbCompositionLayerSettingsExtensionWrapper::set_sharpening_mode(FilterMode p_mode) {
+	sharpening_mode = p_mode;
+	update_layer_flags();
+}
+
+void XRFbCompositionLayerSettingsExtensionWrapper::update_layer_flags() {
+	XrCompositionLayerSettingsFlagsFB flags = 0;
+
+	switch (supersampling_mode) {
+		case FILTER_MODE_NORMAL: {
+			flags |= XR_COMPOSITION_LAYER_SETTINGS_NORMAL_SUPER_SAMPLING_BIT_FB;
+		} break;
+		case FILTER_MODE_QUALITY: {
+			flags |= XR_COMPOSITION_LAYER_SETTINGS_QUALITY_SUPER_SAMPLING_BIT_FB;
+		} break;
+		default: {
+		} break;
+	}
+
+	switch (sharpening_mode) {
+		case FILTER_MODE_NORMAL: {
+			flags |= XR_COMPOSITION_LAYER_SETTINGS_NORMAL_SHARPENING_BIT_FB;
+		} break;
+		case FILTER_MODE_QUALITY: {
+			flags |= XR_COMPOSITION_LAYER_SETTINGS_QUALITY_SHARPENING_BIT_FB;
+		} break;
+		default: {
+		} break;
+	}
+
+	// Picked up when we submit our next frame.
+	composition_layer_settings.layerFlags = flags;
+}
@@ -0,0 +1,58 @@
+#ifndef XR_FB_COMPOSITION_LAYER_SETTINGS_EXTENSION_WRAPPER_H
+#define XR_FB_COMPOSITION_LAYER_SETTINGS_EXTENSION_WRAPPER_H
+
+#include "openxr/OpenXRApi.h"
+#include "openxr/extensions/xr_extension_wrapper.h"
+#include "openxr/include/openxr_inc.h"
+
+// Wrapper for the XR_FB_composition_layer_settings extension.
+// Lets the compositor apply supersampling and/or sharpening when sampling our eye buffers,
+// this is a cheap way to improve clarity when rendering at a lower render target size.
+class XRFbCompositionLayerSettingsExtensionWrapper : public XRExtensionWrapper {
+public:
+	enum FilterMode {
+		FILTER_MODE_NONE,
+		FILTER_MODE_NORMAL,
+		FILTER_MODE_QUALITY,
+	};
+
+	static XRFbCompositionLayerSettingsExtensionWrapper *get_singleton();
+
+	void **set_projection_layer_and_get_next_pointer(void **projection_layer) override;
+
+	void on_instance_destroyed() override;
+
+	bool is_composition_layer_settings_supported() {
+		return fb_composition_layer_settings_ext;
+	}
+
+	FilterMode get_supersampling_mode() const { return supersampling_mode; }
+	void set_supersampling_mode(FilterMode p_mode);
+
+	FilterMode get_sharpening_mode() const { return sharpening_mode; }
+	void set_sharpening_mode(FilterMode p_mode);
+
+protected:
+	XRFbCompositionLayerSettingsExtensionWrapper();
+	~XRFbCompositionLayerSettingsExtensionWrapper();
+
+private:
+	void update_layer_flags();
+	void cleanup();
+
+	static XRFbCompositionLayerSettingsExtensionWrapper *singleton;
+
+	OpenXRApi *openxr_api = nullptr;
+	bool fb_composition_layer_settings_ext = false;
+
+	FilterMode supersampling_mode = FILTER_MODE_NONE;
+	FilterMode sharpening_mode = FILTER_MODE_NONE;
+
+	XrCompositionLayerSettingsFB composition_layer_settings = {
+		.type = XR_TYPE_COMPOSITION_LAYER_SETTINGS_FB,
+		.next = nullptr,
+		.layerFlags = 0,
+	};
+};
+
+#endif // XR_FB_COMPOSITION_LAYER_SETTINGS_EXTENSION_WRAPPER_H
@@ -0,0 +1,383 @@
+#include "xr_fb_space_warp_extension_wrapper.h"
+#include "xr_fb_display_refresh_rate_extension_wrapper.h"
+
+#include <Engine.hpp>
+
+#include <math.h>
+
+using namespace godot;
+
+XRFbSpaceWarpExtensionWrapper *XRFbSpaceWarpExtensionWrapper::singleton = nullptr;
+
+XRFbSpaceWarpExtensionWrapper *XRFbSpaceWarpExtensionWrapper::get_singleton() {
+	if (!singleton) {
+		singleton = new XRFbSpaceWarpExtensionWrapper();
+	}
+
+	return singleton;
+}
+
+XRFbSpaceWarpExtensionWrapper::XRFbSpaceWarpExtensionWrapper() {
+	openxr_api = OpenXRApi::openxr_get_api();
+	request_extensions[XR_FB_SPACE_WARP_EXTENSION_NAME] = &fb_space_warp_ext;
+}
+
+XRFbSpaceWarpExtensionWrapper::~XRFbSpaceWarpExtensionWrapper() {
+	cleanup();
+	OpenXRApi::openxr_release_api();
+}
+
+void XRFbSpaceWarpExtensionWrapper::cleanup() {
+	cleanup_swapchains();
+	fb_space_warp_ext = false;
+}
+
+void **XRFbSpaceWarpExtensionWrapper::set_system_properties_and_get_next_pointer(void **property) {
+	if (fb_space_warp_ext) {
+		space_warp_properties.type = XR_TYPE_SYSTEM_SPACE_WARP_PROPERTIES_FB;
+		space_warp_properties.next = nullptr;
+		space_warp_properties.recommendedMotionVectorImageRectWidth = 0;
+		space_warp_properties.recommendedMotionVectorImageRectHeight = 0;
+
+		*property = &space_warp_properties;
+		return &space_warp_properties.next;
+	} else {
+		return nullptr;
+	}
+}
+
+void XRFbSpaceWarpExtensionWrapper::on_state_ready() {
+	if (fb_space_warp_ext && enabled) {
+		initialise_swapchains();
+	}
+}
+
+void XRFbSpaceWarpExtensionWrapper::on_process_openxr() {
+	if (!fb_space_warp_ext) {
+		return;
+	}
+
+	// We're in between xrWaitFrame and xrBeginFrame so this is a safe place to (re)create our swapchains.
+	if (enabled && motion_vector_swapchains.empty()) {
+		if (!initialise_swapchains()) {
+			enabled = false;
+		}
+	} else if (!enabled && !motion_vector_swapchains.empty()) {
+		cleanup_swapchains();
+	}
+
+	update_target_fps();
+
+	// Normally we acquired the images for this frame when we submitted our last frame,
+	// this catches our first frame and retries if acquiring failed.
+	if (enabled && !frame_acquired) {
+		acquire_images();
+	}
+}
+
+void **XRFbSpaceWarpExtensionWrapper::set_projection_view_and_get_next_pointer(uint32_t eye, void **projection_view) {
+	if (!enabled || !frame_acquired || eye >= space_warp_info.size()) {
+		return nullptr;
+	}
+
+	// The application should have rendered into these by now.
+	release_swapchain(motion_vector_swapchains[eye]);
+	release_swapchain(depth_swapchains[eye]);
+
+	const bool submit_images = images_rendered;
+	if (eye == space_warp_info.size() - 1) {
+		// Godot processes our interface after the application's _process, so we acquire the images
+		// for our next frame now to give the application a chance to render into them.
+		images_rendered = false;
+		acquire_images();
+	}
+
+	if (!submit_images) {
+		// nothing was written to our images, don't let the runtime use them
+		return nullptr;
+	}
+
+	XrCompositionLayerSpaceWarpInfoFB &info = space_warp_info[eye];
+	info.next = nullptr;
+	info.layerFlags = skip_next_frame ? XR_COMPOSITION_LAYER_SPACE_WARP_INFO_FRAME_SKIP_BIT_FB : 0;
+	info.appSpaceDeltaPose = {
+		.orientation = { .x = 0, .y = 0, .z = 0, .w = 1.0 },
+		.position = { .x = 0, .y = 0, .z = 0 }
+	};
+	info.minDepth = 0.0f;
+	info.maxDepth = 1.0f;
+	info.nearZ = openxr_api->get_z_near();
+	info.farZ = openxr_api->get_z_far();
+
+	if (eye == space_warp_info.size() - 1) {
+		skip_next_frame = false;
+	}
+
+	*projection_view = &info;
+	return const_cast<void **>(&info.next);
+}
+
+void XRFbSpaceWarpExtensionWrapper::on_state_stopping() {
+	cleanup_swapchains();
+	update_target_fps();
+}
+
+void XRFbSpaceWarpExtensionWrapper::on_session_destroyed() {
+	cleanup_swapchains();
+	update_target_fps();
+}
+
+void XRFbSpaceWarpExtensionWrapper::on_instance_destroyed() {
+	cleanup();
+}
+
+void XRFbSpaceWarpExtensionWrapper::set_space_warp_enabled(bool p_enabled) {
+	if (p_enabled && !fb_space_warp_ext && openxr_api->is_initialised()) {
+		Godot::print_error("OpenXR space warp is not supported on this device", __FUNCTION__, __FILE__, __LINE__);
+		return;
+	}
+
+	// Our swapchains are created or destroyed at the start of the next frame.
+	enabled = p_enabled;
+}
+
+void XRFbSpaceWarpExtensionWrapper::set_frame_rate_divisor(int p_divisor) {
+	if (p_divisor < 1) {
+		Godot::print_error("OpenXR frame rate divisor must be 1 or higher", __FUNCTION__, __FILE__, __LINE__);
+		return;
+	}
+
+	frame_rate_divisor = p_divisor;
+}
+
+void XRFbSpaceWarpExtensionWrapper::mark_images_rendered() {
+	if (!frame_acquired) {
+		return;
+	}
+
+	images_rendered = true;
+	if (!has_rendered_images) {
+		has_rendered_images = true;
+
+		// Our previous images were never submitted, make sure the runtime doesn't use what it has
+		skip_next_frame = true;
+	}
+}
+
+uint32_t XRFbSpaceWarpExtensionWrapper::get_motion_vector_texture(uint32_t eye) const {
+	if (!frame_acquired || eye >= motion_vector_swapchains.size()) {
+		return 0;
+	}
+
+	const SpaceWarpSwapchain &swapchain = motion_vector_swapchains[eye];
+	return swapchain.acquired ? swapchain.images[swapchain.image_index].image : 0;
+}
+
+uint32_t XRFbSpaceWarpExtensionWrapper::get_depth_texture(uint32_t eye) const {
+	if (!frame_acquired || eye >= depth_swapchains.size()) {
+		return 0;
+	}
+
+	const SpaceWarpSwapchain &swapchain = depth_swapchains[eye];
+	return swapchain.acquired ? swapchain.images[swapchain.image_index].image : 0;
+}
+
+bool XRFbSpaceWarpExtensionWrapper::create_swapchain(int64_t p_format, XrSwapchainUsageFlags p_usage, SpaceWarpSwapchain &r_swapchain) {
+	XrSwapchainCreateInfo swapchain_create_info = {
+		.type = XR_TYPE_SWAPCHAIN_CREATE_INFO,
+		.next = nullptr,
+		.createFlags = 0,
+		.usageFlags = p_usage,
+		.format = p_format,
+		.sampleCount = 1,
+		.width = space_warp_properties.recommendedMotionVectorImageRectWidth,
+		.height = space_warp_properties.recommendedMotionVectorImageRectHeight,
+		.faceCount = 1,
+		.arraySize = 1,
+		.mipCount = 1,
+	};
+
+	XrResult result = xrCreateSwapchain(openxr_api->get_session(), &swapchain_create_info, &r_swapchain.swapchain);
+	if (!openxr_api->xr_result(result, "Failed to create space warp swapchain")) {
+		r_swapchain.swapchain = XR_NULL_HANDLE;
+		return false;
+	}
+
+	uint32_t image_count = 0;
+	result = xrEnumerateSwapchainImages(r_swapchain.swapchain, 0, &image_count, nullptr);
+	if (!openxr_api->xr_result(result, "Failed to get space warp swapchain image count")) {
+		destroy_swapchain(r_swapchain);
+		return false;
+	}
+
+	XrSwapchainImageGL image = {};
+	image.type = XR_TYPE_SWAPCHAIN_IMAGE_GL;
+	image.next = nullptr;
+	r_swapchain.images.assign(image_count, image);
+
+	result = xrEnumerateSwapchainImages(r_swapchain.swapchain, image_count, &image_count, (XrSwapchainImageBaseHeader *)r_swapchain.images.data());
+	if (!openxr_api->xr_result(result, "Failed to enumerate space warp swapchain images")) {
+		destroy_swapchain(r_swapchain);
+		return false;
+	}
+
+	return true;
+}
+
+void XRFbSpaceWarpExtensionWrapper::destroy_swapchain(SpaceWarpSwapchain &p_swapchain) {
+	release_swapchain(p_swapchain);
+
+	if (p_swapchain.swapchain != XR_NULL_HANDLE) {
+		xrDestroySwapchain(p_swapchain.swapchain);
+		p_swapchain.swapchain = XR_NULL_HANDLE;
+	}
+
+	p_swapchain.images.clear();
+}
+
+bool XRFbSpaceWarpExtensionWrapper::acquire_swapchain(SpaceWarpSwapchain &p_swapchain) {
+	if (p_swapchain.acquired) {
+		// acquiring our other images failed last time
+		return true;
+	}
+
+	XrSwapchainImageAcquireInfo acquire_info = {
+		.type = XR_TYPE_SWAPCHAIN_IMAGE_ACQUIRE_INFO,
+		.next = nullptr
+	};
+	XrResult result = xrAcquireSwapchainImage(p_swapchain.swapchain, &acquire_info, &p_swapchain.image_index);
+	if (!openxr_api->xr_result(result, "Failed to acquire space warp swapchain image")) {
+		return false;
+	}
+
+	XrSwapchainImageWaitInfo wait_info = {
+		.type = XR_TYPE_SWAPCHAIN_IMAGE_WAIT_INFO,
+		.next = nullptr,
+		.timeout = 17000000, /* timeout in nanoseconds */
+	};
+	result = xrWaitSwapchainImage(p_swapchain.swapchain, &wait_info);
+	if (!openxr_api->xr_result(result, "Failed to wait for space warp swapchain image")) {
+		return false;
+	}
+
+	p_swapchain.acquired = true;
+	return true;
+}
+
+void XRFbSpaceWarpExtensionWrapper::release_swapchain(SpaceWarpSwapchain &p_swapchain) {
+	if (!p_swapchain.acquired) {
+		return;
+	}
+
+	p_swapchain.acquired = false;
+
+	XrSwapchainImageReleaseInfo release_info = {
+		.type = XR_TYPE_SWAPCHAIN_IMAGE_RELEASE_INFO,
+		.next = nullptr
+	};
+	XrResult result = xrReleaseSwapchainImage(p_swapchain.swapchain, &release_info);
+	openxr_api->xr_result(result, "Failed to release space warp swapchain image");
+}
+
+void XRFbSpaceWarpExtensionWrapper::acquire_images() {
+	frame_acquired = false;
+
+	for (uint32_t i = 0; i < motion_vector_swapchains.size(); i++) {
+		if (!acquire_swapchain(motion_vector_swapchains[i]) || !acquire_swapchain(depth_swapchains[i])) {
+			return;
+		}
+	}
+
+	frame_acquired = true;
+}
+
+bool XRFbSpaceWarpExtensionWrapper::initialise_swapchains() {
+	uint32_t view_count = openxr_api->get_view_count();
+
+	if (space_warp_properties.recommendedMotionVectorImageRectWidth == 0 || space_warp_properties.recommendedMotionVectorImageRectHeight == 0) {
+		Godot::print_error("OpenXR runtime did not report a motion vector image size", __FUNCTION__, __FILE__, __LINE__);
+		return false;
+	}
+
+	motion_vector_swapchains.resize(view_count);
+	depth_swapchains.resize(view_count);
+	space_warp_info.resize(view_count);
+
+	for (uint32_t i = 0; i < view_count; i++) {
+		if (!create_swapchain(GL_RGBA16F, XR_SWAPCHAIN_USAGE_SAMPLED_BIT | XR_SWAPCHAIN_USAGE_COLOR_ATTACHMENT_BIT, motion_vector_swapchains[i])) {
+			cleanup_swapchains();
+			return false;
+		}
+
+		if (!create_swapchain(GL_DEPTH24_STENCIL8, XR_SWAPCHAIN_USAGE_SAMPLED_BIT | XR_SWAPCHAIN_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT, depth_swapchains[i])) {
+			cleanup_swapchains();
+			return false;
+		}
+
+		XrSwapchainSubImage sub_image = {
+			.swapchain = XR_NULL_HANDLE,
+			.imageRect = {
+					.offset = { .x = 0, .y = 0 },
+					.extent = {
+							.width = (int32_t)space_warp_properties.recommendedMotionVectorImageRectWidth,
+							.height = (int32_t)space_warp_properties.recommendedMotionVectorImageRectHeight,
+					},
+			},
+			.imageArrayIndex = 0,
+		};
+
+		space_warp_info[i].type = XR_TYPE_COMPOSITION_LAYER_SPACE_WARP_INFO_FB;
+		space_warp_info[i].next = nullptr;
+		space_warp_info[i].motionVectorSubImage = sub_image;
+		space_warp_info[i].motionVectorSubImage.swapchain = motion_vector_swapchains[i].swapchain;
+		space_warp_info[i].depthSubImage = sub_image;
+		space_warp_info[i].depthSubImage.swapchain = depth_swapchains[i].swapchain;
+	}
+
+	// Motion vectors from before we (re)started are meaningless.
+	skip_next_frame = true;
+
+	return true;
+}
+
+void XRFbSpaceWarpExtensionWrapper::cleanup_swapchains() {
+	for (uint32_t i = 0; i < motion_vector_swapchains.size(); i++) {
+		destroy_swapchain(motion_vector_swapchains[i]);
+	}
+	for (uint32_t i = 0; i < depth_swapchains.size(); i++) {
+		destroy_swapchain(depth_swapchains[i]);
+	}
+
+	motion_vector_swapchains.clear();
+	depth_swapchains.clear();
+	space_warp_info.clear();
+	frame_acquired = false;
+	images_rendered = false;
+	has_rendered_images = false;
+}
+
+void XRFbSpaceWarpExtensionWrapper::update_target_fps() {
+	// With space warp enabled the runtime synthesizes the frames we skip.
+	// We cap Godot's frame rate to a division of the display refresh rate to make this predictable.
+	int target_fps = 0;
+	if (enabled && has_rendered_images && frame_rate_divisor > 1) {
+		XRFbDisplayRefreshRateExtensionWrapper *refresh_rate_wrapper = XRFbDisplayRefreshRateExtensionWrapper::get_singleton();
+		double refresh_rate = refresh_rate_wrapper != nullptr ? refresh_rate_wrapper->get_refresh_rate() : 0.0;
+		if (refresh_rate > 0.0) {
+			target_fps = (int)round(refresh_rate / frame_rate_divisor);
+		}
+	}
+
+	if (target_fps == applied_target_fps) {
+		return;
+	}
+
+	Engine *engine = Engine::get_singleton();
+	if (applied_target_fps == 0) {
+		// remember what the application had set so we can restore it
+		original_target_fps = engine->get_target_fps();
+	}
+
+	engine->set_target_fps(target_fps != 0 ? target_fps : original_target_fps);
+	applied_target_fps = target_fps;
+}
@@ -0,0 +1,101 @@
+#ifndef XR_FB_SPACE_WARP_EXTENSION_WRAPPER_H
+#define XR_FB_SPACE_WARP_EXTENSION_WRAPPER_H
+
+#include "openxr/OpenXRApi.h"
+#include "openxr/extensions/xr_extension_wrapper.h"
+#include "openxr/include/openxr_inc.h"
+
+#include <vector>
+
+// Wrapper for the XR_FB_space_warp extension.
+// When enabled we create a motion vector and depth swapchain for each view and add these to our projection views,
+// the runtime uses them to synthesize frames when we render at a reduced frame rate.
+// Note that Godot does not output motion vectors, these images need to be rendered to by the application,
+// the textures for the next frame we submit can be obtained through get_motion_vector_texture and get_depth_texture.
+// These are acquired when we submit a frame so they are available from _process.
+// We only hand them to the runtime for frames where the application calls mark_images_rendered, and we only
+// reduce our frame rate once it has done so, otherwise the runtime would synthesize frames from garbage.
+class XRFbSpaceWarpExtensionWrapper : public XRExtensionWrapper {
+public:
+	static XRFbSpaceWarpExtensionWrapper *get_singleton();
+
+	void **set_system_properties_and_get_next_pointer(void **property) override;
+
+	void on_state_ready() override;
+
+	void on_process_openxr() override;
+
+	void **set_projection_view_and_get_next_pointer(uint32_t eye, void **projection_view) override;
+
+	void on_state_stopping() override;
+
+	void on_session_destroyed() override;
+
+	void on_instance_destroyed() override;
+
+	bool is_space_warp_supported() {
+		return fb_space_warp_ext;
+	}
+
+	bool is_space_warp_enabled() const { return enabled; }
+	void set_space_warp_enabled(bool p_enabled);
+
+	int get_frame_rate_divisor() const { return frame_rate_divisor; }
+	void set_frame_rate_divisor(int p_divisor);
+
+	// Tell the runtime not to use our motion vectors for the next frame, i.e. after teleporting.
+	void skip_frame() { skip_next_frame = true; }
+
+	uint32_t get_motion_vector_texture(uint32_t eye) const;
+	uint32_t get_depth_texture(uint32_t eye) const;
+
+	// Tell us the motion vector and depth images for this frame have been rendered to.
+	void mark_images_rendered();
+
+protected:
+	XRFbSpaceWarpExtensionWrapper();
+	~XRFbSpaceWarpExtensionWrapper();
+
+private:
+	struct SpaceWarpSwapchain {
+		XrSwapchain swapchain = XR_NULL_HANDLE;
+		std::vector<XrSwapchainImageGL> images;
+		uint32_t image_index = 0;
+		bool acquired = false;
+	};
+
+	bool create_swapchain(int64_t p_format, XrSwapchainUsageFlags p_usage, SpaceWarpSwapchain &r_swapchain);
+	void destroy_swapchain(SpaceWarpSwapchain &p_swapchain);
+	bool acquire_swapchain(SpaceWarpSwapchain &p_swapchain);
+	void release_swapchain(SpaceWarpSwapchain &p_swapchain);
+	void acquire_images();
+
+	bool initialise_swapchains();
+	void cleanup_swapchains();
+	void update_target_fps();
+	void cleanup();
+
+	static XRFbSpaceWarpExtensionWrapper *singleton;
+
+	OpenXRApi *openxr_api = nullptr;
+	bool fb_space_warp_ext = false;
+	bool enabled = false;
+	bool skip_next_frame = false;
+	bool frame_acquired = false;
+	bool images_rendered = false; // for the images we've acquired
+	bool has_rendered_images = false; // since our swapchains were created
+	int frame_rate_divisor = 1;
+	int applied_target_fps = 0;
+	int original_target_fps = 0;
+
+	XrSystemSpaceWarpPropertiesFB space_warp_properties = {
+		.type = XR_TYPE_SYSTEM_SPACE_WARP_PROPERTIES_FB,
+		.next = nullptr,
+	};
+
+	std::vector<SpaceWarpSwapchain> motion_vector_swapchains;
+	std::vector<SpaceWarpSwapchain> depth_swapchains;
+	std::vector<XrCompositionLayerSpaceWarpInfoFB> space_warp_info;
+};
+
+#endif // XR_FB_SPACE_WARP_EXTENSION_WRAPPER_H
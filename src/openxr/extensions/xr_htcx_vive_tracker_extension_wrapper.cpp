@@ -0,0 +1,127 @@
+#include "xr_htcx_vive_tracker_extension_wrapper.h"
+
+#include <core/Variant.hpp>
+
+using namespace godot;
+
+XRHtcxViveTrackerExtensionWrapper *XRHtcxViveTrackerExtensionWrapper::singleton = nullptr;
+
+XRHtcxViveTrackerExtensionWrapper *XRHtcxViveTrackerExtensionWrapper::get_singleton() {
+	if (!singleton) {
+		singleton = new XRHtcxViveTrackerExtensionWrapper();
+	}
+
+	return singleton;
+}
+
+XRHtcxViveTrackerExtensionWrapper::XRHtcxViveTrackerExtensionWrapper() {
+	openxr_api = OpenXRApi::openxr_get_api();
+	request_extensions[XR_HTCX_VIVE_TRACKER_INTERACTION_EXTENSION_NAME] = &htcx_vive_tracker_ext;
+}
+
+XRHtcxViveTrackerExtensionWrapper::~XRHtcxViveTrackerExtensionWrapper() {
+	cleanup();
+	OpenXRApi::openxr_release_api();
+}
+
+void XRHtcxViveTrackerExtensionWrapper::cleanup() {
+	htcx_vive_tracker_ext = false;
+}
+
+void XRHtcxViveTrackerExtensionWrapper::on_instance_initialized(const XrInstance instance) {
+	if (htcx_vive_tracker_ext) {
+		XrResult result = initialise_htcx_vive_tracker_extension(instance);
+		if (!openxr_api->xr_result(result, "Failed to initialise vive tracker extension")) {
+			htcx_vive_tracker_ext = false; // I guess we don't support it...
+		}
+	}
+}
+
+void XRHtcxViveTrackerExtensionWrapper::on_state_ready() {
+	if (!htcx_vive_tracker_ext) {
+		return;
+	}
+
+	// Our input maps have just been rebuilt from our action sets, add any tracker that is already connected
+	uint32_t count = 0;
+	XrResult result = xrEnumerateViveTrackerPathsHTCX(openxr_api->get_instance(), 0, &count, nullptr);
+	if (!openxr_api->xr_result(result, "Failed to obtain vive tracker path count") || count == 0) {
+		return;
+	}
+
+	std::vector<XrViveTrackerPathsHTCX> paths(count, { XR_TYPE_VIVE_TRACKER_PATHS_HTCX, nullptr, XR_NULL_PATH, XR_NULL_PATH });
+	result = xrEnumerateViveTrackerPathsHTCX(openxr_api->get_instance(), count, &count, paths.data());
+	if (!openxr_api->xr_result(result, "Failed to obtain vive tracker paths")) {
+		return;
+	}
+
+	for (uint32_t i = 0; i < count; i++) {
+		register_tracker(paths[i]);
+	}
+}
+
+void XRHtcxViveTrackerExtensionWrapper::on_instance_destroyed() {
+	cleanup();
+}
+
+bool XRHtcxViveTrackerExtensionWrapper::on_event_polled(const XrEventDataBuffer &event) {
+	if (event.type == XR_TYPE_EVENT_DATA_VIVE_TRACKER_CONNECTED_HTCX) {
+		const XrEventDataViveTrackerConnectedHTCX *tracker_event = (const XrEventDataViveTrackerConnectedHTCX *)&event;
+		if (tracker_event->paths != nullptr) {
+			register_tracker(*tracker_event->paths);
+		}
+		return true;
+	}
+
+	return false;
+}
+
+void XRHtcxViveTrackerExtensionWrapper::register_tracker(const XrViveTrackerPathsHTCX &p_paths) {
+	if (p_paths.rolePath == XR_NULL_PATH) {
+		// Trackers without a role can't be bound through our action map
+		return;
+	}
+
+	const OpenXRApi::InputMap *inputmap = openxr_api->get_input_map(p_paths.rolePath);
+	if (inputmap == nullptr && openxr_api->register_input_map(p_paths.rolePath)) {
+		inputmap = openxr_api->get_input_map(p_paths.rolePath);
+	}
+
+	if (inputmap != nullptr && inputmap->action_mask == 0) {
+		Godot::print_warning(String("OpenXR Vive tracker connected for ") + String(inputmap->name.c_str()) + String(" but our action map doesn't use this role"), __FUNCTION__, __FILE__, __LINE__);
+	}
+}
+
+bool XRHtcxViveTrackerExtensionWrapper::path_is_supported(const String &p_io_path) {
+	if (p_io_path.begins_with("/user/vive_tracker_htcx/") || p_io_path == "/interaction_profiles/htc/vive_tracker_htcx") {
+		return htcx_vive_tracker_ext;
+	}
+
+	// Not a path under this extensions control, so we return true;
+	return true;
+}
+
+PFN_xrEnumerateViveTrackerPathsHTCX xrEnumerateViveTrackerPathsHTCX_ptr = nullptr;
+
+XRAPI_ATTR XrResult XRAPI_CALL XRHtcxViveTrackerExtensionWrapper::xrEnumerateViveTrackerPathsHTCX(
+		XrInstance instance,
+		uint32_t pathCapacityInput,
+		uint32_t *pathCountOutput,
+		XrViveTrackerPathsHTCX *paths) {
+	if (xrEnumerateViveTrackerPathsHTCX_ptr == nullptr) {
+		return XR_ERROR_HANDLE_INVALID;
+	}
+
+	return (*xrEnumerateViveTrackerPathsHTCX_ptr)(instance, pathCapacityInput, pathCountOutput, paths);
+}
+
+XrResult XRHtcxViveTrackerExtensionWrapper::initialise_htcx_vive_tracker_extension(XrInstance instance) {
+	XrResult result;
+
+	result = xrGetInstanceProcAddr(instance, "xrEnumerateViveTrackerPathsHTCX", (PFN_xrVoidFunction *)&xrEnumerateViveTrackerPathsHTCX_ptr);
+	if (result != XR_SUCCESS) {
+		return result;
+	}
+
+	return XR_SUCCESS;
+}
@@ -0,0 +1,50 @@
+#ifndef XR_HTCX_VIVE_TRACKER_EXTENSION_WRAPPER_H
+#define XR_HTCX_VIVE_TRACKER_EXTENSION_WRAPPER_H
+
+#include "openxr/OpenXRApi.h"
+#include "openxr/include/openxr_inc.h"
+#include "xr_extension_wrapper.h"
+
+#include <map>
+
+// Wrapper for the XR_HTCX_VIVE_TRACKER_INTERACTION_EXTENSION_NAME extension.
+// Trackers are bound through their role paths (i.e. /user/vive_tracker_htcx/role/left_foot),
+// we register the roles of connected trackers with our input maps.
+class XRHtcxViveTrackerExtensionWrapper : public XRExtensionWrapper {
+public:
+	static XRHtcxViveTrackerExtensionWrapper *get_singleton();
+
+	void on_instance_initialized(const XrInstance instance) override;
+
+	void on_state_ready() override;
+
+	void on_instance_destroyed() override;
+
+	bool on_event_polled(const XrEventDataBuffer &event) override;
+
+protected:
+	XRHtcxViveTrackerExtensionWrapper();
+	~XRHtcxViveTrackerExtensionWrapper();
+
+	virtual bool path_is_supported(const godot::String &p_io_path) override;
+
+private:
+	static XRAPI_ATTR XrResult XRAPI_CALL xrEnumerateViveTrackerPathsHTCX(
+			XrInstance instance,
+			uint32_t pathCapacityInput,
+			uint32_t *pathCountOutput,
+			XrViveTrackerPathsHTCX *paths);
+
+	static XrResult initialise_htcx_vive_tracker_extension(XrInstance instance);
+
+	void register_tracker(const XrViveTrackerPathsHTCX &p_paths);
+
+	void cleanup();
+
+	static XRHtcxViveTrackerExtensionWrapper *singleton;
+
+	OpenXRApi *openxr_api = nullptr;
+	bool htcx_vive_tracker_ext = false;
+};
+
+#endif // !XR_HTCX_VIVE_TRACKER_EXTENSION_WRAPPER_H
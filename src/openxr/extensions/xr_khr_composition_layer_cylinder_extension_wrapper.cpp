@@ -0,0 +1,29 @@
+#include "xr_khr_composition_layer_cylinder_extension_wrapper.h"
+
+XRKhrCompositionLayerCylinderExtensionWrapper *XRKhrCompositionLayerCylinderExtensionWrapper::singleton = nullptr;
+
+XRKhrCompositionLayerCylinderExtensionWrapper *XRKhrCompositionLayerCylinderExtensionWrapper::get_singleton() {
+	if (!singleton) {
+		singleton = new XRKhrCompositionLayerCylinderExtensionWrapper();
+	}
+
+	return singleton;
+}
+
+XRKhrCompositionLayerCylinderExtensionWrapper::XRKhrCompositionLayerCylinderExtensionWrapper() {
+	openxr_api = OpenXRApi::openxr_get_api();
+	request_extensions[XR_KHR_COMPOSITION_LAYER_CYLINDER_EXTENSION_NAME] = &khr_composition_layer_cylinder_ext;
+}
+
+XRKhrCompositionLayerCylinderExtensionWrapper::~XRKhrCompositionLayerCylinderExtensionWrapper() {
+	cleanup();
+	OpenXRApi::openxr_release_api();
+}
+
+void XRKhrCompositionLayerCylinderExtensionWrapper::cleanup() {
+	khr_composition_layer_cylinder_ext = false;
+}
+
+void XRKhrCompositionLayerCylinderExtensionWrapper::on_instance_destroyed() {
+	cleanup();
+}
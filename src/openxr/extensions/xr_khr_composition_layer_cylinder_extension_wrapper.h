@@ -0,0 +1,33 @@
+#ifndef XR_KHR_COMPOSITION_LAYER_CYLINDER_EXTENSION_WRAPPER_H
+#define XR_KHR_COMPOSITION_LAYER_CYLINDER_EXTENSION_WRAPPER_H
+
+#include "openxr/OpenXRApi.h"
+#include "openxr/extensions/xr_extension_wrapper.h"
+#include "openxr/include/openxr_inc.h"
+
+// Wrapper for the XR_KHR_composition_layer_cylinder extension.
+// The extension has no functions, we only need to request it so OpenXRCompositionLayer can submit cylinder layers.
+class XRKhrCompositionLayerCylinderExtensionWrapper : public XRExtensionWrapper {
+public:
+	static XRKhrCompositionLayerCylinderExtensionWrapper *get_singleton();
+
+	void on_instance_destroyed() override;
+
+	bool is_cylinder_supported() {
+		return khr_composition_layer_cylinder_ext;
+	}
+
+protected:
+	XRKhrCompositionLayerCylinderExtensionWrapper();
+	~XRKhrCompositionLayerCylinderExtensionWrapper();
+
+private:
+	void cleanup();
+
+	static XRKhrCompositionLayerCylinderExtensionWrapper *singleton;
+
+	OpenXRApi *openxr_api = nullptr;
+	bool khr_composition_layer_cylinder_ext = false;
+};
+
+#endif // XR_KHR_COMPOSITION_LAYER_CYLINDER_EXTENSION_WRAPPER_H
@@ -0,0 +1,421 @@
+#include "xr_msft_spatial_anchor_extension_wrapper.h"
+
+#include <JSON.hpp>
+#include <JSONParseResult.hpp>
+#include <core/Variant.hpp>
+
+#include <random>
+
+using namespace godot;
+
+XRMsftSpatialAnchorExtensionWrapper *XRMsftSpatialAnchorExtensionWrapper::singleton = nullptr;
+
+XRMsftSpatialAnchorExtensionWrapper *XRMsftSpatialAnchorExtensionWrapper::get_singleton() {
+	if (!singleton) {
+		singleton = new XRMsftSpatialAnchorExtensionWrapper();
+	}
+
+	return singleton;
+}
+
+XRMsftSpatialAnchorExtensionWrapper::XRMsftSpatialAnchorExtensionWrapper() {
+	openxr_api = OpenXRApi::openxr_get_api();
+	request_extensions[XR_MSFT_SPATIAL_ANCHOR_EXTENSION_NAME] = &msft_spatial_anchor_ext;
+}
+
+XRMsftSpatialAnchorExtensionWrapper::~XRMsftSpatialAnchorExtensionWrapper() {
+	cleanup();
+	OpenXRApi::openxr_release_api();
+}
+
+void XRMsftSpatialAnchorExtensionWrapper::cleanup() {
+	// our anchors themselves survive, we recreate them in our next session
+	for (Anchor &anchor : anchors) {
+		destroy_runtime_anchor(anchor);
+		anchor.failed_attempts = 0;
+		anchor.retry_frame = 0;
+	}
+}
+
+void XRMsftSpatialAnchorExtensionWrapper::on_instance_initialized(const XrInstance instance) {
+	if (msft_spatial_anchor_ext) {
+		XrResult result = initialise_msft_spatial_anchor_extension(instance);
+		if (!openxr_api->xr_result(result, "Failed to initialise spatial anchor extension")) {
+			msft_spatial_anchor_ext = false; // I guess we don't support it...
+		}
+	}
+}
+
+void XRMsftSpatialAnchorExtensionWrapper::on_session_destroyed() {
+	cleanup();
+}
+
+void XRMsftSpatialAnchorExtensionWrapper::on_instance_destroyed() {
+	cleanup();
+	msft_spatial_anchor_ext = false;
+}
+
+void XRMsftSpatialAnchorExtensionWrapper::on_process_openxr() {
+	if (!msft_spatial_anchor_ext || anchors.empty() || !openxr_api->is_running()) {
+		return;
+	}
+
+	const XrTime time = openxr_api->get_next_frame_time();
+	if (time == 0) {
+		return;
+	}
+
+	frame++;
+
+	// Locate all our anchors in one pass, static anchors are spread out over our update interval
+	for (uint64_t i = 0; i < anchors.size(); i++) {
+		Anchor &anchor = anchors[i];
+		if (anchor.space == XR_NULL_HANDLE) {
+			// new, or our session was recreated, if creating it failed we back off before trying again
+			if (frame < anchor.retry_frame) {
+				continue;
+			} else if (!create_runtime_anchor(anchor, time)) {
+				anchor.failed_attempts++;
+				uint32_t backoff = anchor.failed_attempts;
+				if (backoff > MAX_RETRY_BACKOFF) {
+					backoff = MAX_RETRY_BACKOFF;
+				}
+				anchor.retry_frame = frame + ((uint64_t)1 << backoff);
+				continue;
+			}
+
+			anchor.failed_attempts = 0;
+		} else if (anchor.is_static && anchor.location_flags != 0 && (frame + i) % static_update_interval != 0) {
+			continue;
+		}
+
+		XrSpaceLocation location = {
+			.type = XR_TYPE_SPACE_LOCATION,
+			.next = nullptr,
+			.locationFlags = 0,
+			.pose = anchor.pose
+		};
+
+		XrResult result = xrLocateSpace(anchor.space, openxr_api->get_play_space(), time, &location);
+		if (!openxr_api->xr_result(result, "Failed to locate spatial anchor")) {
+			continue;
+		}
+
+		// keep our last known pose if we lost tracking
+		anchor.location_flags = location.locationFlags;
+		if (location.locationFlags & XR_SPACE_LOCATION_ORIENTATION_VALID_BIT) {
+			anchor.pose.orientation = location.pose.orientation;
+		}
+		if (location.locationFlags & XR_SPACE_LOCATION_POSITION_VALID_BIT) {
+			anchor.pose.position = location.pose.position;
+		}
+	}
+}
+
+String XRMsftSpatialAnchorExtensionWrapper::create_anchor(const Transform &p_transform, float p_world_scale, bool p_is_static) {
+	// our transform may be scaled, our anchor only takes the rotation
+	const Quat q = p_transform.basis.orthonormalized().get_quat();
+	const Vector3 &o = p_transform.origin;
+
+	Anchor anchor;
+	anchor.uuid = generate_uuid();
+	anchor.is_static = p_is_static;
+	anchor.pose = {
+		.orientation = { q.x, q.y, q.z, q.w },
+		.position = { o.x / p_world_scale, o.y / p_world_scale, o.z / p_world_scale }
+	};
+	// until we've located it our anchor is where we put it
+	anchor.location_flags = msft_spatial_anchor_ext ? 0 : XR_SPACE_LOCATION_ORIENTATION_VALID_BIT | XR_SPACE_LOCATION_POSITION_VALID_BIT;
+	anchor.anchor = XR_NULL_HANDLE;
+	anchor.space = XR_NULL_HANDLE;
+	anchor.failed_attempts = 0;
+	anchor.retry_frame = 0;
+
+	anchors.push_back(anchor);
+
+	return anchor.uuid;
+}
+
+bool XRMsftSpatialAnchorExtensionWrapper::remove_anchor(const String &p_uuid) {
+	int64_t index = find_anchor(p_uuid);
+	if (index == -1) {
+		return false;
+	}
+
+	destroy_runtime_anchor(anchors[index]);
+	anchors.erase(anchors.begin() + index);
+
+	return true;
+}
+
+void XRMsftSpatialAnchorExtensionWrapper::clear_anchors() {
+	cleanup();
+	anchors.clear();
+}
+
+Array XRMsftSpatialAnchorExtensionWrapper::get_anchor_ids() const {
+	Array ids;
+
+	for (const Anchor &anchor : anchors) {
+		ids.push_back(anchor.uuid);
+	}
+
+	return ids;
+}
+
+bool XRMsftSpatialAnchorExtensionWrapper::has_anchor(const String &p_uuid) const {
+	return find_anchor(p_uuid) != -1;
+}
+
+TrackingConfidence XRMsftSpatialAnchorExtensionWrapper::get_anchor_transform(const String &p_uuid, float p_world_scale, Transform &r_transform) const {
+	int64_t index = find_anchor(p_uuid);
+	if (index == -1) {
+		return TRACKING_CONFIDENCE_NONE;
+	}
+
+	const Anchor &anchor = anchors[index];
+	XrSpaceLocation location = {
+		.type = XR_TYPE_SPACE_LOCATION,
+		.next = nullptr,
+		.locationFlags = anchor.location_flags,
+		.pose = anchor.pose
+	};
+
+	return openxr_api->transform_from_location(location, p_world_scale, r_transform);
+}
+
+bool XRMsftSpatialAnchorExtensionWrapper::save_anchors(const char *p_path) const {
+	Array data;
+	for (const Anchor &anchor : anchors) {
+		Array position;
+		position.push_back(anchor.pose.position.x);
+		position.push_back(anchor.pose.position.y);
+		position.push_back(anchor.pose.position.z);
+
+		Array orientation;
+		orientation.push_back(anchor.pose.orientation.x);
+		orientation.push_back(anchor.pose.orientation.y);
+		orientation.push_back(anchor.pose.orientation.z);
+		orientation.push_back(anchor.pose.orientation.w);
+
+		Dictionary entry;
+		entry["uuid"] = anchor.uuid;
+		entry["static"] = anchor.is_static;
+		entry["position"] = position;
+		entry["orientation"] = orientation;
+		data.push_back(entry);
+	}
+
+	String json = JSON::get_singleton()->print(data, "\t");
+	CharString utf8 = json.utf8();
+
+	FILE *file = fopen(p_path, "wb");
+	if (file == nullptr) {
+		Godot::print_error(String("OpenXR couldn't open ") + String(p_path) + String(" for writing"), __FUNCTION__, __FILE__, __LINE__);
+		return false;
+	}
+
+	bool success = fwrite(utf8.get_data(), 1, utf8.length(), file) == (size_t)utf8.length();
+	fclose(file);
+
+	return success;
+}
+
+bool XRMsftSpatialAnchorExtensionWrapper::load_anchors(const char *p_path) {
+	FILE *file = fopen(p_path, "rb");
+	if (file == nullptr) {
+		Godot::print_error(String("OpenXR couldn't open ") + String(p_path) + String(" for reading"), __FUNCTION__, __FILE__, __LINE__);
+		return false;
+	}
+
+	std::vector<char> buffer;
+	char chunk[4096];
+	size_t read;
+	while ((read = fread(chunk, 1, sizeof(chunk), file)) > 0) {
+		buffer.insert(buffer.end(), chunk, chunk + read);
+	}
+	fclose(file);
+	buffer.push_back('\0');
+
+	Ref<JSONParseResult> parse_result = JSON::get_singleton()->parse(String(buffer.data()));
+	if (parse_result->get_error() != Error::OK) {
+		Godot::print_error(String("OpenXR couldn't parse anchors in ") + String(p_path) + String(": ") + parse_result->get_error_string(), __FUNCTION__, __FILE__, __LINE__);
+		return false;
+	}
+
+	Variant json = parse_result->get_result();
+	if (json.get_type() != Variant::ARRAY) {
+		Godot::print_error(String("OpenXR anchors in ") + String(p_path) + String(" are not formatted correctly"), __FUNCTION__, __FILE__, __LINE__);
+		return false;
+	}
+
+	clear_anchors();
+
+	Array data = json;
+	for (int i = 0; i < data.size(); i++) {
+		if (data[i].get_type() != Variant::DICTIONARY) {
+			Godot::print_warning("Skipping incorrectly formatted anchor", __FUNCTION__, __FILE__, __LINE__);
+			continue;
+		}
+
+		Dictionary entry = data[i];
+		Array position = entry["position"];
+		Array orientation = entry["orientation"];
+		if (position.size() != 3 || orientation.size() != 4) {
+			Godot::print_warning("Skipping incorrectly formatted anchor", __FUNCTION__, __FILE__, __LINE__);
+			continue;
+		}
+
+		Anchor anchor;
+		anchor.uuid = entry["uuid"];
+		anchor.is_static = entry["static"];
+		anchor.pose = {
+			.orientation = { (float)orientation[0], (float)orientation[1], (float)orientation[2], (float)orientation[3] },
+			.position = { (float)position[0], (float)position[1], (float)position[2] }
+		};
+		anchor.location_flags = msft_spatial_anchor_ext ? 0 : XR_SPACE_LOCATION_ORIENTATION_VALID_BIT | XR_SPACE_LOCATION_POSITION_VALID_BIT;
+		anchor.anchor = XR_NULL_HANDLE;
+		anchor.space = XR_NULL_HANDLE;
+		anchor.failed_attempts = 0;
+		anchor.retry_frame = 0;
+
+		anchors.push_back(anchor);
+	}
+
+	return true;
+}
+
+String XRMsftSpatialAnchorExtensionWrapper::generate_uuid() {
+	// random (version 4) UUID
+	static std::mt19937_64 generator(std::random_device{}());
+	uint64_t high = generator();
+	uint64_t low = generator();
+	high = (high & 0xFFFFFFFFFFFF0FFFULL) | 0x0000000000004000ULL;
+	low = (low & 0x3FFFFFFFFFFFFFFFULL) | 0x8000000000000000ULL;
+
+	char uuid[37];
+	snprintf(uuid, sizeof(uuid), "%08x-%04x-%04x-%04x-%012llx",
+			(uint32_t)(high >> 32), (uint32_t)(high >> 16) & 0xFFFF, (uint32_t)high & 0xFFFF,
+			(uint32_t)(low >> 48), (unsigned long long)(low & 0xFFFFFFFFFFFFULL));
+
+	return String(uuid);
+}
+
+int64_t XRMsftSpatialAnchorExtensionWrapper::find_anchor(const String &p_uuid) const {
+	for (uint64_t i = 0; i < anchors.size(); i++) {
+		if (anchors[i].uuid == p_uuid) {
+			return (int64_t)i;
+		}
+	}
+
+	return -1;
+}
+
+bool XRMsftSpatialAnchorExtensionWrapper::create_runtime_anchor(Anchor &p_anchor, XrTime p_time) {
+	XrSpatialAnchorCreateInfoMSFT anchor_create_info = {
+		.type = XR_TYPE_SPATIAL_ANCHOR_CREATE_INFO_MSFT,
+		.next = nullptr,
+		.space = openxr_api->get_play_space(),
+		.pose = p_anchor.pose,
+		.time = p_time
+	};
+
+	XrResult result = xrCreateSpatialAnchorMSFT(openxr_api->get_session(), &anchor_create_info, &p_anchor.anchor);
+	if (!openxr_api->xr_result(result, "Failed to create spatial anchor")) {
+		p_anchor.anchor = XR_NULL_HANDLE;
+		return false;
+	}
+
+	XrSpatialAnchorSpaceCreateInfoMSFT space_create_info = {
+		.type = XR_TYPE_SPATIAL_ANCHOR_SPACE_CREATE_INFO_MSFT,
+		.next = nullptr,
+		.anchor = p_anchor.anchor,
+		.poseInAnchorSpace = { { 0.0, 0.0, 0.0, 1.0 }, { 0.0, 0.0, 0.0 } }
+	};
+
+	result = xrCreateSpatialAnchorSpaceMSFT(openxr_api->get_session(), &space_create_info, &p_anchor.space);
+	if (!openxr_api->xr_result(result, "Failed to create spatial anchor space")) {
+		destroy_runtime_anchor(p_anchor);
+		return false;
+	}
+
+	return true;
+}
+
+void XRMsftSpatialAnchorExtensionWrapper::destroy_runtime_anchor(Anchor &p_anchor) {
+	if (p_anchor.space == XR_NULL_HANDLE && p_anchor.anchor == XR_NULL_HANDLE) {
+		// never created, without our extension our stored pose stays valid
+		return;
+	}
+
+	if (p_anchor.space != XR_NULL_HANDLE) {
+		xrDestroySpace(p_anchor.space);
+		p_anchor.space = XR_NULL_HANDLE;
+	}
+
+	if (p_anchor.anchor != XR_NULL_HANDLE) {
+		xrDestroySpatialAnchorMSFT(p_anchor.anchor);
+		p_anchor.anchor = XR_NULL_HANDLE;
+	}
+
+	// we need to locate our new anchor before we can trust it
+	p_anchor.location_flags = 0;
+}
+
+PFN_xrCreateSpatialAnchorMSFT xrCreateSpatialAnchorMSFT_ptr = nullptr;
+
+XRAPI_ATTR XrResult XRAPI_CALL XRMsftSpatialAnchorExtensionWrapper::xrCreateSpatialAnchorMSFT(
+		XrSession session,
+		const XrSpatialAnchorCreateInfoMSFT *createInfo,
+		XrSpatialAnchorMSFT *anchor) {
+	if (xrCreateSpatialAnchorMSFT_ptr == nullptr) {
+		return XR_ERROR_HANDLE_INVALID;
+	}
+
+	return (*xrCreateSpatialAnchorMSFT_ptr)(session, createInfo, anchor);
+}
+
+PFN_xrCreateSpatialAnchorSpaceMSFT xrCreateSpatialAnchorSpaceMSFT_ptr = nullptr;
+
+XRAPI_ATTR XrResult XRAPI_CALL XRMsftSpatialAnchorExtensionWrapper::xrCreateSpatialAnchorSpaceMSFT(
+		XrSession session,
+		const XrSpatialAnchorSpaceCreateInfoMSFT *createInfo,
+		XrSpace *space) {
+	if (xrCreateSpatialAnchorSpaceMSFT_ptr == nullptr) {
+		return XR_ERROR_HANDLE_INVALID;
+	}
+
+	return (*xrCreateSpatialAnchorSpaceMSFT_ptr)(session, createInfo, space);
+}
+
+PFN_xrDestroySpatialAnchorMSFT xrDestroySpatialAnchorMSFT_ptr = nullptr;
+
+XRAPI_ATTR XrResult XRAPI_CALL XRMsftSpatialAnchorExtensionWrapper::xrDestroySpatialAnchorMSFT(
+		XrSpatialAnchorMSFT anchor) {
+	if (xrDestroySpatialAnchorMSFT_ptr == nullptr) {
+		return XR_ERROR_HANDLE_INVALID;
+	}
+
+	return (*xrDestroySpatialAnchorMSFT_ptr)(anchor);
+}
+
+XrResult XRMsftSpatialAnchorExtensionWrapper::initialise_msft_spatial_anchor_extension(XrInstance instance) {
+	XrResult result;
+
+	result = xrGetInstanceProcAddr(instance, "xrCreateSpatialAnchorMSFT", (PFN_xrVoidFunction *)&xrCreateSpatialAnchorMSFT_ptr);
+	if (result != XR_SUCCESS) {
+		return result;
+	}
+
+	result = xrGetInstanceProcAddr(instance, "xrCreateSpatialAnchorSpaceMSFT", (PFN_xrVoidFunction *)&xrCreateSpatialAnchorSpaceMSFT_ptr);
+	if (result != XR_SUCCESS) {
+		return result;
+	}
+
+	result = xrGetInstanceProcAddr(instance, "xrDestroySpatialAnchorMSFT", (PFN_xrVoidFunction *)&xrDestroySpatialAnchorMSFT_ptr);
+	if (result != XR_SUCCESS) {
+		return result;
+	}
+
+	return XR_SUCCESS;
+}
@@ -0,0 +1,98 @@
+#ifndef XR_MSFT_SPATIAL_ANCHOR_EXTENSION_WRAPPER_H
+#define XR_MSFT_SPATIAL_ANCHOR_EXTENSION_WRAPPER_H
+
+#include "openxr/OpenXRApi.h"
+#include "openxr/include/openxr_inc.h"
+#include "xr_extension_wrapper.h"
+
+#include <map>
+#include <vector>
+
+// Wrapper for the XR_MSFT_SPATIAL_ANCHOR_EXTENSION_NAME extension.
+//
+// Anchors are identified by a UUID we generate and are located in one pass each frame,
+// static anchors (content that doesn't move) are only located every few frames.
+// We store the last known pose of each anchor relative to our play space, this is what we
+// save to disk and what we recreate our anchors from after a restart. If the runtime doesn't
+// support spatial anchors we simply keep our anchors at their stored pose.
+class XRMsftSpatialAnchorExtensionWrapper : public XRExtensionWrapper {
+public:
+	static XRMsftSpatialAnchorExtensionWrapper *get_singleton();
+
+	void on_instance_initialized(const XrInstance instance) override;
+
+	void on_session_destroyed() override;
+
+	void on_instance_destroyed() override;
+
+	void on_process_openxr() override;
+
+	bool is_spatial_anchor_supported() const {
+		return msft_spatial_anchor_ext;
+	}
+
+	// p_transform is relative to our play space with world scale applied, returns the UUID of our new anchor
+	godot::String create_anchor(const godot::Transform &p_transform, float p_world_scale, bool p_is_static);
+	bool remove_anchor(const godot::String &p_uuid);
+	void clear_anchors();
+	godot::Array get_anchor_ids() const;
+	bool has_anchor(const godot::String &p_uuid) const;
+	TrackingConfidence get_anchor_transform(const godot::String &p_uuid, float p_world_scale, godot::Transform &r_transform) const;
+
+	int get_static_update_interval() const { return static_update_interval; }
+	void set_static_update_interval(int p_frames) { static_update_interval = p_frames > 1 ? p_frames : 1; }
+
+	bool save_anchors(const char *p_path) const;
+	bool load_anchors(const char *p_path);
+
+protected:
+	XRMsftSpatialAnchorExtensionWrapper();
+	~XRMsftSpatialAnchorExtensionWrapper();
+
+private:
+	struct Anchor {
+		godot::String uuid;
+		bool is_static;
+		XrPosef pose; // last known pose in our play space, without world scale
+		XrSpaceLocationFlags location_flags;
+		XrSpatialAnchorMSFT anchor;
+		XrSpace space;
+		uint32_t failed_attempts; // to create our runtime anchor
+		uint64_t retry_frame; // don't try creating our runtime anchor again before this frame
+	};
+
+	// After failing to create a runtime anchor we wait 2, 4, 8... frames before trying again, up to 2^MAX_RETRY_BACKOFF frames
+	static const uint32_t MAX_RETRY_BACKOFF = 8;
+
+	static XRAPI_ATTR XrResult XRAPI_CALL xrCreateSpatialAnchorMSFT(
+			XrSession session,
+			const XrSpatialAnchorCreateInfoMSFT *createInfo,
+			XrSpatialAnchorMSFT *anchor);
+
+	static XRAPI_ATTR XrResult XRAPI_CALL xrCreateSpatialAnchorSpaceMSFT(
+			XrSession session,
+			const XrSpatialAnchorSpaceCreateInfoMSFT *createInfo,
+			XrSpace *space);
+
+	static XRAPI_ATTR XrResult XRAPI_CALL xrDestroySpatialAnchorMSFT(
+			XrSpatialAnchorMSFT anchor);
+
+	static XrResult initialise_msft_spatial_anchor_extension(XrInstance instance);
+
+	static godot::String generate_uuid();
+	int64_t find_anchor(const godot::String &p_uuid) const;
+	bool create_runtime_anchor(Anchor &p_anchor, XrTime p_time);
+	void destroy_runtime_anchor(Anchor &p_anchor);
+	void cleanup();
+
+	static XRMsftSpatialAnchorExtensionWrapper *singleton;
+
+	OpenXRApi *openxr_api = nullptr;
+	bool msft_spatial_anchor_ext = false;
+
+	std::vector<Anchor> anchors;
+	int static_update_interval = 30;
+	uint64_t frame = 0;
+};
+
+#endif // !XR_MSFT_SPATIAL_ANCHOR_EXTENSION_WRAPPER_H
@@ -0,0 +1,20 @@
+#ifndef XR_POSE_LISTENER_H
+#define XR_POSE_LISTENER_H
+
+#include <Transform.hpp>
+
+// How nodes that use our tracking data are updated
+enum PoseUpdateMode {
+	POSE_UPDATE_MODE_RENDER, // once per frame through XRPoseListener, predicted for the frame we're about to render
+	POSE_UPDATE_MODE_PHYSICS, // every physics tick in _physics_process, predicted for that tick
+};
+
+// Interface for objects that want to be updated with our tracking data.
+// Listeners are updated in one pass each frame after we've synced our actions and updated our extensions,
+// our pose history will already contain the poses for the frame we're about to render.
+class XRPoseListener {
+public:
+	virtual void on_poses_updated(float p_world_scale, const godot::Transform &p_reference_frame) = 0;
+};
+
+#endif // XR_POSE_LISTENER_H
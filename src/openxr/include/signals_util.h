@@ -3,6 +3,8 @@
 
 #include <core/GodotGlobal.hpp>
 
+#include "openxr/allocation_tracker.h"
+
 using namespace godot;
 
 static const char *SIGNAL_SESSION_BEGUN = "openxr_session_begun";
@@ -14,6 +16,9 @@ static const char *SIGNAL_SESSION_EXITING = "openxr_session_exiting";
 static const char *SIGNAL_FOCUSED_STATE = "openxr_focused_state";
 static const char *SIGNAL_VISIBLE_STATE = "openxr_visible_state";
 static const char *SIGNAL_POSE_RECENTERED = "openxr_pose_recentered";
+static const char *SIGNAL_FRAME_BUDGET_EXCEEDED = "openxr_frame_budget_exceeded";
+static const char *SIGNAL_ACTIONS_CHANGED = "openxr_actions_changed";
+static const char *SIGNAL_INTERACTION_PROFILE_CHANGED = "openxr_interaction_profile_changed";
 
 static void register_plugin_signals() {
 	ARVRServer *arvr_server = ARVRServer::get_singleton();
@@ -32,6 +37,9 @@ static void register_plugin_signals() {
 	arvr_server->add_user_signal(SIGNAL_FOCUSED_STATE);
 	arvr_server->add_user_signal(SIGNAL_VISIBLE_STATE);
 	arvr_server->add_user_signal(SIGNAL_POSE_RECENTERED);
+	arvr_server->add_user_signal(SIGNAL_FRAME_BUDGET_EXCEEDED);
+	arvr_server->add_user_signal(SIGNAL_ACTIONS_CHANGED);
+	arvr_server->add_user_signal(SIGNAL_INTERACTION_PROFILE_CHANGED);
 }
 
 template <class... Args>
@@ -47,6 +55,9 @@ static void emit_plugin_signal(const String signal, Args... args) {
 		return;
 	}
 
+	// What the application does in response to our signals isn't part of our frame loop
+	AllocationTracker::Pause pause_allocation_tracking;
+
 	arvr_server->emit_signal(signal, args...);
 }
 
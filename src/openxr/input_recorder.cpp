@@ -0,0 +1,461 @@
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Class for recording and replaying the tracking and input data we get from OpenXR
+
+#include "openxr/OpenXRApi.h"
+
+using namespace godot;
+
+static const char file_magic[4] = { 'G', 'X', 'I', 'R' };
+
+InputRecorder::InputRecorder() {
+	frame_state.type = XR_TYPE_FRAME_STATE;
+	frame_state.next = nullptr;
+	frame_state.predictedDisplayTime = 0;
+	frame_state.predictedDisplayPeriod = 0;
+	frame_state.shouldRender = false;
+}
+
+InputRecorder::~InputRecorder() {
+	stop();
+}
+
+bool InputRecorder::start_recording(const char *p_path) {
+	stop();
+
+	file = fopen(p_path, "wb");
+	if (file == nullptr) {
+		Godot::print_error(String("Couldn't open input recording file ") + String(p_path), __FUNCTION__, __FILE__, __LINE__);
+		return false;
+	}
+
+	// write our header
+	fwrite(file_magic, 1, sizeof(file_magic), file);
+	const uint32_t version = FILE_VERSION;
+	fwrite(&version, sizeof(version), 1, file);
+
+	// reserve a decent amount of space so we don't allocate while recording
+	frame_buffer.clear();
+	frame_buffer.reserve(64 * 1024);
+
+	mode = MODE_RECORD;
+	generation++;
+	frame_count = 0;
+	next_key = 0;
+
+	return true;
+}
+
+bool InputRecorder::start_replay(const char *p_path) {
+	stop();
+
+	FILE *replay_file = fopen(p_path, "rb");
+	if (replay_file == nullptr) {
+		Godot::print_error(String("Couldn't open input recording file ") + String(p_path), __FUNCTION__, __FILE__, __LINE__);
+		return false;
+	}
+
+	// we just load the whole file, recordings are small
+	fseek(replay_file, 0, SEEK_END);
+	long size = ftell(replay_file);
+	fseek(replay_file, 0, SEEK_SET);
+
+	data.resize(size > 0 ? size_t(size) : 0);
+	size_t read = data.empty() ? 0 : fread(data.data(), 1, data.size(), replay_file);
+	fclose(replay_file);
+
+	char magic[4];
+	uint32_t version = 0;
+	read_offset = 0;
+	if (read != data.size() || !read_data(magic, sizeof(magic)) || memcmp(magic, file_magic, sizeof(magic)) != 0 || !read_value(version)) {
+		Godot::print_error(String("File ") + String(p_path) + String(" is not an input recording"), __FUNCTION__, __FILE__, __LINE__);
+		data.clear();
+		return false;
+	} else if (version > FILE_VERSION) {
+		Godot::print_error(String("Input recording ") + String(p_path) + String(" was made with a newer version, version ") + String::num_int64(version), __FUNCTION__, __FILE__, __LINE__);
+		data.clear();
+		return false;
+	}
+
+	mode = MODE_REPLAY;
+	generation++;
+	frame_count = 0;
+
+	// Actions can be used for the first time in any frame, we read all our keys up front so
+	// they're known from our first frame on and anything looking them up can cache them.
+	size_t frames_offset = read_offset;
+	while (read_offset + 2 * sizeof(uint32_t) <= data.size()) {
+		uint32_t type;
+		uint32_t size;
+		read_value(type);
+		read_value(size);
+		if (read_offset + size > data.size()) {
+			// begin_frame will warn about this
+			break;
+		}
+
+		size_t chunk_end = read_offset + size;
+		if (type == CHUNK_KEY) {
+			read_chunk(type);
+		}
+		read_offset = chunk_end;
+	}
+	read_offset = frames_offset;
+
+	return true;
+}
+
+void InputRecorder::stop() {
+	if (mode == MODE_RECORD) {
+		flush_frame();
+		fclose(file);
+		file = nullptr;
+
+#ifdef DEBUG
+		Godot::print("OpenXR recorded {0} frames", frame_count);
+#endif
+	}
+
+	mode = MODE_OFF;
+	data.clear();
+	read_offset = 0;
+	keys.clear();
+	actions.clear();
+	actions_frame.clear();
+	views_frame = 0;
+	head_frame = 0;
+	hands_frame[0] = 0;
+	hands_frame[1] = 0;
+}
+
+bool InputRecorder::begin_frame(const XrFrameState &p_frame_state) {
+	if (mode == MODE_RECORD) {
+		// write out our previous frame
+		flush_frame();
+
+		frame_count++;
+		frame_state = p_frame_state;
+
+		begin_chunk(CHUNK_FRAME, sizeof(XrTime) + sizeof(XrDuration) + sizeof(uint32_t));
+		write_value(p_frame_state.predictedDisplayTime);
+		write_value(p_frame_state.predictedDisplayPeriod);
+		write_value(uint32_t(p_frame_state.shouldRender));
+
+		return true;
+	} else if (mode == MODE_REPLAY) {
+		frame_count++;
+
+		// read chunks until we reach the start of the next frame
+		bool have_frame = false;
+		while (read_offset + 2 * sizeof(uint32_t) <= data.size()) {
+			uint32_t type;
+			uint32_t size;
+			memcpy(&type, &data[read_offset], sizeof(uint32_t));
+			memcpy(&size, &data[read_offset + sizeof(uint32_t)], sizeof(uint32_t));
+
+			if (type == CHUNK_FRAME && have_frame) {
+				// this is our next frame
+				break;
+			}
+
+			read_offset += 2 * sizeof(uint32_t);
+			if (read_offset + size > data.size()) {
+				Godot::print_warning("OpenXR input recording is truncated", __FUNCTION__, __FILE__, __LINE__);
+				read_offset = data.size();
+				break;
+			}
+
+			size_t chunk_end = read_offset + size;
+			if (type == CHUNK_FRAME) {
+				have_frame = true;
+			}
+			read_chunk(type);
+
+			// skips anything a newer version may have added
+			read_offset = chunk_end;
+		}
+
+		if (!have_frame) {
+			Godot::print("OpenXR reached the end of our input recording after {0} frames", frame_count - 1);
+			stop();
+			return false;
+		}
+
+		return true;
+	}
+
+	return false;
+}
+
+uint32_t InputRecorder::get_key(const String &p_name) {
+	if (mode == MODE_OFF) {
+		return INVALID_KEY;
+	}
+
+	std::string name = p_name.utf8().get_data();
+	auto it = keys.find(name);
+	if (it != keys.end()) {
+		return it->second;
+	} else if (mode == MODE_REPLAY) {
+		// not in our recording
+		return INVALID_KEY;
+	}
+
+	uint32_t key = next_key++;
+	add_key(name, key);
+
+	begin_chunk(CHUNK_KEY, 2 * sizeof(uint32_t) + uint32_t(name.size()));
+	write_value(key);
+	write_value(uint32_t(name.size()));
+	write_data(name.data(), name.size());
+
+	return key;
+}
+
+void InputRecorder::add_key(const std::string &p_name, uint32_t p_key) {
+	keys[p_name] = p_key;
+
+	if (p_key >= actions.size()) {
+		actions.resize(p_key + 1);
+		actions_frame.resize(p_key + 1, 0);
+	}
+}
+
+void InputRecorder::record_views(XrViewStateFlags p_flags, uint32_t p_count, const XrView *p_views) {
+	if (mode != MODE_RECORD || views_frame == frame_count) {
+		return;
+	}
+	views_frame = frame_count;
+
+	begin_chunk(CHUNK_VIEWS, sizeof(XrViewStateFlags) + sizeof(uint32_t) + p_count * (sizeof(XrPosef) + sizeof(XrFovf)));
+	write_value(p_flags);
+	write_value(p_count);
+	for (uint32_t i = 0; i < p_count; i++) {
+		write_value(p_views[i].pose);
+		write_value(p_views[i].fov);
+	}
+}
+
+bool InputRecorder::replay_views(XrViewStateFlags &r_flags, uint32_t p_count, XrView *r_views) const {
+	if (mode != MODE_REPLAY || views_frame != frame_count) {
+		return false;
+	}
+
+	r_flags = view_flags;
+	for (uint32_t i = 0; i < p_count && i < view_count; i++) {
+		r_views[i].pose = views[i].pose;
+		r_views[i].fov = views[i].fov;
+	}
+
+	return true;
+}
+
+void InputRecorder::record_head(const XrSpaceLocation &p_location, const XrSpaceVelocity &p_velocity) {
+	// our head is located multiple times each frame, we only record the first one
+	if (mode != MODE_RECORD || head_frame == frame_count) {
+		return;
+	}
+	head_frame = frame_count;
+
+	begin_chunk(CHUNK_HEAD, sizeof(XrSpaceLocationFlags) + sizeof(XrPosef) + sizeof(XrSpaceVelocityFlags) + 2 * sizeof(XrVector3f));
+	write_value(p_location.locationFlags);
+	write_value(p_location.pose);
+	write_value(p_velocity.velocityFlags);
+	write_value(p_velocity.linearVelocity);
+	write_value(p_velocity.angularVelocity);
+}
+
+bool InputRecorder::replay_head(XrSpaceLocation &r_location, XrSpaceVelocity &r_velocity) const {
+	if (mode != MODE_REPLAY || head_frame != frame_count) {
+		return false;
+	}
+
+	r_location.locationFlags = head_location.locationFlags;
+	r_location.pose = head_location.pose;
+	r_velocity.velocityFlags = head_velocity.velocityFlags;
+	r_velocity.linearVelocity = head_velocity.linearVelocity;
+	r_velocity.angularVelocity = head_velocity.angularVelocity;
+
+	return true;
+}
+
+void InputRecorder::record_action(uint32_t p_key, const ActionRecord &p_record) {
+	if (mode != MODE_RECORD || p_key >= actions.size() || actions_frame[p_key] == frame_count) {
+		return;
+	}
+	actions_frame[p_key] = frame_count;
+
+	begin_chunk(CHUNK_ACTION, 2 * sizeof(uint32_t) + 2 * sizeof(float) + sizeof(XrSpaceLocationFlags) + sizeof(XrPosef) + sizeof(XrSpaceVelocityFlags) + 2 * sizeof(XrVector3f));
+	write_value(p_key);
+	write_value(p_record.is_active);
+	write_value(p_record.value[0]);
+	write_value(p_record.value[1]);
+	write_value(p_record.location_flags);
+	write_value(p_record.pose);
+	write_value(p_record.velocity_flags);
+	write_value(p_record.linear_velocity);
+	write_value(p_record.angular_velocity);
+}
+
+bool InputRecorder::replay_action(uint32_t p_key, ActionRecord &r_record) const {
+	if (mode != MODE_REPLAY || p_key >= actions.size() || actions_frame[p_key] != frame_count) {
+		return false;
+	}
+
+	r_record = actions[p_key];
+	return true;
+}
+
+void InputRecorder::record_hand(uint32_t p_hand, bool p_is_active, const XrHandJointLocationEXT *p_locations, const XrHandJointVelocityEXT *p_velocities) {
+	if (mode != MODE_RECORD || p_hand > 1 || hands_frame[p_hand] == frame_count) {
+		return;
+	}
+	hands_frame[p_hand] = frame_count;
+
+	const uint32_t joint_size = sizeof(XrSpaceLocationFlags) + sizeof(XrPosef) + sizeof(float) + sizeof(XrSpaceVelocityFlags) + 2 * sizeof(XrVector3f);
+	begin_chunk(CHUNK_HAND, 2 * sizeof(uint32_t) + XR_HAND_JOINT_COUNT_EXT * joint_size);
+	write_value(p_hand);
+	write_value(uint32_t(p_is_active));
+	for (uint32_t i = 0; i < XR_HAND_JOINT_COUNT_EXT; i++) {
+		write_value(p_locations[i].locationFlags);
+		write_value(p_locations[i].pose);
+		write_value(p_locations[i].radius);
+		write_value(p_velocities[i].velocityFlags);
+		write_value(p_velocities[i].linearVelocity);
+		write_value(p_velocities[i].angularVelocity);
+	}
+}
+
+bool InputRecorder::replay_hand(uint32_t p_hand, XrBool32 &r_is_active, XrHandJointLocationEXT *r_locations, XrHandJointVelocityEXT *r_velocities) const {
+	if (mode != MODE_REPLAY || p_hand > 1 || hands_frame[p_hand] != frame_count) {
+		return false;
+	}
+
+	const HandRecord &hand = hands[p_hand];
+	r_is_active = hand.is_active;
+	for (uint32_t i = 0; i < XR_HAND_JOINT_COUNT_EXT; i++) {
+		r_locations[i].locationFlags = hand.locations[i].locationFlags;
+		r_locations[i].pose = hand.locations[i].pose;
+		r_locations[i].radius = hand.locations[i].radius;
+		r_velocities[i].velocityFlags = hand.velocities[i].velocityFlags;
+		r_velocities[i].linearVelocity = hand.velocities[i].linearVelocity;
+		r_velocities[i].angularVelocity = hand.velocities[i].angularVelocity;
+	}
+
+	return true;
+}
+
+void InputRecorder::begin_chunk(ChunkType p_type, uint32_t p_size) {
+	write_value(uint32_t(p_type));
+	write_value(p_size);
+}
+
+void InputRecorder::write_data(const void *p_data, size_t p_size) {
+	const uint8_t *bytes = (const uint8_t *)p_data;
+	frame_buffer.insert(frame_buffer.end(), bytes, bytes + p_size);
+}
+
+void InputRecorder::flush_frame() {
+	if (file != nullptr && !frame_buffer.empty()) {
+		fwrite(frame_buffer.data(), 1, frame_buffer.size(), file);
+	}
+	frame_buffer.clear();
+}
+
+bool InputRecorder::read_data(void *r_data, size_t p_size) {
+	if (read_offset + p_size > data.size()) {
+		return false;
+	}
+
+	memcpy(r_data, &data[read_offset], p_size);
+	read_offset += p_size;
+	return true;
+}
+
+bool InputRecorder::read_chunk(uint32_t p_type) {
+	switch (p_type) {
+		case CHUNK_KEY: {
+			uint32_t key;
+			uint32_t length;
+			if (!read_value(key) || !read_value(length) || read_offset + length > data.size()) {
+				return false;
+			}
+
+			add_key(std::string((const char *)&data[read_offset], length), key);
+			read_offset += length;
+		} break;
+		case CHUNK_FRAME: {
+			uint32_t should_render = 0;
+			read_value(frame_state.predictedDisplayTime);
+			read_value(frame_state.predictedDisplayPeriod);
+			read_value(should_render);
+			frame_state.shouldRender = should_render;
+		} break;
+		case CHUNK_VIEWS: {
+			uint32_t count = 0;
+			if (!read_value(view_flags) || !read_value(count)) {
+				return false;
+			}
+
+			if (count > MAX_VIEWS) {
+				// we'll skip the rest
+				count = MAX_VIEWS;
+			}
+
+			view_count = count;
+			for (uint32_t i = 0; i < view_count; i++) {
+				read_value(views[i].pose);
+				read_value(views[i].fov);
+			}
+			views_frame = frame_count;
+		} break;
+		case CHUNK_HEAD: {
+			read_value(head_location.locationFlags);
+			read_value(head_location.pose);
+			read_value(head_velocity.velocityFlags);
+			read_value(head_velocity.linearVelocity);
+			read_value(head_velocity.angularVelocity);
+			head_frame = frame_count;
+		} break;
+		case CHUNK_ACTION: {
+			uint32_t key;
+			if (!read_value(key) || key >= actions.size()) {
+				// we should have had a key chunk
+				return false;
+			}
+
+			ActionRecord &record = actions[key];
+			read_value(record.is_active);
+			read_value(record.value[0]);
+			read_value(record.value[1]);
+			read_value(record.location_flags);
+			read_value(record.pose);
+			read_value(record.velocity_flags);
+			read_value(record.linear_velocity);
+			read_value(record.angular_velocity);
+			actions_frame[key] = frame_count;
+		} break;
+		case CHUNK_HAND: {
+			uint32_t hand;
+			if (!read_value(hand) || hand > 1) {
+				return false;
+			}
+
+			HandRecord &record = hands[hand];
+			read_value(record.is_active);
+			for (uint32_t i = 0; i < XR_HAND_JOINT_COUNT_EXT; i++) {
+				read_value(record.locations[i].locationFlags);
+				read_value(record.locations[i].pose);
+				read_value(record.locations[i].radius);
+				read_value(record.velocities[i].velocityFlags);
+				read_value(record.velocities[i].linearVelocity);
+				read_value(record.velocities[i].angularVelocity);
+			}
+			hands_frame[hand] = frame_count;
+		} break;
+		default: {
+			// unknown chunk, skipped by our caller
+		} break;
+	}
+
+	return true;
+}
@@ -0,0 +1,147 @@
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Class for recording and replaying the tracking and input data we get from OpenXR
+// Note, included through OpenXRApi.h
+//
+// While recording we write everything we obtain from the runtime for a frame to a file,
+// while replaying we read it back and use it instead of what the runtime gives us.
+// This allows reproducing a session, for instance for profiling, without wearing a headset.
+// Combined with headless mode this runs on machines without any XR hardware.
+//
+// The file starts with a header followed by a stream of chunks, each chunk has a type and
+// a size followed by its data. Data is written as plain little endian structures of fixed
+// size and is only ever appended, once a frame is written it's never touched again.
+// A FRAME chunk starts each frame, all chunks until the next FRAME chunk belong to that frame.
+// KEY chunks introduce the names of the actions we record, they can appear in any frame.
+// When replaying we read all KEY chunks up front so every key is known from the first frame.
+
+#ifndef OPENXR_INPUT_RECORDER_H
+#define OPENXR_INPUT_RECORDER_H
+
+#include <map>
+#include <string>
+
+class InputRecorder {
+public:
+	static const uint32_t FILE_VERSION = 1;
+	static const uint32_t INVALID_KEY = 0xFFFFFFFF;
+	static const uint32_t MAX_VIEWS = 4;
+
+	enum Mode {
+		MODE_OFF,
+		MODE_RECORD,
+		MODE_REPLAY,
+	};
+
+	enum ChunkType {
+		CHUNK_KEY,
+		CHUNK_FRAME,
+		CHUNK_VIEWS,
+		CHUNK_HEAD,
+		CHUNK_ACTION,
+		CHUNK_HAND,
+	};
+
+	// State of one action on one top level path, we use the same record for all action types.
+	struct ActionRecord {
+		uint32_t is_active;
+		float value[2]; // bool, float or vector2 value
+		XrSpaceLocationFlags location_flags; // only used for poses
+		XrPosef pose;
+		XrSpaceVelocityFlags velocity_flags;
+		XrVector3f linear_velocity;
+		XrVector3f angular_velocity;
+	};
+
+	InputRecorder();
+	~InputRecorder();
+
+	Mode get_mode() const { return mode; }
+	bool is_recording() const { return mode == MODE_RECORD; }
+	bool is_replaying() const { return mode == MODE_REPLAY; }
+
+	// Incremented every time we start, keys obtained before that are no longer valid.
+	uint32_t get_generation() const { return generation; }
+
+	bool start_recording(const char *p_path);
+	bool start_replay(const char *p_path);
+	void stop();
+
+	uint64_t get_frame_count() const { return frame_count; }
+
+	// The frame state of the frame we're recording or replaying.
+	const XrFrameState &get_frame_state() const { return frame_state; }
+
+	// Called after xrWaitFrame, starts a new frame in both modes.
+	// Returns false if we're replaying and reached the end of our recording.
+	bool begin_frame(const XrFrameState &p_frame_state);
+
+	// Get an id for the action (or other input) with the given name.
+	// Returns INVALID_KEY if we're replaying and it isn't part of our recording.
+	uint32_t get_key(const godot::String &p_name);
+
+	void record_views(XrViewStateFlags p_flags, uint32_t p_count, const XrView *p_views);
+	bool replay_views(XrViewStateFlags &r_flags, uint32_t p_count, XrView *r_views) const;
+
+	void record_head(const XrSpaceLocation &p_location, const XrSpaceVelocity &p_velocity);
+	bool replay_head(XrSpaceLocation &r_location, XrSpaceVelocity &r_velocity) const;
+
+	void record_action(uint32_t p_key, const ActionRecord &p_record);
+	bool replay_action(uint32_t p_key, ActionRecord &r_record) const;
+
+	void record_hand(uint32_t p_hand, bool p_is_active, const XrHandJointLocationEXT *p_locations, const XrHandJointVelocityEXT *p_velocities);
+	bool replay_hand(uint32_t p_hand, XrBool32 &r_is_active, XrHandJointLocationEXT *r_locations, XrHandJointVelocityEXT *r_velocities) const;
+
+private:
+	Mode mode = MODE_OFF;
+	uint32_t generation = 0;
+	uint64_t frame_count = 0;
+
+	// recording
+	FILE *file = nullptr;
+	std::vector<uint8_t> frame_buffer; // written out once per frame, keeps its capacity
+	uint32_t next_key = 0;
+
+	// replaying
+	std::vector<uint8_t> data;
+	size_t read_offset = 0;
+
+	XrFrameState frame_state;
+
+	// Data for the frame we're replaying, a frame number tells us if it was recorded this frame.
+	XrViewStateFlags view_flags = 0;
+	uint32_t view_count = 0;
+	XrView views[MAX_VIEWS];
+	uint64_t views_frame = 0;
+
+	XrSpaceLocation head_location;
+	XrSpaceVelocity head_velocity;
+	uint64_t head_frame = 0;
+
+	std::vector<ActionRecord> actions;
+	std::vector<uint64_t> actions_frame;
+
+	struct HandRecord {
+		uint32_t is_active;
+		XrHandJointLocationEXT locations[XR_HAND_JOINT_COUNT_EXT];
+		XrHandJointVelocityEXT velocities[XR_HAND_JOINT_COUNT_EXT];
+	};
+	HandRecord hands[2];
+	uint64_t hands_frame[2] = { 0, 0 };
+
+	// keys by name, while recording these are the keys we've written, while replaying the keys we've read
+	std::map<std::string, uint32_t> keys;
+
+	void begin_chunk(ChunkType p_type, uint32_t p_size);
+	void write_data(const void *p_data, size_t p_size);
+	template <class T>
+	void write_value(const T &p_value) { write_data(&p_value, sizeof(T)); }
+	void flush_frame();
+
+	bool read_data(void *r_data, size_t p_size);
+	template <class T>
+	bool read_value(T &r_value) { return read_data(&r_value, sizeof(T)); }
+	bool read_chunk(uint32_t p_type);
+	void add_key(const std::string &p_name, uint32_t p_key);
+};
+
+#endif /* !OPENXR_INPUT_RECORDER_H */
@@ -0,0 +1,647 @@
+#include "mock_runtime.h"
+
+#include <stdlib.h>
+#include <algorithm>
+
+bool is_action_set(XrActionSet p_action_set) {
+	if (mock_instance == nullptr) {
+		return false;
+	}
+
+	for (MockActionSet *action_set : mock_instance->action_sets) {
+		if (from_handle<MockActionSet>(p_action_set) == action_set) {
+			return true;
+		}
+	}
+	return false;
+}
+
+bool is_action(XrAction p_action) {
+	if (mock_instance == nullptr) {
+		return false;
+	}
+
+	for (MockActionSet *action_set : mock_instance->action_sets) {
+		for (MockAction *action : action_set->actions) {
+			if (from_handle<MockAction>(p_action) == action) {
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+void destroy_action_sets() {
+	for (MockActionSet *action_set : mock_instance->action_sets) {
+		for (MockAction *action : action_set->actions) {
+			delete action;
+		}
+		delete action_set;
+	}
+	mock_instance->action_sets.clear();
+	mock_instance->suggested_profiles.clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Actions
+
+static XrResult XRAPI_CALL mock_xrCreateActionSet(XrInstance instance, const XrActionSetCreateInfo *createInfo, XrActionSet *actionSet) {
+	MOCK_LOCK;
+
+	if (!is_instance(instance)) {
+		return XR_ERROR_HANDLE_INVALID;
+	} else if (createInfo == nullptr || actionSet == nullptr) {
+		return XR_ERROR_VALIDATION_FAILURE;
+	} else if (createInfo->actionSetName[0] == '\0') {
+		return XR_ERROR_NAME_INVALID;
+	} else if (createInfo->localizedActionSetName[0] == '\0') {
+		return XR_ERROR_LOCALIZED_NAME_INVALID;
+	}
+
+	for (MockActionSet *action_set : mock_instance->action_sets) {
+		if (action_set->name == createInfo->actionSetName) {
+			return XR_ERROR_NAME_DUPLICATED;
+		}
+	}
+
+	MockActionSet *new_action_set = new MockActionSet();
+	new_action_set->name = createInfo->actionSetName;
+	new_action_set->priority = createInfo->priority;
+	mock_instance->action_sets.push_back(new_action_set);
+
+	*actionSet = to_handle<XrActionSet>(new_action_set);
+	return XR_SUCCESS;
+}
+
+static XrResult XRAPI_CALL mock_xrDestroyActionSet(XrActionSet actionSet) {
+	MOCK_LOCK;
+
+	if (!is_action_set(actionSet)) {
+		return XR_ERROR_HANDLE_INVALID;
+	}
+
+	MockActionSet *action_set = from_handle<MockActionSet>(actionSet);
+	for (MockAction *action : action_set->actions) {
+		// remove any bindings to this action
+		for (MockInteractionProfile &profile : mock_instance->suggested_profiles) {
+			for (size_t i = profile.bindings.size(); i > 0; i--) {
+				if (profile.bindings[i - 1].action == action) {
+					profile.bindings.erase(profile.bindings.begin() + (i - 1));
+				}
+			}
+		}
+
+		// and clear out action spaces that point to it
+		if (mock_instance->session != nullptr) {
+			for (MockSpace *space : mock_instance->session->spaces) {
+				if (space->action == action) {
+					space->action = nullptr;
+				}
+			}
+		}
+
+		delete action;
+	}
+
+	for (size_t i = 0; i < mock_instance->action_sets.size(); i++) {
+		if (mock_instance->action_sets[i] == action_set) {
+			mock_instance->action_sets.erase(mock_instance->action_sets.begin() + i);
+			break;
+		}
+	}
+
+	delete action_set;
+	return XR_SUCCESS;
+}
+
+static XrResult XRAPI_CALL mock_xrCreateAction(XrActionSet actionSet, const XrActionCreateInfo *createInfo, XrAction *action) {
+	MOCK_LOCK;
+
+	if (!is_action_set(actionSet)) {
+		return XR_ERROR_HANDLE_INVALID;
+	} else if (createInfo == nullptr || action == nullptr) {
+		return XR_ERROR_VALIDATION_FAILURE;
+	} else if (createInfo->actionName[0] == '\0') {
+		return XR_ERROR_NAME_INVALID;
+	} else if (createInfo->localizedActionName[0] == '\0') {
+		return XR_ERROR_LOCALIZED_NAME_INVALID;
+	}
+
+	MockActionSet *action_set = from_handle<MockActionSet>(actionSet);
+	if (action_set->attached) {
+		return XR_ERROR_ACTIONSETS_ALREADY_ATTACHED;
+	}
+
+	for (MockAction *existing : action_set->actions) {
+		if (existing->name == createInfo->actionName) {
+			return XR_ERROR_NAME_DUPLICATED;
+		}
+	}
+
+	MockAction *new_action = new MockAction();
+	new_action->action_set = action_set;
+	new_action->name = createInfo->actionName;
+	new_action->type = createInfo->actionType;
+	for (uint32_t i = 0; i < createInfo->countSubactionPaths; i++) {
+		const XrPath path = createInfo->subactionPaths[i];
+		if (path == XR_NULL_PATH || path > mock_instance->paths.size()) {
+			delete new_action;
+			return XR_ERROR_PATH_INVALID;
+		}
+		new_action->subaction_paths.push_back(path);
+	}
+	action_set->actions.push_back(new_action);
+
+	*action = to_handle<XrAction>(new_action);
+	return XR_SUCCESS;
+}
+
+static XrResult XRAPI_CALL mock_xrDestroyAction(XrAction action) {
+	MOCK_LOCK;
+
+	if (!is_action(action)) {
+		return XR_ERROR_HANDLE_INVALID;
+	}
+
+	// We keep our action around until its action set is destroyed, bindings and spaces may still use it.
+	return XR_SUCCESS;
+}
+
+static XrResult XRAPI_CALL mock_xrSuggestInteractionProfileBindings(XrInstance instance, const XrInteractionProfileSuggestedBinding *suggestedBindings) {
+	MOCK_LOCK;
+
+	if (!is_instance(instance)) {
+		return XR_ERROR_HANDLE_INVALID;
+	} else if (suggestedBindings == nullptr || suggestedBindings->countSuggestedBindings == 0 || suggestedBindings->suggestedBindings == nullptr) {
+		return XR_ERROR_VALIDATION_FAILURE;
+	}
+
+	const std::string &profile_name = get_path_string(suggestedBindings->interactionProfile);
+	if (profile_name.compare(0, 22, "/interaction_profiles/") != 0) {
+		return XR_ERROR_PATH_UNSUPPORTED;
+	}
+
+	MockInteractionProfile profile;
+	profile.path = suggestedBindings->interactionProfile;
+
+	for (uint32_t i = 0; i < suggestedBindings->countSuggestedBindings; i++) {
+		const XrActionSuggestedBinding &binding = suggestedBindings->suggestedBindings[i];
+		if (!is_action(binding.action)) {
+			return XR_ERROR_HANDLE_INVALID;
+		}
+
+		MockAction *action = from_handle<MockAction>(binding.action);
+		if (action->action_set->attached) {
+			return XR_ERROR_ACTIONSETS_ALREADY_ATTACHED;
+		}
+
+		const std::string &path = get_path_string(binding.binding);
+		if (path.compare(0, 6, "/user/") != 0) {
+			return XR_ERROR_PATH_UNSUPPORTED;
+		}
+
+		MockBinding mock_binding;
+		mock_binding.action = action;
+		mock_binding.path = binding.binding;
+		mock_binding.toplevel_path = get_toplevel_path(path);
+		mock_binding.phase = 0;
+		for (char c : path) {
+			mock_binding.phase += (unsigned char)c;
+		}
+		mock_binding.phase = mock_binding.phase % 240;
+		profile.bindings.push_back(mock_binding);
+	}
+
+	// a new suggestion replaces the previous one for this profile
+	for (MockInteractionProfile &existing : mock_instance->suggested_profiles) {
+		if (existing.path == profile.path) {
+			existing = profile;
+			return XR_SUCCESS;
+		}
+	}
+
+	mock_instance->suggested_profiles.push_back(profile);
+	return XR_SUCCESS;
+}
+
+static const MockInteractionProfile *find_suggested_profile(XrPath p_profile) {
+	for (const MockInteractionProfile &profile : mock_instance->suggested_profiles) {
+		if (profile.path == p_profile) {
+			return &profile;
+		}
+	}
+
+	return nullptr;
+}
+
+static XrResult XRAPI_CALL mock_xrAttachSessionActionSets(XrSession session, const XrSessionActionSetsAttachInfo *attachInfo) {
+	MOCK_LOCK;
+
+	if (!is_session(session)) {
+		return XR_ERROR_HANDLE_INVALID;
+	} else if (attachInfo == nullptr || attachInfo->countActionSets == 0 || attachInfo->actionSets == nullptr) {
+		return XR_ERROR_VALIDATION_FAILURE;
+	}
+
+	MockSession *mock_session = from_handle<MockSession>(session);
+	if (mock_session->actions_attached) {
+		return XR_ERROR_ACTIONSETS_ALREADY_ATTACHED;
+	}
+
+	for (uint32_t i = 0; i < attachInfo->countActionSets; i++) {
+		if (!is_action_set(attachInfo->actionSets[i])) {
+			return XR_ERROR_HANDLE_INVALID;
+		}
+	}
+
+	for (uint32_t i = 0; i < attachInfo->countActionSets; i++) {
+		from_handle<MockActionSet>(attachInfo->actionSets[i])->attached = true;
+	}
+	mock_session->actions_attached = true;
+
+	// Pick the interaction profile for each top level path we have bindings for
+	const char *forced_profile = getenv("OPENXR_MOCK_INTERACTION_PROFILE");
+	const MockInteractionProfile *forced = forced_profile != nullptr && is_valid_path_string(forced_profile) ? find_suggested_profile(get_path(forced_profile)) : nullptr;
+
+	for (const MockInteractionProfile &profile : mock_instance->suggested_profiles) {
+		if (forced != nullptr && &profile != forced) {
+			continue;
+		}
+
+		for (const MockBinding &binding : profile.bindings) {
+			if (binding.action->action_set->attached && mock_session->current_profiles.find(binding.toplevel_path) == mock_session->current_profiles.end()) {
+				mock_session->current_profiles[binding.toplevel_path] = profile.path;
+			}
+		}
+	}
+
+	if (!mock_session->current_profiles.empty()) {
+		XrEventDataInteractionProfileChanged event = {
+			XR_TYPE_EVENT_DATA_INTERACTION_PROFILE_CHANGED,
+			nullptr,
+			session
+		};
+		queue_event(&event, sizeof(event));
+	}
+
+	return XR_SUCCESS;
+}
+
+static XrResult XRAPI_CALL mock_xrGetCurrentInteractionProfile(XrSession session, XrPath topLevelUserPath, XrInteractionProfileState *interactionProfile) {
+	MOCK_LOCK;
+
+	if (!is_session(session)) {
+		return XR_ERROR_HANDLE_INVALID;
+	} else if (interactionProfile == nullptr) {
+		return XR_ERROR_VALIDATION_FAILURE;
+	}
+
+	MockSession *mock_session = from_handle<MockSession>(session);
+	if (!mock_session->actions_attached) {
+		return XR_ERROR_ACTIONSET_NOT_ATTACHED;
+	} else if (get_path_string(topLevelUserPath).compare(0, 6, "/user/") != 0) {
+		return XR_ERROR_PATH_UNSUPPORTED;
+	}
+
+	std::map<XrPath, XrPath>::const_iterator it = mock_session->current_profiles.find(topLevelUserPath);
+	interactionProfile->interactionProfile = it != mock_session->current_profiles.end() ? it->second : XR_NULL_PATH;
+	return XR_SUCCESS;
+}
+
+static XrResult XRAPI_CALL mock_xrSyncActions(XrSession session, const XrActionsSyncInfo *syncInfo) {
+	MOCK_LOCK;
+
+	if (!is_session(session)) {
+		return XR_ERROR_HANDLE_INVALID;
+	} else if (syncInfo == nullptr || (syncInfo->countActiveActionSets > 0 && syncInfo->activeActionSets == nullptr)) {
+		return XR_ERROR_VALIDATION_FAILURE;
+	}
+
+	MockSession *mock_session = from_handle<MockSession>(session);
+	for (uint32_t i = 0; i < syncInfo->countActiveActionSets; i++) {
+		const XrActiveActionSet &active = syncInfo->activeActionSets[i];
+		if (!is_action_set(active.actionSet)) {
+			return XR_ERROR_HANDLE_INVALID;
+		}
+
+		MockActionSet *action_set = from_handle<MockActionSet>(active.actionSet);
+		if (!action_set->attached) {
+			return XR_ERROR_ACTIONSET_NOT_ATTACHED;
+		}
+
+		if (active.subactionPath != XR_NULL_PATH) {
+			// must be used by at least one action in the set
+			bool used = false;
+			for (MockAction *action : action_set->actions) {
+				for (XrPath path : action->subaction_paths) {
+					used = used || path == active.subactionPath;
+				}
+			}
+			if (!used) {
+				return XR_ERROR_PATH_UNSUPPORTED;
+			}
+		}
+	}
+
+	mock_session->active_action_sets.assign(syncInfo->activeActionSets, syncInfo->activeActionSets + syncInfo->countActiveActionSets);
+	if (mock_session->state != XR_SESSION_STATE_FOCUSED) {
+		// our actions are all inactive
+		mock_session->active_action_sets.clear();
+		return XR_SESSION_NOT_FOCUSED;
+	}
+
+	mock_session->sync_count++;
+	return XR_SUCCESS;
+}
+
+// Is this binding in use for our action in our last sync?
+bool is_binding_active(const MockSession *p_session, const MockBinding &p_binding, XrPath p_subaction_path) {
+	if (p_subaction_path != XR_NULL_PATH && p_binding.toplevel_path != p_subaction_path) {
+		return false;
+	}
+
+	std::map<XrPath, XrPath>::const_iterator it = p_session->current_profiles.find(p_binding.toplevel_path);
+	if (it == p_session->current_profiles.end()) {
+		return false;
+	}
+
+	for (const XrActiveActionSet &active : p_session->active_action_sets) {
+		if (from_handle<MockActionSet>(active.actionSet) == p_binding.action->action_set && (active.subactionPath == XR_NULL_PATH || active.subactionPath == p_binding.toplevel_path)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+// Gathers the bindings that feed our action state, returns an error if our request is invalid
+static XrResult get_active_bindings(XrSession p_session, const XrActionStateGetInfo *p_get_info, XrActionType p_type, std::vector<const MockBinding *> &r_bindings) {
+	if (!is_session(p_session)) {
+		return XR_ERROR_HANDLE_INVALID;
+	} else if (p_get_info == nullptr) {
+		return XR_ERROR_VALIDATION_FAILURE;
+	} else if (!is_action(p_get_info->action)) {
+		return XR_ERROR_HANDLE_INVALID;
+	}
+
+	MockSession *mock_session = from_handle<MockSession>(p_session);
+	MockAction *action = from_handle<MockAction>(p_get_info->action);
+	if (!action->action_set->attached) {
+		return XR_ERROR_ACTIONSET_NOT_ATTACHED;
+	} else if (action->type != p_type) {
+		return XR_ERROR_ACTION_TYPE_MISMATCH;
+	}
+
+	if (p_get_info->subactionPath != XR_NULL_PATH) {
+		bool found = false;
+		for (XrPath path : action->subaction_paths) {
+			found = found || path == p_get_info->subactionPath;
+		}
+		if (!found) {
+			return XR_ERROR_PATH_UNSUPPORTED;
+		}
+	}
+
+	for (const MockInteractionProfile &profile : mock_instance->suggested_profiles) {
+		for (const MockBinding &binding : profile.bindings) {
+			if (binding.action == action && is_binding_active(mock_session, binding, p_get_info->subactionPath)) {
+				std::map<XrPath, XrPath>::const_iterator it = mock_session->current_profiles.find(binding.toplevel_path);
+				if (it->second == profile.path) {
+					r_bindings.push_back(&binding);
+				}
+			}
+		}
+	}
+
+	return XR_SUCCESS;
+}
+
+static XrResult XRAPI_CALL mock_xrGetActionStateBoolean(XrSession session, const XrActionStateGetInfo *getInfo, XrActionStateBoolean *state) {
+	MOCK_LOCK;
+
+	std::vector<const MockBinding *> bindings;
+	XrResult result = get_active_bindings(session, getInfo, XR_ACTION_TYPE_BOOLEAN_INPUT, bindings);
+	if (result != XR_SUCCESS) {
+		return result;
+	} else if (state == nullptr) {
+		return XR_ERROR_VALIDATION_FAILURE;
+	}
+
+	const MockSession *mock_session = from_handle<MockSession>(session);
+	const uint64_t frame = mock_session->sync_count;
+	bool current = false;
+	bool previous = false;
+	for (const MockBinding *binding : bindings) {
+		current = current || get_scripted_bool(frame, binding->phase);
+		previous = previous || get_scripted_bool(frame - 1, binding->phase);
+	}
+
+	state->isActive = bindings.empty() ? XR_FALSE : XR_TRUE;
+	state->currentState = current ? XR_TRUE : XR_FALSE;
+	state->changedSinceLastSync = state->isActive && current != previous ? XR_TRUE : XR_FALSE;
+	state->lastChangeTime = state->changedSinceLastSync ? mock_session->display_time : 0;
+	return XR_SUCCESS;
+}
+
+static XrResult XRAPI_CALL mock_xrGetActionStateFloat(XrSession session, const XrActionStateGetInfo *getInfo, XrActionStateFloat *state) {
+	MOCK_LOCK;
+
+	std::vector<const MockBinding *> bindings;
+	XrResult result = get_active_bindings(session, getInfo, XR_ACTION_TYPE_FLOAT_INPUT, bindings);
+	if (result != XR_SUCCESS) {
+		return result;
+	} else if (state == nullptr) {
+		return XR_ERROR_VALIDATION_FAILURE;
+	}
+
+	const MockSession *mock_session = from_handle<MockSession>(session);
+	const uint64_t frame = mock_session->sync_count;
+	float current = 0.0f;
+	float previous = 0.0f;
+	for (const MockBinding *binding : bindings) {
+		// largest absolute value wins
+		current = (std::max)(current, get_scripted_float(frame, binding->phase));
+		previous = (std::max)(previous, get_scripted_float(frame - 1, binding->phase));
+	}
+
+	state->isActive = bindings.empty() ? XR_FALSE : XR_TRUE;
+	state->currentState = current;
+	state->changedSinceLastSync = state->isActive && current != previous ? XR_TRUE : XR_FALSE;
+	state->lastChangeTime = state->changedSinceLastSync ? mock_session->display_time : 0;
+	return XR_SUCCESS;
+}
+
+static XrResult XRAPI_CALL mock_xrGetActionStateVector2f(XrSession session, const XrActionStateGetInfo *getInfo, XrActionStateVector2f *state) {
+	MOCK_LOCK;
+
+	std::vector<const MockBinding *> bindings;
+	XrResult result = get_active_bindings(session, getInfo, XR_ACTION_TYPE_VECTOR2F_INPUT, bindings);
+	if (result != XR_SUCCESS) {
+		return result;
+	} else if (state == nullptr) {
+		return XR_ERROR_VALIDATION_FAILURE;
+	}
+
+	const MockSession *mock_session = from_handle<MockSession>(session);
+	const uint64_t frame = mock_session->sync_count;
+	XrVector2f current = { 0.0f, 0.0f };
+	XrVector2f previous = { 0.0f, 0.0f };
+	if (!bindings.empty()) {
+		// we just use our first binding
+		current = get_scripted_vector2(frame, bindings[0]->phase);
+		previous = get_scripted_vector2(frame - 1, bindings[0]->phase);
+	}
+
+	state->isActive = bindings.empty() ? XR_FALSE : XR_TRUE;
+	state->currentState = current;
+	state->changedSinceLastSync = state->isActive && (current.x != previous.x || current.y != previous.y) ? XR_TRUE : XR_FALSE;
+	state->lastChangeTime = state->changedSinceLastSync ? mock_session->display_time : 0;
+	return XR_SUCCESS;
+}
+
+static XrResult XRAPI_CALL mock_xrGetActionStatePose(XrSession session, const XrActionStateGetInfo *getInfo, XrActionStatePose *state) {
+	MOCK_LOCK;
+
+	std::vector<const MockBinding *> bindings;
+	XrResult result = get_active_bindings(session, getInfo, XR_ACTION_TYPE_POSE_INPUT, bindings);
+	if (result != XR_SUCCESS) {
+		return result;
+	} else if (state == nullptr) {
+		return XR_ERROR_VALIDATION_FAILURE;
+	}
+
+	state->isActive = bindings.empty() ? XR_FALSE : XR_TRUE;
+	return XR_SUCCESS;
+}
+
+static XrResult XRAPI_CALL mock_xrEnumerateBoundSourcesForAction(XrSession session, const XrBoundSourcesForActionEnumerateInfo *enumerateInfo, uint32_t sourceCapacityInput, uint32_t *sourceCountOutput, XrPath *sources) {
+	MOCK_LOCK;
+
+	if (!is_session(session)) {
+		return XR_ERROR_HANDLE_INVALID;
+	} else if (enumerateInfo == nullptr) {
+		return XR_ERROR_VALIDATION_FAILURE;
+	} else if (!is_action(enumerateInfo->action)) {
+		return XR_ERROR_HANDLE_INVALID;
+	}
+
+	MockSession *mock_session = from_handle<MockSession>(session);
+	MockAction *action = from_handle<MockAction>(enumerateInfo->action);
+	if (!action->action_set->attached) {
+		return XR_ERROR_ACTIONSET_NOT_ATTACHED;
+	}
+
+	std::vector<XrPath> bound;
+	for (const MockInteractionProfile &profile : mock_instance->suggested_profiles) {
+		for (const MockBinding &binding : profile.bindings) {
+			std::map<XrPath, XrPath>::const_iterator it = mock_session->current_profiles.find(binding.toplevel_path);
+			if (binding.action == action && it != mock_session->current_profiles.end() && it->second == profile.path) {
+				bound.push_back(binding.path);
+			}
+		}
+	}
+
+	return copy_array(bound, sourceCapacityInput, sourceCountOutput, sources);
+}
+
+static XrResult XRAPI_CALL mock_xrGetInputSourceLocalizedName(XrSession session, const XrInputSourceLocalizedNameGetInfo *getInfo, uint32_t bufferCapacityInput, uint32_t *bufferCountOutput, char *buffer) {
+	MOCK_LOCK;
+
+	if (!is_session(session)) {
+		return XR_ERROR_HANDLE_INVALID;
+	} else if (getInfo == nullptr || getInfo->whichComponents == 0) {
+		return XR_ERROR_VALIDATION_FAILURE;
+	} else if (getInfo->sourcePath == XR_NULL_PATH || getInfo->sourcePath > mock_instance->paths.size()) {
+		return XR_ERROR_PATH_INVALID;
+	}
+
+	// we don't localize, our path will do
+	return copy_string(get_path_string(getInfo->sourcePath), bufferCapacityInput, bufferCountOutput, buffer);
+}
+
+static XrResult get_haptic_action(XrSession p_session, const XrHapticActionInfo *p_haptic_action_info) {
+	if (!is_session(p_session)) {
+		return XR_ERROR_HANDLE_INVALID;
+	} else if (p_haptic_action_info == nullptr) {
+		return XR_ERROR_VALIDATION_FAILURE;
+	} else if (!is_action(p_haptic_action_info->action)) {
+		return XR_ERROR_HANDLE_INVALID;
+	}
+
+	MockAction *action = from_handle<MockAction>(p_haptic_action_info->action);
+	if (!action->action_set->attached) {
+		return XR_ERROR_ACTIONSET_NOT_ATTACHED;
+	} else if (action->type != XR_ACTION_TYPE_VIBRATION_OUTPUT) {
+		return XR_ERROR_ACTION_TYPE_MISMATCH;
+	}
+
+	return from_handle<MockSession>(p_session)->state == XR_SESSION_STATE_FOCUSED ? XR_SUCCESS : XR_SESSION_NOT_FOCUSED;
+}
+
+static XrResult XRAPI_CALL mock_xrApplyHapticFeedback(XrSession session, const XrHapticActionInfo *hapticActionInfo, const XrHapticBaseHeader *hapticFeedback) {
+	MOCK_LOCK;
+
+	if (hapticFeedback == nullptr) {
+		return XR_ERROR_VALIDATION_FAILURE;
+	}
+
+	// there is nothing to vibrate
+	return get_haptic_action(session, hapticActionInfo);
+}
+
+static XrResult XRAPI_CALL mock_xrStopHapticFeedback(XrSession session, const XrHapticActionInfo *hapticActionInfo) {
+	MOCK_LOCK;
+
+	return get_haptic_action(session, hapticActionInfo);
+}
+
+// Our hand for an action space, which is the first hand that is bound
+bool get_action_space_hand(const MockSession *p_session, const MockSpace *p_space, XrHandEXT &r_hand) {
+	if (p_space->action == nullptr) {
+		return false;
+	}
+
+	for (const MockInteractionProfile &profile : mock_instance->suggested_profiles) {
+		for (const MockBinding &binding : profile.bindings) {
+			if (binding.action != p_space->action || !is_binding_active(p_session, binding, p_space->subaction_path)) {
+				continue;
+			}
+
+			std::map<XrPath, XrPath>::const_iterator it = p_session->current_profiles.find(binding.toplevel_path);
+			if (it->second != profile.path) {
+				continue;
+			}
+
+			const std::string &toplevel = get_path_string(binding.toplevel_path);
+			if (toplevel == "/user/hand/left") {
+				r_hand = XR_HAND_LEFT_EXT;
+				return true;
+			} else if (toplevel == "/user/hand/right") {
+				r_hand = XR_HAND_RIGHT_EXT;
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+const MockFunction mock_action_functions[] = {
+	MOCK_FUNCTION(xrCreateActionSet),
+	MOCK_FUNCTION(xrDestroyActionSet),
+	MOCK_FUNCTION(xrCreateAction),
+	MOCK_FUNCTION(xrDestroyAction),
+	MOCK_FUNCTION(xrSuggestInteractionProfileBindings),
+	MOCK_FUNCTION(xrAttachSessionActionSets),
+	MOCK_FUNCTION(xrGetCurrentInteractionProfile),
+	MOCK_FUNCTION(xrGetActionStateBoolean),
+	MOCK_FUNCTION(xrGetActionStateFloat),
+	MOCK_FUNCTION(xrGetActionStateVector2f),
+	MOCK_FUNCTION(xrGetActionStatePose),
+	MOCK_FUNCTION(xrSyncActions),
+	MOCK_FUNCTION(xrEnumerateBoundSourcesForAction),
+	MOCK_FUNCTION(xrGetInputSourceLocalizedName),
+	MOCK_FUNCTION(xrApplyHapticFeedback),
+	MOCK_FUNCTION(xrStopHapticFeedback),
+};
+const uint32_t mock_action_function_count = MOCK_FUNCTION_COUNT(mock_action_functions);
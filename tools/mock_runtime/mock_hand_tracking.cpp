@@ -0,0 +1,146 @@
+#include "mock_runtime.h"
+
+#include <math.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// XR_EXT_hand_tracking
+
+static bool is_hand_tracker(XrHandTrackerEXT p_hand_tracker) {
+	if (mock_instance == nullptr || mock_instance->session == nullptr) {
+		return false;
+	}
+
+	for (MockHandTracker *hand_tracker : mock_instance->session->hand_trackers) {
+		if (from_handle<MockHandTracker>(p_hand_tracker) == hand_tracker) {
+			return true;
+		}
+	}
+	return false;
+}
+
+static XrResult XRAPI_CALL mock_xrCreateHandTrackerEXT(XrSession session, const XrHandTrackerCreateInfoEXT *createInfo, XrHandTrackerEXT *handTracker) {
+	MOCK_LOCK;
+
+	if (!is_session(session)) {
+		return XR_ERROR_HANDLE_INVALID;
+	} else if (createInfo == nullptr || handTracker == nullptr) {
+		return XR_ERROR_VALIDATION_FAILURE;
+	} else if (createInfo->hand != XR_HAND_LEFT_EXT && createInfo->hand != XR_HAND_RIGHT_EXT) {
+		return XR_ERROR_VALIDATION_FAILURE;
+	} else if (createInfo->handJointSet != XR_HAND_JOINT_SET_DEFAULT_EXT) {
+		return XR_ERROR_VALIDATION_FAILURE;
+	}
+
+	MockHandTracker *new_hand_tracker = new MockHandTracker();
+	new_hand_tracker->hand = createInfo->hand;
+	from_handle<MockSession>(session)->hand_trackers.push_back(new_hand_tracker);
+
+	*handTracker = to_handle<XrHandTrackerEXT>(new_hand_tracker);
+	return XR_SUCCESS;
+}
+
+static XrResult XRAPI_CALL mock_xrDestroyHandTrackerEXT(XrHandTrackerEXT handTracker) {
+	MOCK_LOCK;
+
+	if (!is_hand_tracker(handTracker)) {
+		return XR_ERROR_HANDLE_INVALID;
+	}
+
+	std::vector<MockHandTracker *> &hand_trackers = mock_instance->session->hand_trackers;
+	for (size_t i = 0; i < hand_trackers.size(); i++) {
+		if (hand_trackers[i] == from_handle<MockHandTracker>(handTracker)) {
+			delete hand_trackers[i];
+			hand_trackers.erase(hand_trackers.begin() + i);
+			break;
+		}
+	}
+	return XR_SUCCESS;
+}
+
+// Joint position relative to our palm, our fingers point along -Z and curl over time
+static XrVector3f get_joint_offset(uint32_t p_joint, float p_side, float p_curl) {
+	if (p_joint == XR_HAND_JOINT_PALM_EXT) {
+		return XrVector3f{ 0.0f, 0.0f, 0.0f };
+	} else if (p_joint == XR_HAND_JOINT_WRIST_EXT) {
+		return XrVector3f{ 0.0f, 0.0f, 0.06f };
+	}
+
+	// thumb has 4 joints starting at XR_HAND_JOINT_THUMB_METACARPAL_EXT, the other fingers have 5
+	uint32_t finger;
+	uint32_t bone;
+	if (p_joint <= XR_HAND_JOINT_THUMB_TIP_EXT) {
+		finger = 0;
+		bone = p_joint - XR_HAND_JOINT_THUMB_METACARPAL_EXT + 1;
+	} else {
+		finger = 1 + (p_joint - XR_HAND_JOINT_INDEX_METACARPAL_EXT) / 5;
+		bone = (p_joint - XR_HAND_JOINT_INDEX_METACARPAL_EXT) % 5;
+	}
+
+	const float x = p_side * (-0.04f + 0.02f * float(finger));
+	const float length = 0.025f * float(bone);
+	return XrVector3f{ x, -length * p_curl * 0.5f, 0.03f - length * (1.0f - 0.3f * p_curl) };
+}
+
+static XrResult XRAPI_CALL mock_xrLocateHandJointsEXT(XrHandTrackerEXT handTracker, const XrHandJointsLocateInfoEXT *locateInfo, XrHandJointLocationsEXT *locations) {
+	MOCK_LOCK;
+
+	if (!is_hand_tracker(handTracker)) {
+		return XR_ERROR_HANDLE_INVALID;
+	} else if (locateInfo == nullptr || locations == nullptr || locations->jointLocations == nullptr) {
+		return XR_ERROR_VALIDATION_FAILURE;
+	} else if (locations->jointCount != XR_HAND_JOINT_COUNT_EXT) {
+		return XR_ERROR_VALIDATION_FAILURE;
+	} else if (locateInfo->time <= 0) {
+		return XR_ERROR_TIME_INVALID;
+	} else if (!is_space(locateInfo->baseSpace)) {
+		return XR_ERROR_HANDLE_INVALID;
+	}
+
+	const MockSession *mock_session = mock_instance->session;
+	const MockHandTracker *hand_tracker = from_handle<MockHandTracker>(handTracker);
+
+	XrHandJointVelocitiesEXT *velocities = find_next<XrHandJointVelocitiesEXT>(locations->next, XR_TYPE_HAND_JOINT_VELOCITIES_EXT);
+
+	XrPosef base_pose;
+	const bool active = mock_session->state == XR_SESSION_STATE_FOCUSED && get_space_pose(mock_session, from_handle<MockSpace>(locateInfo->baseSpace), locateInfo->time, base_pose);
+	locations->isActive = active ? XR_TRUE : XR_FALSE;
+
+	const XrPosef hand = active ? pose_multiply(pose_inverse(base_pose), get_hand_pose(hand_tracker->hand, locateInfo->time)) : identity_pose;
+	const float side = hand_tracker->hand == XR_HAND_LEFT_EXT ? -1.0f : 1.0f;
+	const float curl = 0.5f - 0.5f * cosf(seconds_at(locateInfo->time));
+
+	for (uint32_t i = 0; i < XR_HAND_JOINT_COUNT_EXT; i++) {
+		XrHandJointLocationEXT &joint = locations->jointLocations[i];
+		if (!active) {
+			joint.locationFlags = 0;
+			continue;
+		}
+
+		const XrPosef offset = { identity_pose.orientation, get_joint_offset(i, side, curl) };
+		joint.pose = pose_multiply(hand, offset);
+		joint.radius = i == XR_HAND_JOINT_PALM_EXT || i == XR_HAND_JOINT_WRIST_EXT ? 0.02f : 0.008f;
+		joint.locationFlags = XR_SPACE_LOCATION_ORIENTATION_VALID_BIT | XR_SPACE_LOCATION_POSITION_VALID_BIT | XR_SPACE_LOCATION_ORIENTATION_TRACKED_BIT | XR_SPACE_LOCATION_POSITION_TRACKED_BIT;
+	}
+
+	if (velocities != nullptr) {
+		if (velocities->jointCount != XR_HAND_JOINT_COUNT_EXT || velocities->jointVelocities == nullptr) {
+			return XR_ERROR_VALIDATION_FAILURE;
+		}
+
+		for (uint32_t i = 0; i < XR_HAND_JOINT_COUNT_EXT; i++) {
+			XrHandJointVelocityEXT &velocity = velocities->jointVelocities[i];
+			velocity.velocityFlags = active ? XR_SPACE_VELOCITY_LINEAR_VALID_BIT | XR_SPACE_VELOCITY_ANGULAR_VALID_BIT : 0;
+			velocity.linearVelocity = { 0.0f, 0.0f, 0.0f };
+			velocity.angularVelocity = { 0.0f, 0.0f, 0.0f };
+		}
+	}
+
+	return XR_SUCCESS;
+}
+
+const MockFunction mock_hand_tracking_functions[] = {
+	MOCK_EXTENSION_FUNCTION(xrCreateHandTrackerEXT, hand_tracking_ext),
+	MOCK_EXTENSION_FUNCTION(xrDestroyHandTrackerEXT, hand_tracking_ext),
+	MOCK_EXTENSION_FUNCTION(xrLocateHandJointsEXT, hand_tracking_ext),
+};
+const uint32_t mock_hand_tracking_function_count = MOCK_FUNCTION_COUNT(mock_hand_tracking_functions);
@@ -0,0 +1,395 @@
+#include "mock_runtime.h"
+
+#include <openxr/openxr_reflection.h>
+
+#include <stdio.h>
+
+bool is_instance(XrInstance p_instance) {
+	return mock_instance != nullptr && from_handle<MockInstance>(p_instance) == mock_instance;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Paths
+
+XrPath get_path(const std::string &p_string) {
+	std::map<std::string, XrPath>::iterator it = mock_instance->path_ids.find(p_string);
+	if (it != mock_instance->path_ids.end()) {
+		return it->second;
+	}
+
+	mock_instance->paths.push_back(p_string);
+	XrPath path = (XrPath)mock_instance->paths.size();
+	mock_instance->path_ids[p_string] = path;
+	return path;
+}
+
+const std::string &get_path_string(XrPath p_path) {
+	static const std::string empty;
+	if (p_path == XR_NULL_PATH || p_path > mock_instance->paths.size()) {
+		return empty;
+	}
+
+	return mock_instance->paths[p_path - 1];
+}
+
+bool is_valid_path_string(const char *p_string) {
+	if (p_string == nullptr || p_string[0] != '/' || strlen(p_string) >= XR_MAX_PATH_LENGTH) {
+		return false;
+	}
+
+	for (const char *c = p_string; *c != '\0'; c++) {
+		const bool valid = (*c >= 'a' && *c <= 'z') || (*c >= '0' && *c <= '9') || *c == '-' || *c == '_' || *c == '.' || *c == '/';
+		if (!valid || (c[0] == '/' && (c[1] == '/' || c[1] == '\0'))) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+XrPath get_toplevel_path(const std::string &p_binding) {
+	// everything in front of /input or /output
+	size_t pos = p_binding.find("/input/");
+	if (pos == std::string::npos) {
+		pos = p_binding.find("/output/");
+	}
+
+	return get_path(pos == std::string::npos ? p_binding : p_binding.substr(0, pos));
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Events
+
+void queue_event(const void *p_event, size_t p_size) {
+	XrEventDataBuffer buffer = {};
+	memcpy(&buffer, p_event, p_size);
+	mock_instance->events.push_back(buffer);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Instance
+
+struct MockExtension {
+	const char *name;
+	uint32_t spec_version;
+	bool MockInstance::*enabled;
+};
+
+static const MockExtension supported_extensions[] = {
+	{ XR_MND_HEADLESS_EXTENSION_NAME, XR_MND_headless_SPEC_VERSION, &MockInstance::headless_ext },
+	{ XR_KHR_OPENGL_ENABLE_EXTENSION_NAME, XR_KHR_opengl_enable_SPEC_VERSION, &MockInstance::opengl_ext },
+	{ XR_EXT_HAND_TRACKING_EXTENSION_NAME, XR_EXT_hand_tracking_SPEC_VERSION, &MockInstance::hand_tracking_ext },
+	{ XR_MSFT_SPATIAL_ANCHOR_EXTENSION_NAME, XR_MSFT_spatial_anchor_SPEC_VERSION, &MockInstance::spatial_anchor_ext },
+	{ XR_FB_SPACE_WARP_EXTENSION_NAME, XR_FB_space_warp_SPEC_VERSION, &MockInstance::space_warp_ext },
+	{ XR_FB_DISPLAY_REFRESH_RATE_EXTENSION_NAME, XR_FB_display_refresh_rate_SPEC_VERSION, &MockInstance::display_refresh_rate_ext },
+};
+
+static XrResult XRAPI_CALL mock_xrEnumerateInstanceExtensionProperties(const char *layerName, uint32_t propertyCapacityInput, uint32_t *propertyCountOutput, XrExtensionProperties *properties) {
+	if (layerName != nullptr) {
+		return XR_ERROR_API_LAYER_NOT_PRESENT;
+	}
+
+	std::vector<XrExtensionProperties> extensions;
+	for (const MockExtension &extension : supported_extensions) {
+		XrExtensionProperties properties = { XR_TYPE_EXTENSION_PROPERTIES, nullptr, "", extension.spec_version };
+		snprintf(properties.extensionName, XR_MAX_EXTENSION_NAME_SIZE, "%s", extension.name);
+		extensions.push_back(properties);
+	}
+	return copy_array(extensions, propertyCapacityInput, propertyCountOutput, properties);
+}
+
+static XrResult XRAPI_CALL mock_xrEnumerateApiLayerProperties(uint32_t propertyCapacityInput, uint32_t *propertyCountOutput, XrApiLayerProperties *properties) {
+	// API layers are handled by the loader
+	std::vector<XrApiLayerProperties> layers;
+	return copy_array(layers, propertyCapacityInput, propertyCountOutput, properties);
+}
+
+static XrResult XRAPI_CALL mock_xrCreateInstance(const XrInstanceCreateInfo *createInfo, XrInstance *instance) {
+	MOCK_LOCK;
+
+	if (createInfo == nullptr || instance == nullptr || createInfo->type != XR_TYPE_INSTANCE_CREATE_INFO) {
+		return XR_ERROR_VALIDATION_FAILURE;
+	} else if (XR_VERSION_MAJOR(createInfo->applicationInfo.apiVersion) != 1) {
+		return XR_ERROR_API_VERSION_UNSUPPORTED;
+	} else if (mock_instance != nullptr) {
+		// we only support one instance at a time
+		return XR_ERROR_LIMIT_REACHED;
+	}
+
+	MockInstance *new_instance = new MockInstance();
+	for (uint32_t i = 0; i < createInfo->enabledExtensionCount; i++) {
+		const char *name = createInfo->enabledExtensionNames[i];
+		const MockExtension *found = nullptr;
+		for (const MockExtension &extension : supported_extensions) {
+			if (strcmp(name, extension.name) == 0) {
+				found = &extension;
+			}
+		}
+
+		if (found == nullptr) {
+			delete new_instance;
+			return XR_ERROR_EXTENSION_NOT_PRESENT;
+		}
+		new_instance->*found->enabled = true;
+	}
+
+	mock_instance = new_instance;
+	*instance = to_handle<XrInstance>(mock_instance);
+	return XR_SUCCESS;
+}
+
+static XrResult XRAPI_CALL mock_xrDestroyInstance(XrInstance instance) {
+	MOCK_LOCK;
+
+	if (!is_instance(instance)) {
+		return XR_ERROR_HANDLE_INVALID;
+	}
+
+	// anything the application didn't destroy itself isn't counted in our report
+	write_report(mock_instance->report);
+
+	if (mock_instance->session != nullptr) {
+		destroy_session(mock_instance->session);
+	}
+
+	destroy_action_sets();
+
+	delete mock_instance;
+	mock_instance = nullptr;
+	return XR_SUCCESS;
+}
+
+static XrResult XRAPI_CALL mock_xrGetInstanceProperties(XrInstance instance, XrInstanceProperties *instanceProperties) {
+	MOCK_LOCK;
+
+	if (!is_instance(instance)) {
+		return XR_ERROR_HANDLE_INVALID;
+	} else if (instanceProperties == nullptr) {
+		return XR_ERROR_VALIDATION_FAILURE;
+	}
+
+	instanceProperties->runtimeVersion = XR_MAKE_VERSION(1, 0, 0);
+	snprintf(instanceProperties->runtimeName, XR_MAX_RUNTIME_NAME_SIZE, "Godot OpenXR mock runtime");
+	return XR_SUCCESS;
+}
+
+static XrResult XRAPI_CALL mock_xrPollEvent(XrInstance instance, XrEventDataBuffer *eventData) {
+	MOCK_LOCK;
+
+	if (!is_instance(instance)) {
+		return XR_ERROR_HANDLE_INVALID;
+	} else if (eventData == nullptr) {
+		return XR_ERROR_VALIDATION_FAILURE;
+	} else if (mock_instance->events.empty()) {
+		return XR_EVENT_UNAVAILABLE;
+	}
+
+	*eventData = mock_instance->events.front();
+	mock_instance->events.pop_front();
+	return XR_SUCCESS;
+}
+
+#define MOCK_ENUM_TO_STRING_CASE(m_name, m_value) \
+	case m_name:                                  \
+		snprintf(buffer, XR_MAX_RESULT_STRING_SIZE, "%s", #m_name); \
+		return XR_SUCCESS;
+
+static XrResult XRAPI_CALL mock_xrResultToString(XrInstance instance, XrResult value, char buffer[XR_MAX_RESULT_STRING_SIZE]) {
+	switch (value) {
+		XR_LIST_ENUM_XrResult(MOCK_ENUM_TO_STRING_CASE);
+		default:
+			snprintf(buffer, XR_MAX_RESULT_STRING_SIZE, "XR_UNKNOWN_%s_%d", value < 0 ? "FAILURE" : "SUCCESS", (int)value);
+			return XR_SUCCESS;
+	}
+}
+
+static XrResult XRAPI_CALL mock_xrStructureTypeToString(XrInstance instance, XrStructureType value, char buffer[XR_MAX_STRUCTURE_NAME_SIZE]) {
+	switch (value) {
+		XR_LIST_ENUM_XrStructureType(MOCK_ENUM_TO_STRING_CASE);
+		default:
+			snprintf(buffer, XR_MAX_STRUCTURE_NAME_SIZE, "XR_UNKNOWN_STRUCTURE_TYPE_%d", (int)value);
+			return XR_SUCCESS;
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// System
+
+static XrResult XRAPI_CALL mock_xrGetSystem(XrInstance instance, const XrSystemGetInfo *getInfo, XrSystemId *systemId) {
+	MOCK_LOCK;
+
+	if (!is_instance(instance)) {
+		return XR_ERROR_HANDLE_INVALID;
+	} else if (getInfo == nullptr || systemId == nullptr) {
+		return XR_ERROR_VALIDATION_FAILURE;
+	} else if (getInfo->formFactor != XR_FORM_FACTOR_HEAD_MOUNTED_DISPLAY) {
+		return XR_ERROR_FORM_FACTOR_UNSUPPORTED;
+	}
+
+	*systemId = MOCK_SYSTEM_ID;
+	return XR_SUCCESS;
+}
+
+static XrResult XRAPI_CALL mock_xrGetSystemProperties(XrInstance instance, XrSystemId systemId, XrSystemProperties *properties) {
+	MOCK_LOCK;
+
+	if (!is_instance(instance)) {
+		return XR_ERROR_HANDLE_INVALID;
+	} else if (systemId != MOCK_SYSTEM_ID) {
+		return XR_ERROR_SYSTEM_INVALID;
+	} else if (properties == nullptr) {
+		return XR_ERROR_VALIDATION_FAILURE;
+	}
+
+	properties->systemId = MOCK_SYSTEM_ID;
+	properties->vendorId = 0;
+	snprintf(properties->systemName, XR_MAX_SYSTEM_NAME_SIZE, "Godot OpenXR mock HMD");
+	properties->graphicsProperties.maxSwapchainImageWidth = mock_instance->opengl_ext ? MOCK_MAX_IMAGE_SIZE : 0;
+	properties->graphicsProperties.maxSwapchainImageHeight = mock_instance->opengl_ext ? MOCK_MAX_IMAGE_SIZE : 0;
+	properties->graphicsProperties.maxLayerCount = XR_MIN_COMPOSITION_LAYERS_SUPPORTED;
+	properties->trackingProperties.orientationTracking = XR_TRUE;
+	properties->trackingProperties.positionTracking = XR_TRUE;
+
+	XrSystemHandTrackingPropertiesEXT *hand_tracking_properties = find_next<XrSystemHandTrackingPropertiesEXT>(properties->next, XR_TYPE_SYSTEM_HAND_TRACKING_PROPERTIES_EXT);
+	if (hand_tracking_properties != nullptr) {
+		hand_tracking_properties->supportsHandTracking = mock_instance->hand_tracking_ext ? XR_TRUE : XR_FALSE;
+	}
+
+	XrSystemSpaceWarpPropertiesFB *space_warp_properties = find_next<XrSystemSpaceWarpPropertiesFB>(properties->next, XR_TYPE_SYSTEM_SPACE_WARP_PROPERTIES_FB);
+	if (space_warp_properties != nullptr) {
+		space_warp_properties->recommendedMotionVectorImageRectWidth = mock_instance->space_warp_ext ? MOCK_MOTION_VECTOR_WIDTH : 0;
+		space_warp_properties->recommendedMotionVectorImageRectHeight = mock_instance->space_warp_ext ? MOCK_MOTION_VECTOR_HEIGHT : 0;
+	}
+
+	return XR_SUCCESS;
+}
+
+static XrResult XRAPI_CALL mock_xrEnumerateEnvironmentBlendModes(XrInstance instance, XrSystemId systemId, XrViewConfigurationType viewConfigurationType, uint32_t environmentBlendModeCapacityInput, uint32_t *environmentBlendModeCountOutput, XrEnvironmentBlendMode *environmentBlendModes) {
+	MOCK_LOCK;
+
+	if (!is_instance(instance)) {
+		return XR_ERROR_HANDLE_INVALID;
+	} else if (systemId != MOCK_SYSTEM_ID) {
+		return XR_ERROR_SYSTEM_INVALID;
+	} else if (viewConfigurationType != XR_VIEW_CONFIGURATION_TYPE_PRIMARY_STEREO) {
+		return XR_ERROR_VIEW_CONFIGURATION_TYPE_UNSUPPORTED;
+	}
+
+	std::vector<XrEnvironmentBlendMode> modes(1, XR_ENVIRONMENT_BLEND_MODE_OPAQUE);
+	return copy_array(modes, environmentBlendModeCapacityInput, environmentBlendModeCountOutput, environmentBlendModes);
+}
+
+static XrResult XRAPI_CALL mock_xrEnumerateViewConfigurations(XrInstance instance, XrSystemId systemId, uint32_t viewConfigurationTypeCapacityInput, uint32_t *viewConfigurationTypeCountOutput, XrViewConfigurationType *viewConfigurationTypes) {
+	MOCK_LOCK;
+
+	if (!is_instance(instance)) {
+		return XR_ERROR_HANDLE_INVALID;
+	} else if (systemId != MOCK_SYSTEM_ID) {
+		return XR_ERROR_SYSTEM_INVALID;
+	}
+
+	std::vector<XrViewConfigurationType> types(1, XR_VIEW_CONFIGURATION_TYPE_PRIMARY_STEREO);
+	return copy_array(types, viewConfigurationTypeCapacityInput, viewConfigurationTypeCountOutput, viewConfigurationTypes);
+}
+
+static XrResult XRAPI_CALL mock_xrGetViewConfigurationProperties(XrInstance instance, XrSystemId systemId, XrViewConfigurationType viewConfigurationType, XrViewConfigurationProperties *configurationProperties) {
+	MOCK_LOCK;
+
+	if (!is_instance(instance)) {
+		return XR_ERROR_HANDLE_INVALID;
+	} else if (systemId != MOCK_SYSTEM_ID) {
+		return XR_ERROR_SYSTEM_INVALID;
+	} else if (viewConfigurationType != XR_VIEW_CONFIGURATION_TYPE_PRIMARY_STEREO) {
+		return XR_ERROR_VIEW_CONFIGURATION_TYPE_UNSUPPORTED;
+	} else if (configurationProperties == nullptr) {
+		return XR_ERROR_VALIDATION_FAILURE;
+	}
+
+	configurationProperties->viewConfigurationType = viewConfigurationType;
+	configurationProperties->fovMutable = XR_FALSE;
+	return XR_SUCCESS;
+}
+
+static XrResult XRAPI_CALL mock_xrEnumerateViewConfigurationViews(XrInstance instance, XrSystemId systemId, XrViewConfigurationType viewConfigurationType, uint32_t viewCapacityInput, uint32_t *viewCountOutput, XrViewConfigurationView *views) {
+	MOCK_LOCK;
+
+	if (!is_instance(instance)) {
+		return XR_ERROR_HANDLE_INVALID;
+	} else if (systemId != MOCK_SYSTEM_ID) {
+		return XR_ERROR_SYSTEM_INVALID;
+	} else if (viewConfigurationType != XR_VIEW_CONFIGURATION_TYPE_PRIMARY_STEREO) {
+		return XR_ERROR_VIEW_CONFIGURATION_TYPE_UNSUPPORTED;
+	} else if (viewCountOutput == nullptr) {
+		return XR_ERROR_VALIDATION_FAILURE;
+	}
+
+	*viewCountOutput = MOCK_VIEW_COUNT;
+	if (viewCapacityInput == 0) {
+		return XR_SUCCESS;
+	} else if (viewCapacityInput < MOCK_VIEW_COUNT) {
+		return XR_ERROR_SIZE_INSUFFICIENT;
+	} else if (views == nullptr) {
+		return XR_ERROR_VALIDATION_FAILURE;
+	}
+
+	for (uint32_t i = 0; i < MOCK_VIEW_COUNT; i++) {
+		views[i].recommendedImageRectWidth = MOCK_VIEW_WIDTH;
+		views[i].maxImageRectWidth = MOCK_MAX_IMAGE_SIZE;
+		views[i].recommendedImageRectHeight = MOCK_VIEW_HEIGHT;
+		views[i].maxImageRectHeight = MOCK_MAX_IMAGE_SIZE;
+		views[i].recommendedSwapchainSampleCount = 1;
+		views[i].maxSwapchainSampleCount = 1;
+	}
+	return XR_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Paths
+
+static XrResult XRAPI_CALL mock_xrStringToPath(XrInstance instance, const char *pathString, XrPath *path) {
+	MOCK_LOCK;
+
+	if (!is_instance(instance)) {
+		return XR_ERROR_HANDLE_INVALID;
+	} else if (path == nullptr) {
+		return XR_ERROR_VALIDATION_FAILURE;
+	} else if (!is_valid_path_string(pathString)) {
+		return XR_ERROR_PATH_FORMAT_INVALID;
+	}
+
+	*path = get_path(pathString);
+	return XR_SUCCESS;
+}
+
+static XrResult XRAPI_CALL mock_xrPathToString(XrInstance instance, XrPath path, uint32_t bufferCapacityInput, uint32_t *bufferCountOutput, char *buffer) {
+	MOCK_LOCK;
+
+	if (!is_instance(instance)) {
+		return XR_ERROR_HANDLE_INVALID;
+	} else if (path == XR_NULL_PATH || path > mock_instance->paths.size()) {
+		return XR_ERROR_PATH_INVALID;
+	}
+
+	return copy_string(get_path_string(path), bufferCapacityInput, bufferCountOutput, buffer);
+}
+
+const MockFunction mock_instance_functions[] = {
+	MOCK_GLOBAL_FUNCTION(xrGetInstanceProcAddr),
+	MOCK_GLOBAL_FUNCTION(xrEnumerateApiLayerProperties),
+	MOCK_GLOBAL_FUNCTION(xrEnumerateInstanceExtensionProperties),
+	MOCK_GLOBAL_FUNCTION(xrCreateInstance),
+	MOCK_FUNCTION(xrDestroyInstance),
+	MOCK_FUNCTION(xrGetInstanceProperties),
+	MOCK_FUNCTION(xrPollEvent),
+	MOCK_FUNCTION(xrResultToString),
+	MOCK_FUNCTION(xrStructureTypeToString),
+	MOCK_FUNCTION(xrGetSystem),
+	MOCK_FUNCTION(xrGetSystemProperties),
+	MOCK_FUNCTION(xrEnumerateEnvironmentBlendModes),
+	MOCK_FUNCTION(xrEnumerateViewConfigurations),
+	MOCK_FUNCTION(xrGetViewConfigurationProperties),
+	MOCK_FUNCTION(xrEnumerateViewConfigurationViews),
+	MOCK_FUNCTION(xrStringToPath),
+	MOCK_FUNCTION(xrPathToString),
+};
+const uint32_t mock_instance_function_count = MOCK_FUNCTION_COUNT(mock_instance_functions);
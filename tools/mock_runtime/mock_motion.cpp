@@ -0,0 +1,104 @@
+#include "mock_runtime.h"
+
+#include <math.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Pose math
+
+XrQuaternionf quat_multiply(const XrQuaternionf &a, const XrQuaternionf &b) {
+	return XrQuaternionf{
+		a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y,
+		a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x,
+		a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w,
+		a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z
+	};
+}
+
+XrVector3f quat_rotate(const XrQuaternionf &q, const XrVector3f &v) {
+	// v + 2w(u x v) + 2(u x (u x v))
+	const XrVector3f u = { q.x, q.y, q.z };
+	const XrVector3f c = { u.y * v.z - u.z * v.y, u.z * v.x - u.x * v.z, u.x * v.y - u.y * v.x };
+	const XrVector3f cc = { u.y * c.z - u.z * c.y, u.z * c.x - u.x * c.z, u.x * c.y - u.y * c.x };
+	return XrVector3f{
+		v.x + 2.0f * (q.w * c.x + cc.x),
+		v.y + 2.0f * (q.w * c.y + cc.y),
+		v.z + 2.0f * (q.w * c.z + cc.z)
+	};
+}
+
+// a * b, b is relative to a
+XrPosef pose_multiply(const XrPosef &a, const XrPosef &b) {
+	const XrVector3f p = quat_rotate(a.orientation, b.position);
+	return XrPosef{
+		quat_multiply(a.orientation, b.orientation),
+		{ a.position.x + p.x, a.position.y + p.y, a.position.z + p.z }
+	};
+}
+
+XrPosef pose_inverse(const XrPosef &p) {
+	const XrQuaternionf q = { -p.orientation.x, -p.orientation.y, -p.orientation.z, p.orientation.w };
+	const XrVector3f t = quat_rotate(q, p.position);
+	return XrPosef{ q, { -t.x, -t.y, -t.z } };
+}
+
+XrQuaternionf quat_from_euler(float p_pitch, float p_yaw, float p_roll) {
+	const XrQuaternionf pitch = { sinf(p_pitch * 0.5f), 0.0f, 0.0f, cosf(p_pitch * 0.5f) };
+	const XrQuaternionf yaw = { 0.0f, sinf(p_yaw * 0.5f), 0.0f, cosf(p_yaw * 0.5f) };
+	const XrQuaternionf roll = { 0.0f, 0.0f, sinf(p_roll * 0.5f), cosf(p_roll * 0.5f) };
+	return quat_multiply(yaw, quat_multiply(pitch, roll));
+}
+
+const XrPosef identity_pose = { { 0.0f, 0.0f, 0.0f, 1.0f }, { 0.0f, 0.0f, 0.0f } };
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Our scripted motion and input, all poses are in stage space
+
+float seconds_at(XrTime p_time) {
+	return float(double(p_time - MOCK_START_TIME) / 1000000000.0);
+}
+
+XrPosef get_head_pose(XrTime p_time) {
+	const float s = seconds_at(p_time);
+	return XrPosef{
+		quat_from_euler(0.1f * sinf(0.7f * s), 0.3f * sinf(0.25f * s), 0.0f),
+		{ 0.1f * sinf(0.5f * s), 1.6f + 0.02f * sinf(2.0f * s), 0.1f * cosf(0.5f * s) }
+	};
+}
+
+XrPosef get_hand_pose(XrHandEXT p_hand, XrTime p_time) {
+	const float s = seconds_at(p_time);
+	const float side = p_hand == XR_HAND_LEFT_EXT ? -1.0f : 1.0f;
+	return XrPosef{
+		quat_from_euler(-0.3f + 0.2f * sinf(1.1f * s), 0.2f * side * sinf(0.6f * s), 0.0f),
+		{ side * (0.2f + 0.05f * sinf(s)), 1.2f + 0.05f * cosf(1.3f * s), -0.35f + 0.05f * sinf(0.8f * s) }
+	};
+}
+
+XrPosef get_reference_space_pose(XrReferenceSpaceType p_type, XrTime p_time) {
+	switch (p_type) {
+		case XR_REFERENCE_SPACE_TYPE_VIEW:
+			return get_head_pose(p_time);
+		case XR_REFERENCE_SPACE_TYPE_LOCAL:
+			// LOCAL has its origin where our head was when we started, at eye height
+			return XrPosef{ identity_pose.orientation, { 0.0f, 1.6f, 0.1f } };
+		case XR_REFERENCE_SPACE_TYPE_STAGE:
+		default:
+			return identity_pose;
+	}
+}
+
+float get_scripted_float(uint64_t p_frame, uint32_t p_phase) {
+	// ramps between 0.0 and 1.0 every 2 seconds at 60 syncs per second
+	return 0.5f - 0.5f * cosf(float(p_frame + p_phase) * 2.0f * 3.14159265f / 120.0f);
+}
+
+bool get_scripted_bool(uint64_t p_frame, uint32_t p_phase) {
+	// toggles every 60 syncs
+	return ((p_frame + p_phase) / 60) % 2 == 1;
+}
+
+XrVector2f get_scripted_vector2(uint64_t p_frame, uint32_t p_phase) {
+	// circles around every 4 seconds
+	const float angle = float(p_frame + p_phase) * 2.0f * 3.14159265f / 240.0f;
+	return XrVector2f{ 0.8f * cosf(angle), 0.8f * sinf(angle) };
+}
@@ -0,0 +1,67 @@
+#include "mock_runtime.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Our report, a JSON file our tests read after the application destroyed its instance
+
+static void write_array(FILE *p_file, const std::vector<uint32_t> &p_values) {
+	fprintf(p_file, "[");
+	for (size_t i = 0; i < p_values.size(); i++) {
+		fprintf(p_file, i == 0 ? "%u" : ", %u", p_values[i]);
+	}
+	fprintf(p_file, "]");
+}
+
+static void write_strings(FILE *p_file, const std::vector<std::string> &p_values) {
+	fprintf(p_file, "[");
+	for (size_t i = 0; i < p_values.size(); i++) {
+		fprintf(p_file, i == 0 ? "\"" : ", \"");
+		for (char c : p_values[i]) {
+			if (c == '"' || c == '\\') {
+				fputc('\\', p_file);
+			}
+			fputc(c, p_file);
+		}
+		fprintf(p_file, "\"");
+	}
+	fprintf(p_file, "]");
+}
+
+void write_report(const MockReport &p_report) {
+	const char *path = getenv("OPENXR_MOCK_REPORT");
+	if (path == nullptr || path[0] == '\0') {
+		return;
+	}
+
+	FILE *file = fopen(path, "w");
+	if (file == nullptr) {
+		fprintf(stderr, "OpenXR mock runtime couldn't write its report to %s\n", path);
+		return;
+	}
+
+	fprintf(file, "{\n");
+	fprintf(file, "\t\"frames\": %llu,\n", (unsigned long long)p_report.frames);
+	fprintf(file, "\t\"submitted_frames\": %u,\n", p_report.submitted_frames);
+	fprintf(file, "\t\"layer_errors\": ");
+	write_strings(file, p_report.layer_errors);
+	fprintf(file, ",\n");
+	fprintf(file, "\t\"sessions_created\": %u,\n", p_report.sessions_created);
+	fprintf(file, "\t\"session_errors\": ");
+	write_strings(file, p_report.session_errors);
+	fprintf(file, ",\n");
+	fprintf(file, "\t\"space_warp\": {\n");
+	fprintf(file, "\t\t\"frames\": %u,\n", p_report.space_warp_frames);
+	fprintf(file, "\t\t\"skipped_frames\": %u\n", p_report.space_warp_skipped_frames);
+	fprintf(file, "\t},\n");
+	fprintf(file, "\t\"spatial_anchors\": {\n");
+	fprintf(file, "\t\t\"created\": %u,\n", p_report.spatial_anchors_created);
+	fprintf(file, "\t\t\"destroyed\": %u,\n", p_report.spatial_anchors_destroyed);
+	fprintf(file, "\t\t\"located_per_frame\": ");
+	write_array(file, p_report.spatial_anchors_located);
+	fprintf(file, "\n\t}\n");
+	fprintf(file, "}\n");
+
+	fclose(file);
+}
@@ -0,0 +1,140 @@
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Headless mock OpenXR runtime, see mock_runtime.h for an overview.
+// This file holds our global state, the function lookup and the loader entry point.
+
+#include "mock_runtime.h"
+
+#ifdef _WIN32
+#define MOCK_EXPORT extern "C" __declspec(dllexport)
+#else
+#define MOCK_EXPORT extern "C" __attribute__((visibility("default")))
+#endif
+
+std::recursive_mutex mock_mutex;
+MockInstance *mock_instance = nullptr;
+
+XrResult copy_string(const std::string &p_source, uint32_t p_capacity, uint32_t *r_count, char *r_buffer) {
+	if (r_count == nullptr) {
+		return XR_ERROR_VALIDATION_FAILURE;
+	}
+
+	*r_count = (uint32_t)p_source.size() + 1;
+	if (p_capacity == 0) {
+		return XR_SUCCESS;
+	} else if (p_capacity < p_source.size() + 1) {
+		return XR_ERROR_SIZE_INSUFFICIENT;
+	} else if (r_buffer == nullptr) {
+		return XR_ERROR_VALIDATION_FAILURE;
+	}
+
+	memcpy(r_buffer, p_source.c_str(), p_source.size() + 1);
+	return XR_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Function lookup
+
+struct MockFunctionTable {
+	const MockFunction *functions;
+	const uint32_t *count;
+};
+
+static const MockFunctionTable mock_function_tables[] = {
+	{ mock_instance_functions, &mock_instance_function_count },
+	{ mock_session_functions, &mock_session_function_count },
+	{ mock_swapchain_functions, &mock_swapchain_function_count },
+	{ mock_space_functions, &mock_space_function_count },
+	{ mock_action_functions, &mock_action_function_count },
+	{ mock_hand_tracking_functions, &mock_hand_tracking_function_count },
+	{ mock_spatial_anchor_functions, &mock_spatial_anchor_function_count },
+};
+
+XrResult XRAPI_CALL mock_xrGetInstanceProcAddr(XrInstance instance, const char *name, PFN_xrVoidFunction *function) {
+	MOCK_LOCK;
+
+	if (name == nullptr || function == nullptr) {
+		return XR_ERROR_VALIDATION_FAILURE;
+	}
+
+	*function = nullptr;
+	if (instance != XR_NULL_HANDLE && !is_instance(instance)) {
+		return XR_ERROR_HANDLE_INVALID;
+	}
+
+	for (const MockFunctionTable &table : mock_function_tables) {
+		for (uint32_t i = 0; i < *table.count; i++) {
+			const MockFunction &mock_function = table.functions[i];
+			if (strcmp(mock_function.name, name) != 0) {
+				continue;
+			}
+
+			if (mock_function.needs_instance && instance == XR_NULL_HANDLE) {
+				return XR_ERROR_HANDLE_INVALID;
+			} else if (mock_function.extension != nullptr && !(mock_instance->*mock_function.extension)) {
+				return XR_ERROR_FUNCTION_UNSUPPORTED;
+			}
+
+			*function = mock_function.function;
+			return XR_SUCCESS;
+		}
+	}
+
+	return XR_ERROR_FUNCTION_UNSUPPORTED;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Loader negotiation, these match loader_interfaces.h from the OpenXR SDK which isn't part of
+// the loader package we ship.
+
+typedef enum XrLoaderInterfaceStructs {
+	XR_LOADER_INTERFACE_STRUCT_UNINTIALIZED = 0,
+	XR_LOADER_INTERFACE_STRUCT_LOADER_INFO,
+	XR_LOADER_INTERFACE_STRUCT_API_LAYER_REQUEST,
+	XR_LOADER_INTERFACE_STRUCT_RUNTIME_REQUEST,
+	XR_LOADER_INTERFACE_STRUCT_API_LAYER_CREATE_INFO,
+	XR_LOADER_INTERFACE_STRUCT_API_LAYER_NEXT_INFO,
+} XrLoaderInterfaceStructs;
+
+#define XR_LOADER_INFO_STRUCT_VERSION 1
+typedef struct XrNegotiateLoaderInfo {
+	XrLoaderInterfaceStructs structType;
+	uint32_t structVersion;
+	size_t structSize;
+	uint32_t minInterfaceVersion;
+	uint32_t maxInterfaceVersion;
+	XrVersion minApiVersion;
+	XrVersion maxApiVersion;
+} XrNegotiateLoaderInfo;
+
+#define XR_CURRENT_LOADER_RUNTIME_VERSION 1
+#define XR_RUNTIME_INFO_STRUCT_VERSION 1
+typedef struct XrNegotiateRuntimeRequest {
+	XrLoaderInterfaceStructs structType;
+	uint32_t structVersion;
+	size_t structSize;
+	uint32_t runtimeInterfaceVersion;
+	XrVersion runtimeApiVersion;
+	PFN_xrGetInstanceProcAddr getInstanceProcAddr;
+} XrNegotiateRuntimeRequest;
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Our entry point, called by the loader
+
+MOCK_EXPORT XrResult XRAPI_CALL xrNegotiateLoaderRuntimeInterface(const XrNegotiateLoaderInfo *loaderInfo, XrNegotiateRuntimeRequest *runtimeRequest) {
+	if (loaderInfo == nullptr || runtimeRequest == nullptr) {
+		return XR_ERROR_INITIALIZATION_FAILED;
+	} else if (loaderInfo->structType != XR_LOADER_INTERFACE_STRUCT_LOADER_INFO || loaderInfo->structVersion != XR_LOADER_INFO_STRUCT_VERSION || loaderInfo->structSize != sizeof(XrNegotiateLoaderInfo)) {
+		return XR_ERROR_INITIALIZATION_FAILED;
+	} else if (runtimeRequest->structType != XR_LOADER_INTERFACE_STRUCT_RUNTIME_REQUEST || runtimeRequest->structVersion != XR_RUNTIME_INFO_STRUCT_VERSION || runtimeRequest->structSize != sizeof(XrNegotiateRuntimeRequest)) {
+		return XR_ERROR_INITIALIZATION_FAILED;
+	} else if (loaderInfo->minInterfaceVersion > XR_CURRENT_LOADER_RUNTIME_VERSION || loaderInfo->maxInterfaceVersion < XR_CURRENT_LOADER_RUNTIME_VERSION) {
+		return XR_ERROR_INITIALIZATION_FAILED;
+	} else if (loaderInfo->minApiVersion > XR_CURRENT_API_VERSION || XR_VERSION_MAJOR(loaderInfo->maxApiVersion) < 1) {
+		return XR_ERROR_INITIALIZATION_FAILED;
+	}
+
+	runtimeRequest->runtimeInterfaceVersion = XR_CURRENT_LOADER_RUNTIME_VERSION;
+	runtimeRequest->runtimeApiVersion = XR_CURRENT_API_VERSION;
+	runtimeRequest->getInstanceProcAddr = mock_xrGetInstanceProcAddr;
+	return XR_SUCCESS;
+}
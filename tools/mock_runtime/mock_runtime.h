@@ -0,0 +1,353 @@
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Headless mock OpenXR runtime
+//
+// A minimal OpenXR runtime that the OpenXR loader can load through a runtime manifest
+// (point XR_RUNTIME_JSON at openxr_mock_runtime.json). Headless sessions need no GPU, no display
+// and no network so we can run the plugins frame loop on CI and benchmark it. OpenGL sessions
+// render into real textures, these need the application's OpenGL context (i.e. Godot under xvfb).
+//
+// What we implement, one source file per area:
+// - mock_instance.cpp: instance, system, view configurations, paths and events.
+// - mock_session.cpp: session with the normal session state changes, the frame loop and our
+//   display refresh rate (XR_FB_display_refresh_rate). We support headless sessions (XR_MND_headless)
+//   and OpenGL sessions (XR_KHR_opengl_enable).
+// - mock_swapchains.cpp: OpenGL swapchains and checking the layers we're given in xrEndFrame,
+//   including space warp (XR_FB_space_warp).
+// - mock_spaces.cpp: VIEW, LOCAL and STAGE reference spaces, action spaces and views.
+// - mock_actions.cpp: action sets, actions, suggested bindings, interaction profiles and action states.
+// - mock_hand_tracking.cpp: hand tracking (XR_EXT_hand_tracking).
+// - mock_spatial_anchors.cpp: spatial anchors (XR_MSFT_spatial_anchor), anchors stay where they were created.
+// - mock_motion.cpp: our pose math and the scripted motion and input all of the above report.
+// - mock_report.cpp: the report we write for our tests.
+// - mock_runtime.cpp: the loader entry point and function lookup.
+//
+// Time is deterministic, every xrWaitFrame advances our display time by exactly one frame
+// period and we never sleep. All poses and input values are scripted as a function of this
+// time (or of the number of xrSyncActions calls), so two runs produce identical data.
+//
+// Environment variables:
+// - OPENXR_MOCK_INTERACTION_PROFILE: interaction profile to use for every top level path,
+//   by default we pick the first suggested profile that has bindings for that path.
+// - OPENXR_MOCK_REPORT: file we write a JSON report of what the application did to when
+//   the instance is destroyed, our tests use this to check how the plugin uses OpenXR.
+
+#ifndef MOCK_RUNTIME_H
+#define MOCK_RUNTIME_H
+
+#define XR_NO_PROTOTYPES
+#define XR_USE_GRAPHICS_API_OPENGL
+#include <openxr/openxr.h>
+#include <openxr/openxr_platform.h>
+
+#include <stdint.h>
+#include <string.h>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Our objects, handles are pointers to these
+
+static const XrSystemId MOCK_SYSTEM_ID = 1;
+static const uint32_t MOCK_VIEW_COUNT = 2;
+static const XrDuration MOCK_FRAME_PERIOD = 11111111; // 90Hz
+static const float MOCK_REFRESH_RATE = 90.0f;
+static const uint32_t MOCK_VIEW_WIDTH = 1440;
+static const uint32_t MOCK_VIEW_HEIGHT = 1584;
+static const uint32_t MOCK_MAX_IMAGE_SIZE = 2048;
+static const uint32_t MOCK_MOTION_VECTOR_WIDTH = MOCK_VIEW_WIDTH / 4;
+static const uint32_t MOCK_MOTION_VECTOR_HEIGHT = MOCK_VIEW_HEIGHT / 4;
+static const XrTime MOCK_START_TIME = 1000000000; // 1 second, 0 is not a valid time
+
+struct MockActionSet;
+
+struct MockAction {
+	MockActionSet *action_set;
+	std::string name;
+	XrActionType type;
+	std::vector<XrPath> subaction_paths;
+};
+
+struct MockActionSet {
+	std::string name;
+	uint32_t priority;
+	bool attached = false;
+	std::vector<MockAction *> actions;
+};
+
+struct MockBinding {
+	MockAction *action;
+	XrPath path; // full binding path, i.e. /user/hand/left/input/trigger/value
+	XrPath toplevel_path; // i.e. /user/hand/left
+	uint32_t phase; // offsets our scripted values so inputs don't all change together
+};
+
+struct MockInteractionProfile {
+	XrPath path;
+	std::vector<MockBinding> bindings;
+};
+
+struct MockSpatialAnchor {
+	XrPosef pose; // in stage space
+};
+
+struct MockSpace {
+	XrReferenceSpaceType reference_space_type; // XR_REFERENCE_SPACE_TYPE_MAX_ENUM for action and anchor spaces
+	MockAction *action;
+	XrPath subaction_path;
+	const MockSpatialAnchor *spatial_anchor; // for anchor spaces
+	XrPosef pose; // poseInReferenceSpace, poseInActionSpace or poseInAnchorSpace
+};
+
+struct MockHandTracker {
+	XrHandEXT hand;
+};
+
+struct MockSwapchain {
+	XrSwapchainUsageFlags usage;
+	int64_t format;
+	uint32_t width;
+	uint32_t height;
+	std::vector<uint32_t> textures; // OpenGL texture ids
+
+	uint32_t next_image = 0;
+	std::deque<uint32_t> acquired; // in the order they were acquired
+	uint32_t waited = 0; // number of acquired images we've waited on
+	uint32_t released = 0; // number of images released so far
+};
+
+struct MockSession {
+	XrSessionState state = XR_SESSION_STATE_UNKNOWN;
+	bool opengl = false; // false for headless sessions
+	bool running = false;
+	bool exit_requested = false;
+	bool actions_attached = false;
+
+	// frame loop
+	XrTime display_time = MOCK_START_TIME;
+	bool frame_waited = false;
+	bool frame_begun = false;
+
+	// actions
+	uint64_t sync_count = 0;
+	std::vector<XrActiveActionSet> active_action_sets;
+	std::map<XrPath, XrPath> current_profiles; // top level path -> interaction profile
+
+	std::vector<MockSwapchain *> swapchains;
+	std::vector<MockSpace *> spaces;
+	std::vector<MockHandTracker *> hand_trackers;
+	std::vector<MockSpatialAnchor *> spatial_anchors;
+};
+
+// What we tell our tests, see mock_report.cpp
+struct MockReport {
+	uint64_t frames = 0; // number of xrWaitFrame calls
+	uint32_t submitted_frames = 0; // number of xrEndFrame calls with a projection layer
+	std::vector<std::string> layer_errors; // problems with the layers we were given
+
+	uint32_t sessions_created = 0;
+	std::vector<std::string> session_errors; // session functions called in a state the spec doesn't allow
+
+	uint32_t space_warp_frames = 0; // frames with space warp info on all projection views
+	uint32_t space_warp_skipped_frames = 0; // of which had XR_COMPOSITION_LAYER_SPACE_WARP_INFO_FRAME_SKIP_BIT_FB set
+
+	uint32_t spatial_anchors_created = 0;
+	uint32_t spatial_anchors_destroyed = 0;
+	std::vector<uint32_t> spatial_anchors_located; // number of anchor spaces located after each xrWaitFrame, [0] is before our first frame
+};
+
+struct MockInstance {
+	// enabled extensions
+	bool headless_ext = false;
+	bool opengl_ext = false;
+	bool hand_tracking_ext = false;
+	bool spatial_anchor_ext = false;
+	bool space_warp_ext = false;
+	bool display_refresh_rate_ext = false;
+
+	bool graphics_requirements_queried = false;
+
+	std::vector<std::string> paths; // XrPath is index + 1
+	std::map<std::string, XrPath> path_ids;
+
+	std::vector<MockActionSet *> action_sets;
+	std::vector<MockInteractionProfile> suggested_profiles; // in the order they were suggested
+
+	MockSession *session = nullptr;
+	std::deque<XrEventDataBuffer> events;
+
+	MockReport report;
+};
+
+extern std::recursive_mutex mock_mutex;
+extern MockInstance *mock_instance;
+
+#define MOCK_LOCK std::lock_guard<std::recursive_mutex> lock(mock_mutex)
+
+template <typename T, typename H>
+static T *from_handle(H p_handle) {
+	return reinterpret_cast<T *>(p_handle);
+}
+
+template <typename H, typename T>
+static H to_handle(T *p_object) {
+	return reinterpret_cast<H>(p_object);
+}
+
+// Two call idiom for arrays
+template <typename T>
+static XrResult copy_array(const std::vector<T> &p_source, uint32_t p_capacity, uint32_t *r_count, T *r_array) {
+	if (r_count == nullptr) {
+		return XR_ERROR_VALIDATION_FAILURE;
+	}
+
+	*r_count = (uint32_t)p_source.size();
+	if (p_capacity == 0) {
+		return XR_SUCCESS;
+	} else if (p_capacity < p_source.size()) {
+		return XR_ERROR_SIZE_INSUFFICIENT;
+	} else if (r_array == nullptr) {
+		return XR_ERROR_VALIDATION_FAILURE;
+	}
+
+	for (size_t i = 0; i < p_source.size(); i++) {
+		r_array[i] = p_source[i];
+	}
+	return XR_SUCCESS;
+}
+
+// Two call idiom for strings, our count includes the terminating zero
+XrResult copy_string(const std::string &p_source, uint32_t p_capacity, uint32_t *r_count, char *r_buffer);
+
+// Finds an extension structure in a next chain
+template <typename T>
+static T *find_next(const void *p_next, XrStructureType p_type) {
+	XrBaseOutStructure *next = (XrBaseOutStructure *)p_next;
+	while (next != nullptr) {
+		if (next->type == p_type) {
+			return (T *)next;
+		}
+		next = next->next;
+	}
+	return nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Function lookup, each area has a table of the functions it implements
+
+struct MockFunction {
+	const char *name;
+	PFN_xrVoidFunction function;
+	bool needs_instance;
+	bool MockInstance::*extension; // the extension that must be enabled, nullptr for core functions
+};
+
+#define MOCK_FUNCTION(m_name) \
+	{ #m_name, (PFN_xrVoidFunction)mock_##m_name, true, nullptr }
+#define MOCK_GLOBAL_FUNCTION(m_name) \
+	{ #m_name, (PFN_xrVoidFunction)mock_##m_name, false, nullptr }
+#define MOCK_EXTENSION_FUNCTION(m_name, m_extension) \
+	{ #m_name, (PFN_xrVoidFunction)mock_##m_name, true, &MockInstance::m_extension }
+
+#define MOCK_FUNCTION_TABLE(m_area)                       \
+	extern const MockFunction mock_##m_area##_functions[]; \
+	extern const uint32_t mock_##m_area##_function_count;
+
+#define MOCK_FUNCTION_COUNT(m_table) (uint32_t)(sizeof(m_table) / sizeof(m_table[0]))
+
+MOCK_FUNCTION_TABLE(instance)
+MOCK_FUNCTION_TABLE(session)
+MOCK_FUNCTION_TABLE(swapchain)
+MOCK_FUNCTION_TABLE(space)
+MOCK_FUNCTION_TABLE(action)
+MOCK_FUNCTION_TABLE(hand_tracking)
+MOCK_FUNCTION_TABLE(spatial_anchor)
+
+XrResult XRAPI_CALL mock_xrGetInstanceProcAddr(XrInstance instance, const char *name, PFN_xrVoidFunction *function);
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Instance, paths and events (mock_instance.cpp)
+
+bool is_instance(XrInstance p_instance);
+
+XrPath get_path(const std::string &p_string);
+const std::string &get_path_string(XrPath p_path);
+bool is_valid_path_string(const char *p_string);
+XrPath get_toplevel_path(const std::string &p_binding);
+
+void queue_event(const void *p_event, size_t p_size);
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Session (mock_session.cpp)
+
+bool is_session(XrSession p_session);
+void set_session_state(MockSession *p_session, XrSessionState p_state);
+void destroy_session(MockSession *p_session);
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Swapchains (mock_swapchains.cpp)
+
+// Loads the OpenGL functions we need to create our textures, returns false if we can't
+bool load_opengl();
+
+bool is_swapchain(XrSwapchain p_swapchain);
+void destroy_swapchains(MockSession *p_session);
+
+// Checks the layers given to xrEndFrame, problems with their contents are added to our report
+XrResult check_layers(const XrFrameEndInfo *p_frame_end_info);
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Spaces (mock_spaces.cpp)
+
+bool is_space(XrSpace p_space);
+
+// The pose of our space in stage space, returns false if we're not tracking it
+bool get_space_pose(const MockSession *p_session, const MockSpace *p_space, XrTime p_time, XrPosef &r_pose);
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Actions (mock_actions.cpp)
+
+bool is_action_set(XrActionSet p_action_set);
+bool is_action(XrAction p_action);
+void destroy_action_sets();
+
+// Is this binding in use for our action in our last sync?
+bool is_binding_active(const MockSession *p_session, const MockBinding &p_binding, XrPath p_subaction_path);
+
+// Our hand for an action space, which is the first hand that is bound
+bool get_action_space_hand(const MockSession *p_session, const MockSpace *p_space, XrHandEXT &r_hand);
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Spatial anchors (mock_spatial_anchors.cpp)
+
+bool is_spatial_anchor(XrSpatialAnchorMSFT p_spatial_anchor);
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Report (mock_report.cpp)
+
+// Writes our report to the file in OPENXR_MOCK_REPORT, if set
+void write_report(const MockReport &p_report);
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Pose math and scripted motion (mock_motion.cpp), all poses are in stage space
+
+extern const XrPosef identity_pose;
+
+XrQuaternionf quat_multiply(const XrQuaternionf &a, const XrQuaternionf &b);
+XrVector3f quat_rotate(const XrQuaternionf &q, const XrVector3f &v);
+XrPosef pose_multiply(const XrPosef &a, const XrPosef &b); // a * b, b is relative to a
+XrPosef pose_inverse(const XrPosef &p);
+XrQuaternionf quat_from_euler(float p_pitch, float p_yaw, float p_roll);
+
+float seconds_at(XrTime p_time);
+XrPosef get_head_pose(XrTime p_time);
+XrPosef get_hand_pose(XrHandEXT p_hand, XrTime p_time);
+XrPosef get_reference_space_pose(XrReferenceSpaceType p_type, XrTime p_time);
+
+float get_scripted_float(uint64_t p_frame, uint32_t p_phase);
+bool get_scripted_bool(uint64_t p_frame, uint32_t p_phase);
+XrVector2f get_scripted_vector2(uint64_t p_frame, uint32_t p_phase);
+
+#endif // MOCK_RUNTIME_H
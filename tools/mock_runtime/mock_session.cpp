@@ -0,0 +1,323 @@
+#include "mock_runtime.h"
+
+#include <stdio.h>
+
+bool is_session(XrSession p_session) {
+	return mock_instance != nullptr && mock_instance->session != nullptr && from_handle<MockSession>(p_session) == mock_instance->session;
+}
+
+void set_session_state(MockSession *p_session, XrSessionState p_state) {
+	p_session->state = p_state;
+
+	XrEventDataSessionStateChanged event = {
+		XR_TYPE_EVENT_DATA_SESSION_STATE_CHANGED,
+		nullptr,
+		to_handle<XrSession>(p_session),
+		p_state,
+		p_session->display_time
+	};
+	queue_event(&event, sizeof(event));
+}
+
+// Records calls the spec doesn't allow in our session's current state so our tests can fail on them
+static XrResult session_error(XrResult p_result, const char *p_message) {
+	char error[256];
+	snprintf(error, sizeof(error), "frame %llu: %s", (unsigned long long)mock_instance->report.frames, p_message);
+	mock_instance->report.session_errors.push_back(error);
+	return p_result;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Session
+
+static XrResult XRAPI_CALL mock_xrCreateSession(XrInstance instance, const XrSessionCreateInfo *createInfo, XrSession *session) {
+	MOCK_LOCK;
+
+	if (!is_instance(instance)) {
+		return XR_ERROR_HANDLE_INVALID;
+	} else if (createInfo == nullptr || session == nullptr || createInfo->type != XR_TYPE_SESSION_CREATE_INFO) {
+		return XR_ERROR_VALIDATION_FAILURE;
+	} else if (createInfo->systemId != MOCK_SYSTEM_ID) {
+		return XR_ERROR_SYSTEM_INVALID;
+	} else if (mock_instance->session != nullptr) {
+		return XR_ERROR_LIMIT_REACHED;
+	}
+
+	// We don't need to know the application's OpenGL context, we create our textures in whatever context is current.
+	const bool opengl = find_next<XrBaseInStructure>(createInfo->next, XR_TYPE_GRAPHICS_BINDING_OPENGL_XLIB_KHR) != nullptr ||
+			find_next<XrBaseInStructure>(createInfo->next, XR_TYPE_GRAPHICS_BINDING_OPENGL_WIN32_KHR) != nullptr;
+	if (opengl) {
+		if (!mock_instance->opengl_ext) {
+			return XR_ERROR_GRAPHICS_DEVICE_INVALID;
+		} else if (!mock_instance->graphics_requirements_queried) {
+			return XR_ERROR_GRAPHICS_REQUIREMENTS_CALL_MISSING;
+		} else if (!load_opengl()) {
+			return XR_ERROR_GRAPHICS_DEVICE_INVALID;
+		}
+	} else if (!mock_instance->headless_ext) {
+		return XR_ERROR_GRAPHICS_DEVICE_INVALID;
+	}
+
+	mock_instance->session = new MockSession();
+	mock_instance->session->opengl = opengl;
+	mock_instance->report.sessions_created++;
+	*session = to_handle<XrSession>(mock_instance->session);
+
+	set_session_state(mock_instance->session, XR_SESSION_STATE_IDLE);
+	set_session_state(mock_instance->session, XR_SESSION_STATE_READY);
+	return XR_SUCCESS;
+}
+
+void destroy_session(MockSession *p_session) {
+	destroy_swapchains(p_session);
+	for (MockSpace *space : p_session->spaces) {
+		delete space;
+	}
+	for (MockHandTracker *hand_tracker : p_session->hand_trackers) {
+		delete hand_tracker;
+	}
+	for (MockSpatialAnchor *spatial_anchor : p_session->spatial_anchors) {
+		delete spatial_anchor;
+	}
+
+	// remove any events for this session that haven't been polled yet
+	std::deque<XrEventDataBuffer>::iterator it = mock_instance->events.begin();
+	while (it != mock_instance->events.end()) {
+		XrSession event_session = XR_NULL_HANDLE;
+		if (it->type == XR_TYPE_EVENT_DATA_SESSION_STATE_CHANGED) {
+			event_session = ((XrEventDataSessionStateChanged *)&*it)->session;
+		} else if (it->type == XR_TYPE_EVENT_DATA_INTERACTION_PROFILE_CHANGED) {
+			event_session = ((XrEventDataInteractionProfileChanged *)&*it)->session;
+		}
+
+		if (event_session == to_handle<XrSession>(p_session)) {
+			it = mock_instance->events.erase(it);
+		} else {
+			++it;
+		}
+	}
+
+	delete p_session;
+	mock_instance->session = nullptr;
+}
+
+static XrResult XRAPI_CALL mock_xrDestroySession(XrSession session) {
+	MOCK_LOCK;
+
+	if (!is_session(session)) {
+		return XR_ERROR_HANDLE_INVALID;
+	}
+
+	destroy_session(from_handle<MockSession>(session));
+	return XR_SUCCESS;
+}
+
+static XrResult XRAPI_CALL mock_xrBeginSession(XrSession session, const XrSessionBeginInfo *beginInfo) {
+	MOCK_LOCK;
+
+	if (!is_session(session)) {
+		return XR_ERROR_HANDLE_INVALID;
+	} else if (beginInfo == nullptr) {
+		return XR_ERROR_VALIDATION_FAILURE;
+	} else if (beginInfo->primaryViewConfigurationType != XR_VIEW_CONFIGURATION_TYPE_PRIMARY_STEREO) {
+		return XR_ERROR_VIEW_CONFIGURATION_TYPE_UNSUPPORTED;
+	}
+
+	MockSession *mock_session = from_handle<MockSession>(session);
+	if (mock_session->running) {
+		return session_error(XR_ERROR_SESSION_RUNNING, "xrBeginSession called while running");
+	} else if (mock_session->state != XR_SESSION_STATE_READY) {
+		return session_error(XR_ERROR_SESSION_NOT_READY, "xrBeginSession called while not ready");
+	}
+
+	mock_session->running = true;
+	set_session_state(mock_session, XR_SESSION_STATE_SYNCHRONIZED);
+	set_session_state(mock_session, XR_SESSION_STATE_VISIBLE);
+	set_session_state(mock_session, XR_SESSION_STATE_FOCUSED);
+	return XR_SUCCESS;
+}
+
+static XrResult XRAPI_CALL mock_xrEndSession(XrSession session) {
+	MOCK_LOCK;
+
+	if (!is_session(session)) {
+		return XR_ERROR_HANDLE_INVALID;
+	}
+
+	MockSession *mock_session = from_handle<MockSession>(session);
+	if (!mock_session->running) {
+		return session_error(XR_ERROR_SESSION_NOT_RUNNING, "xrEndSession called while not running");
+	} else if (mock_session->state != XR_SESSION_STATE_STOPPING) {
+		return session_error(XR_ERROR_SESSION_NOT_STOPPING, "xrEndSession called while not stopping");
+	}
+
+	mock_session->running = false;
+	mock_session->frame_waited = false;
+	mock_session->frame_begun = false;
+	set_session_state(mock_session, XR_SESSION_STATE_IDLE);
+	if (mock_session->exit_requested) {
+		set_session_state(mock_session, XR_SESSION_STATE_EXITING);
+	}
+	return XR_SUCCESS;
+}
+
+static XrResult XRAPI_CALL mock_xrRequestExitSession(XrSession session) {
+	MOCK_LOCK;
+
+	if (!is_session(session)) {
+		return XR_ERROR_HANDLE_INVALID;
+	}
+
+	MockSession *mock_session = from_handle<MockSession>(session);
+	if (!mock_session->running) {
+		return XR_ERROR_SESSION_NOT_RUNNING;
+	}
+
+	mock_session->exit_requested = true;
+	if (mock_session->state == XR_SESSION_STATE_FOCUSED) {
+		set_session_state(mock_session, XR_SESSION_STATE_VISIBLE);
+	}
+	if (mock_session->state == XR_SESSION_STATE_VISIBLE) {
+		set_session_state(mock_session, XR_SESSION_STATE_SYNCHRONIZED);
+	}
+	set_session_state(mock_session, XR_SESSION_STATE_STOPPING);
+	return XR_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Frame loop
+
+static XrResult XRAPI_CALL mock_xrWaitFrame(XrSession session, const XrFrameWaitInfo *frameWaitInfo, XrFrameState *frameState) {
+	MOCK_LOCK;
+
+	if (!is_session(session)) {
+		return XR_ERROR_HANDLE_INVALID;
+	} else if (frameState == nullptr) {
+		return XR_ERROR_VALIDATION_FAILURE;
+	}
+
+	MockSession *mock_session = from_handle<MockSession>(session);
+	if (!mock_session->running) {
+		return XR_ERROR_SESSION_NOT_RUNNING;
+	}
+
+	// We never block, our time simply advances by one frame
+	mock_session->display_time += MOCK_FRAME_PERIOD;
+	mock_session->frame_waited = true;
+	mock_instance->report.frames++;
+
+	frameState->predictedDisplayTime = mock_session->display_time;
+	frameState->predictedDisplayPeriod = MOCK_FRAME_PERIOD;
+	frameState->shouldRender = (mock_session->state == XR_SESSION_STATE_VISIBLE || mock_session->state == XR_SESSION_STATE_FOCUSED) ? XR_TRUE : XR_FALSE;
+	return XR_SUCCESS;
+}
+
+static XrResult XRAPI_CALL mock_xrBeginFrame(XrSession session, const XrFrameBeginInfo *frameBeginInfo) {
+	MOCK_LOCK;
+
+	if (!is_session(session)) {
+		return XR_ERROR_HANDLE_INVALID;
+	}
+
+	MockSession *mock_session = from_handle<MockSession>(session);
+	if (!mock_session->running) {
+		return XR_ERROR_SESSION_NOT_RUNNING;
+	} else if (!mock_session->frame_waited) {
+		return XR_ERROR_CALL_ORDER_INVALID;
+	}
+
+	mock_session->frame_waited = false;
+	if (mock_session->frame_begun) {
+		// the previous frame was never ended
+		return XR_FRAME_DISCARDED;
+	}
+
+	mock_session->frame_begun = true;
+	return XR_SUCCESS;
+}
+
+static XrResult XRAPI_CALL mock_xrEndFrame(XrSession session, const XrFrameEndInfo *frameEndInfo) {
+	MOCK_LOCK;
+
+	if (!is_session(session)) {
+		return XR_ERROR_HANDLE_INVALID;
+	} else if (frameEndInfo == nullptr) {
+		return XR_ERROR_VALIDATION_FAILURE;
+	}
+
+	MockSession *mock_session = from_handle<MockSession>(session);
+	if (!mock_session->running) {
+		return XR_ERROR_SESSION_NOT_RUNNING;
+	} else if (!mock_session->frame_begun) {
+		return XR_ERROR_CALL_ORDER_INVALID;
+	} else if (frameEndInfo->displayTime <= 0) {
+		return XR_ERROR_TIME_INVALID;
+	} else if (frameEndInfo->environmentBlendMode != XR_ENVIRONMENT_BLEND_MODE_OPAQUE) {
+		return XR_ERROR_ENVIRONMENT_BLEND_MODE_UNSUPPORTED;
+	} else if (frameEndInfo->layerCount > XR_MIN_COMPOSITION_LAYERS_SUPPORTED) {
+		return XR_ERROR_LAYER_LIMIT_EXCEEDED;
+	}
+
+	XrResult result = check_layers(frameEndInfo);
+	if (XR_FAILED(result)) {
+		return result;
+	}
+
+	mock_session->frame_begun = false;
+	return XR_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Display refresh rate, we only run at one
+
+static XrResult XRAPI_CALL mock_xrEnumerateDisplayRefreshRatesFB(XrSession session, uint32_t displayRefreshRateCapacityInput, uint32_t *displayRefreshRateCountOutput, float *displayRefreshRates) {
+	MOCK_LOCK;
+
+	if (!is_session(session)) {
+		return XR_ERROR_HANDLE_INVALID;
+	}
+
+	std::vector<float> refresh_rates(1, MOCK_REFRESH_RATE);
+	return copy_array(refresh_rates, displayRefreshRateCapacityInput, displayRefreshRateCountOutput, displayRefreshRates);
+}
+
+static XrResult XRAPI_CALL mock_xrGetDisplayRefreshRateFB(XrSession session, float *displayRefreshRate) {
+	MOCK_LOCK;
+
+	if (!is_session(session)) {
+		return XR_ERROR_HANDLE_INVALID;
+	} else if (displayRefreshRate == nullptr) {
+		return XR_ERROR_VALIDATION_FAILURE;
+	}
+
+	*displayRefreshRate = MOCK_REFRESH_RATE;
+	return XR_SUCCESS;
+}
+
+static XrResult XRAPI_CALL mock_xrRequestDisplayRefreshRateFB(XrSession session, float displayRefreshRate) {
+	MOCK_LOCK;
+
+	if (!is_session(session)) {
+		return XR_ERROR_HANDLE_INVALID;
+	} else if (displayRefreshRate != 0.0f && displayRefreshRate != MOCK_REFRESH_RATE) {
+		// 0.0 asks for our default
+		return XR_ERROR_DISPLAY_REFRESH_RATE_UNSUPPORTED_FB;
+	}
+
+	return XR_SUCCESS;
+}
+
+const MockFunction mock_session_functions[] = {
+	MOCK_FUNCTION(xrCreateSession),
+	MOCK_FUNCTION(xrDestroySession),
+	MOCK_FUNCTION(xrBeginSession),
+	MOCK_FUNCTION(xrEndSession),
+	MOCK_FUNCTION(xrRequestExitSession),
+	MOCK_FUNCTION(xrWaitFrame),
+	MOCK_FUNCTION(xrBeginFrame),
+	MOCK_FUNCTION(xrEndFrame),
+	MOCK_EXTENSION_FUNCTION(xrEnumerateDisplayRefreshRatesFB, display_refresh_rate_ext),
+	MOCK_EXTENSION_FUNCTION(xrGetDisplayRefreshRateFB, display_refresh_rate_ext),
+	MOCK_EXTENSION_FUNCTION(xrRequestDisplayRefreshRateFB, display_refresh_rate_ext),
+};
+const uint32_t mock_session_function_count = MOCK_FUNCTION_COUNT(mock_session_functions);
@@ -0,0 +1,258 @@
+#include "mock_runtime.h"
+
+bool is_space(XrSpace p_space) {
+	if (mock_instance == nullptr || mock_instance->session == nullptr) {
+		return false;
+	}
+
+	for (MockSpace *space : mock_instance->session->spaces) {
+		if (from_handle<MockSpace>(p_space) == space) {
+			return true;
+		}
+	}
+	return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Spaces
+
+static XrResult XRAPI_CALL mock_xrEnumerateReferenceSpaces(XrSession session, uint32_t spaceCapacityInput, uint32_t *spaceCountOutput, XrReferenceSpaceType *spaces) {
+	MOCK_LOCK;
+
+	if (!is_session(session)) {
+		return XR_ERROR_HANDLE_INVALID;
+	}
+
+	std::vector<XrReferenceSpaceType> types;
+	types.push_back(XR_REFERENCE_SPACE_TYPE_VIEW);
+	types.push_back(XR_REFERENCE_SPACE_TYPE_LOCAL);
+	types.push_back(XR_REFERENCE_SPACE_TYPE_STAGE);
+	return copy_array(types, spaceCapacityInput, spaceCountOutput, spaces);
+}
+
+static XrResult XRAPI_CALL mock_xrCreateReferenceSpace(XrSession session, const XrReferenceSpaceCreateInfo *createInfo, XrSpace *space) {
+	MOCK_LOCK;
+
+	if (!is_session(session)) {
+		return XR_ERROR_HANDLE_INVALID;
+	} else if (createInfo == nullptr || space == nullptr) {
+		return XR_ERROR_VALIDATION_FAILURE;
+	} else if (createInfo->referenceSpaceType != XR_REFERENCE_SPACE_TYPE_VIEW && createInfo->referenceSpaceType != XR_REFERENCE_SPACE_TYPE_LOCAL && createInfo->referenceSpaceType != XR_REFERENCE_SPACE_TYPE_STAGE) {
+		return XR_ERROR_REFERENCE_SPACE_UNSUPPORTED;
+	}
+
+	MockSpace *new_space = new MockSpace();
+	new_space->reference_space_type = createInfo->referenceSpaceType;
+	new_space->action = nullptr;
+	new_space->subaction_path = XR_NULL_PATH;
+	new_space->pose = createInfo->poseInReferenceSpace;
+	from_handle<MockSession>(session)->spaces.push_back(new_space);
+
+	*space = to_handle<XrSpace>(new_space);
+	return XR_SUCCESS;
+}
+
+static XrResult XRAPI_CALL mock_xrGetReferenceSpaceBoundsRect(XrSession session, XrReferenceSpaceType referenceSpaceType, XrExtent2Df *bounds) {
+	MOCK_LOCK;
+
+	if (!is_session(session)) {
+		return XR_ERROR_HANDLE_INVALID;
+	} else if (bounds == nullptr) {
+		return XR_ERROR_VALIDATION_FAILURE;
+	} else if (referenceSpaceType != XR_REFERENCE_SPACE_TYPE_VIEW && referenceSpaceType != XR_REFERENCE_SPACE_TYPE_LOCAL && referenceSpaceType != XR_REFERENCE_SPACE_TYPE_STAGE) {
+		return XR_ERROR_REFERENCE_SPACE_UNSUPPORTED;
+	}
+
+	if (referenceSpaceType == XR_REFERENCE_SPACE_TYPE_STAGE) {
+		bounds->width = 2.0f;
+		bounds->height = 1.5f;
+		return XR_SUCCESS;
+	}
+
+	bounds->width = 0.0f;
+	bounds->height = 0.0f;
+	return XR_SPACE_BOUNDS_UNAVAILABLE;
+}
+
+static XrResult XRAPI_CALL mock_xrCreateActionSpace(XrSession session, const XrActionSpaceCreateInfo *createInfo, XrSpace *space) {
+	MOCK_LOCK;
+
+	if (!is_session(session)) {
+		return XR_ERROR_HANDLE_INVALID;
+	} else if (createInfo == nullptr || space == nullptr) {
+		return XR_ERROR_VALIDATION_FAILURE;
+	} else if (!is_action(createInfo->action)) {
+		return XR_ERROR_HANDLE_INVALID;
+	}
+
+	MockAction *action = from_handle<MockAction>(createInfo->action);
+	if (action->type != XR_ACTION_TYPE_POSE_INPUT) {
+		return XR_ERROR_ACTION_TYPE_MISMATCH;
+	}
+
+	if (createInfo->subactionPath != XR_NULL_PATH) {
+		bool found = false;
+		for (XrPath path : action->subaction_paths) {
+			found = found || path == createInfo->subactionPath;
+		}
+		if (!found) {
+			return XR_ERROR_PATH_UNSUPPORTED;
+		}
+	}
+
+	MockSpace *new_space = new MockSpace();
+	new_space->reference_space_type = XR_REFERENCE_SPACE_TYPE_MAX_ENUM;
+	new_space->action = action;
+	new_space->subaction_path = createInfo->subactionPath;
+	new_space->pose = createInfo->poseInActionSpace;
+	from_handle<MockSession>(session)->spaces.push_back(new_space);
+
+	*space = to_handle<XrSpace>(new_space);
+	return XR_SUCCESS;
+}
+
+// The pose of our space in stage space, returns false if we're not tracking it
+bool get_space_pose(const MockSession *p_session, const MockSpace *p_space, XrTime p_time, XrPosef &r_pose) {
+	if (p_space->reference_space_type != XR_REFERENCE_SPACE_TYPE_MAX_ENUM) {
+		r_pose = pose_multiply(get_reference_space_pose(p_space->reference_space_type, p_time), p_space->pose);
+		return true;
+	} else if (p_space->spatial_anchor != nullptr) {
+		r_pose = pose_multiply(p_space->spatial_anchor->pose, p_space->pose);
+		return true;
+	}
+
+	XrHandEXT hand;
+	if (!get_action_space_hand(p_session, p_space, hand)) {
+		return false;
+	}
+
+	r_pose = pose_multiply(get_hand_pose(hand, p_time), p_space->pose);
+	return true;
+}
+
+static XrResult XRAPI_CALL mock_xrLocateSpace(XrSpace space, XrSpace baseSpace, XrTime time, XrSpaceLocation *location) {
+	MOCK_LOCK;
+
+	if (!is_space(space) || !is_space(baseSpace)) {
+		return XR_ERROR_HANDLE_INVALID;
+	} else if (location == nullptr) {
+		return XR_ERROR_VALIDATION_FAILURE;
+	} else if (time <= 0) {
+		return XR_ERROR_TIME_INVALID;
+	}
+
+	const MockSession *mock_session = mock_instance->session;
+	XrSpaceVelocity *velocity = find_next<XrSpaceVelocity>(location->next, XR_TYPE_SPACE_VELOCITY);
+
+	if (from_handle<MockSpace>(space)->spatial_anchor != nullptr) {
+		MockReport &report = mock_instance->report;
+		if (report.spatial_anchors_located.size() <= report.frames) {
+			report.spatial_anchors_located.resize(report.frames + 1, 0);
+		}
+		report.spatial_anchors_located[report.frames]++;
+	}
+
+	XrPosef space_pose;
+	XrPosef base_pose;
+	if (!get_space_pose(mock_session, from_handle<MockSpace>(space), time, space_pose) || !get_space_pose(mock_session, from_handle<MockSpace>(baseSpace), time, base_pose)) {
+		location->locationFlags = 0;
+		if (velocity != nullptr) {
+			velocity->velocityFlags = 0;
+		}
+		return XR_SUCCESS;
+	}
+
+	location->pose = pose_multiply(pose_inverse(base_pose), space_pose);
+	location->locationFlags = XR_SPACE_LOCATION_ORIENTATION_VALID_BIT | XR_SPACE_LOCATION_POSITION_VALID_BIT | XR_SPACE_LOCATION_ORIENTATION_TRACKED_BIT | XR_SPACE_LOCATION_POSITION_TRACKED_BIT;
+
+	if (velocity != nullptr) {
+		// difference with our pose one frame earlier, rotated into our base space
+		XrPosef previous_space_pose;
+		XrPosef previous_base_pose;
+		get_space_pose(mock_session, from_handle<MockSpace>(space), time - MOCK_FRAME_PERIOD, previous_space_pose);
+		get_space_pose(mock_session, from_handle<MockSpace>(baseSpace), time - MOCK_FRAME_PERIOD, previous_base_pose);
+		const XrPosef previous = pose_multiply(pose_inverse(previous_base_pose), previous_space_pose);
+
+		const float frequency = 1000000000.0f / float(MOCK_FRAME_PERIOD);
+		velocity->linearVelocity = {
+			(location->pose.position.x - previous.position.x) * frequency,
+			(location->pose.position.y - previous.position.y) * frequency,
+			(location->pose.position.z - previous.position.z) * frequency
+		};
+		velocity->angularVelocity = { 0.0f, 0.0f, 0.0f };
+		velocity->velocityFlags = XR_SPACE_VELOCITY_LINEAR_VALID_BIT | XR_SPACE_VELOCITY_ANGULAR_VALID_BIT;
+	}
+
+	return XR_SUCCESS;
+}
+
+static XrResult XRAPI_CALL mock_xrDestroySpace(XrSpace space) {
+	MOCK_LOCK;
+
+	if (!is_space(space)) {
+		return XR_ERROR_HANDLE_INVALID;
+	}
+
+	std::vector<MockSpace *> &spaces = mock_instance->session->spaces;
+	for (size_t i = 0; i < spaces.size(); i++) {
+		if (spaces[i] == from_handle<MockSpace>(space)) {
+			delete spaces[i];
+			spaces.erase(spaces.begin() + i);
+			break;
+		}
+	}
+	return XR_SUCCESS;
+}
+
+static XrResult XRAPI_CALL mock_xrLocateViews(XrSession session, const XrViewLocateInfo *viewLocateInfo, XrViewState *viewState, uint32_t viewCapacityInput, uint32_t *viewCountOutput, XrView *views) {
+	MOCK_LOCK;
+
+	if (!is_session(session)) {
+		return XR_ERROR_HANDLE_INVALID;
+	} else if (viewLocateInfo == nullptr || viewState == nullptr || viewCountOutput == nullptr) {
+		return XR_ERROR_VALIDATION_FAILURE;
+	} else if (viewLocateInfo->viewConfigurationType != XR_VIEW_CONFIGURATION_TYPE_PRIMARY_STEREO) {
+		return XR_ERROR_VIEW_CONFIGURATION_TYPE_UNSUPPORTED;
+	} else if (viewLocateInfo->displayTime <= 0) {
+		return XR_ERROR_TIME_INVALID;
+	} else if (!is_space(viewLocateInfo->space)) {
+		return XR_ERROR_HANDLE_INVALID;
+	}
+
+	*viewCountOutput = MOCK_VIEW_COUNT;
+	if (viewCapacityInput == 0) {
+		return XR_SUCCESS;
+	} else if (viewCapacityInput < MOCK_VIEW_COUNT) {
+		return XR_ERROR_SIZE_INSUFFICIENT;
+	} else if (views == nullptr) {
+		return XR_ERROR_VALIDATION_FAILURE;
+	}
+
+	const MockSession *mock_session = from_handle<MockSession>(session);
+	XrPosef base_pose;
+	if (!get_space_pose(mock_session, from_handle<MockSpace>(viewLocateInfo->space), viewLocateInfo->displayTime, base_pose)) {
+		viewState->viewStateFlags = 0;
+		return XR_SUCCESS;
+	}
+
+	const XrPosef head = pose_multiply(pose_inverse(base_pose), get_head_pose(viewLocateInfo->displayTime));
+	for (uint32_t i = 0; i < MOCK_VIEW_COUNT; i++) {
+		const XrPosef eye = { identity_pose.orientation, { i == 0 ? -0.032f : 0.032f, 0.0f, 0.0f } };
+		views[i].pose = pose_multiply(head, eye);
+		views[i].fov = { -0.785398f, 0.785398f, 0.785398f, -0.785398f };
+	}
+
+	viewState->viewStateFlags = XR_VIEW_STATE_ORIENTATION_VALID_BIT | XR_VIEW_STATE_POSITION_VALID_BIT | XR_VIEW_STATE_ORIENTATION_TRACKED_BIT | XR_VIEW_STATE_POSITION_TRACKED_BIT;
+	return XR_SUCCESS;
+}
+
+const MockFunction mock_space_functions[] = {
+	MOCK_FUNCTION(xrEnumerateReferenceSpaces),
+	MOCK_FUNCTION(xrCreateReferenceSpace),
+	MOCK_FUNCTION(xrGetReferenceSpaceBoundsRect),
+	MOCK_FUNCTION(xrCreateActionSpace),
+	MOCK_FUNCTION(xrLocateSpace),
+	MOCK_FUNCTION(xrDestroySpace),
+	MOCK_FUNCTION(xrLocateViews),
+};
+const uint32_t mock_space_function_count = MOCK_FUNCTION_COUNT(mock_space_functions);
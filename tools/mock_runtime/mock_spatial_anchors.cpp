@@ -0,0 +1,104 @@
+#include "mock_runtime.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// XR_MSFT_spatial_anchor
+
+bool is_spatial_anchor(XrSpatialAnchorMSFT p_spatial_anchor) {
+	if (mock_instance == nullptr || mock_instance->session == nullptr) {
+		return false;
+	}
+
+	for (MockSpatialAnchor *spatial_anchor : mock_instance->session->spatial_anchors) {
+		if (from_handle<MockSpatialAnchor>(p_spatial_anchor) == spatial_anchor) {
+			return true;
+		}
+	}
+	return false;
+}
+
+static XrResult XRAPI_CALL mock_xrCreateSpatialAnchorMSFT(XrSession session, const XrSpatialAnchorCreateInfoMSFT *createInfo, XrSpatialAnchorMSFT *anchor) {
+	MOCK_LOCK;
+
+	if (!is_session(session)) {
+		return XR_ERROR_HANDLE_INVALID;
+	} else if (createInfo == nullptr || anchor == nullptr) {
+		return XR_ERROR_VALIDATION_FAILURE;
+	} else if (!is_space(createInfo->space)) {
+		return XR_ERROR_HANDLE_INVALID;
+	} else if (createInfo->time <= 0) {
+		return XR_ERROR_TIME_INVALID;
+	}
+
+	MockSession *mock_session = from_handle<MockSession>(session);
+	XrPosef space_pose;
+	if (!get_space_pose(mock_session, from_handle<MockSpace>(createInfo->space), createInfo->time, space_pose)) {
+		return XR_ERROR_CREATE_SPATIAL_ANCHOR_FAILED_MSFT;
+	}
+
+	// our anchor stays where it was created
+	MockSpatialAnchor *new_spatial_anchor = new MockSpatialAnchor();
+	new_spatial_anchor->pose = pose_multiply(space_pose, createInfo->pose);
+	mock_session->spatial_anchors.push_back(new_spatial_anchor);
+	mock_instance->report.spatial_anchors_created++;
+
+	*anchor = to_handle<XrSpatialAnchorMSFT>(new_spatial_anchor);
+	return XR_SUCCESS;
+}
+
+static XrResult XRAPI_CALL mock_xrCreateSpatialAnchorSpaceMSFT(XrSession session, const XrSpatialAnchorSpaceCreateInfoMSFT *createInfo, XrSpace *space) {
+	MOCK_LOCK;
+
+	if (!is_session(session)) {
+		return XR_ERROR_HANDLE_INVALID;
+	} else if (createInfo == nullptr || space == nullptr) {
+		return XR_ERROR_VALIDATION_FAILURE;
+	} else if (!is_spatial_anchor(createInfo->anchor)) {
+		return XR_ERROR_HANDLE_INVALID;
+	}
+
+	MockSpace *new_space = new MockSpace();
+	new_space->reference_space_type = XR_REFERENCE_SPACE_TYPE_MAX_ENUM;
+	new_space->spatial_anchor = from_handle<MockSpatialAnchor>(createInfo->anchor);
+	new_space->pose = createInfo->poseInAnchorSpace;
+	from_handle<MockSession>(session)->spaces.push_back(new_space);
+
+	*space = to_handle<XrSpace>(new_space);
+	return XR_SUCCESS;
+}
+
+static XrResult XRAPI_CALL mock_xrDestroySpatialAnchorMSFT(XrSpatialAnchorMSFT anchor) {
+	MOCK_LOCK;
+
+	if (!is_spatial_anchor(anchor)) {
+		return XR_ERROR_HANDLE_INVALID;
+	}
+
+	MockSession *mock_session = mock_instance->session;
+	const MockSpatialAnchor *spatial_anchor = from_handle<MockSpatialAnchor>(anchor);
+
+	// spaces created from our anchor stay valid but are no longer located
+	for (MockSpace *space : mock_session->spaces) {
+		if (space->spatial_anchor == spatial_anchor) {
+			space->spatial_anchor = nullptr;
+		}
+	}
+
+	std::vector<MockSpatialAnchor *> &spatial_anchors = mock_session->spatial_anchors;
+	for (size_t i = 0; i < spatial_anchors.size(); i++) {
+		if (spatial_anchors[i] == spatial_anchor) {
+			delete spatial_anchors[i];
+			spatial_anchors.erase(spatial_anchors.begin() + i);
+			break;
+		}
+	}
+
+	mock_instance->report.spatial_anchors_destroyed++;
+	return XR_SUCCESS;
+}
+
+const MockFunction mock_spatial_anchor_functions[] = {
+	MOCK_EXTENSION_FUNCTION(xrCreateSpatialAnchorMSFT, spatial_anchor_ext),
+	MOCK_EXTENSION_FUNCTION(xrCreateSpatialAnchorSpaceMSFT, spatial_anchor_ext),
+	MOCK_EXTENSION_FUNCTION(xrDestroySpatialAnchorMSFT, spatial_anchor_ext),
+};
+const uint32_t mock_spatial_anchor_function_count = MOCK_FUNCTION_COUNT(mock_spatial_anchor_functions);
@@ -0,0 +1,503 @@
+#include "mock_runtime.h"
+
+#include <stdarg.h>
+#include <stdio.h>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#define MOCK_GL_CALL __stdcall
+#else
+#include <dlfcn.h>
+#define MOCK_GL_CALL
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// OpenGL, we only need OpenGL 1.1 functions which every libGL and opengl32.dll exports so we
+// load these ourselves instead of linking to OpenGL.
+
+#define MOCK_GL_TEXTURE_2D 0x0DE1
+#define MOCK_GL_TEXTURE_BINDING_2D 0x8069
+#define MOCK_GL_TEXTURE_MIN_FILTER 0x2801
+#define MOCK_GL_LINEAR 0x2601
+#define MOCK_GL_NO_ERROR 0
+
+#define MOCK_GL_RGBA 0x1908
+#define MOCK_GL_DEPTH_COMPONENT 0x1902
+#define MOCK_GL_DEPTH_STENCIL 0x84F9
+#define MOCK_GL_UNSIGNED_BYTE 0x1401
+#define MOCK_GL_UNSIGNED_INT 0x1405
+#define MOCK_GL_HALF_FLOAT 0x140B
+#define MOCK_GL_UNSIGNED_INT_24_8 0x84FA
+
+#define MOCK_GL_SRGB8_ALPHA8 0x8C43
+#define MOCK_GL_RGBA8 0x8058
+#define MOCK_GL_RGBA16F 0x881A
+#define MOCK_GL_DEPTH24_STENCIL8 0x88F0
+#define MOCK_GL_DEPTH_COMPONENT24 0x81A6
+
+typedef void(MOCK_GL_CALL *PFN_glGenTextures)(int n, uint32_t *textures);
+typedef void(MOCK_GL_CALL *PFN_glDeleteTextures)(int n, const uint32_t *textures);
+typedef void(MOCK_GL_CALL *PFN_glBindTexture)(uint32_t target, uint32_t texture);
+typedef void(MOCK_GL_CALL *PFN_glTexImage2D)(uint32_t target, int level, int internalformat, int width, int height, int border, uint32_t format, uint32_t type, const void *pixels);
+typedef void(MOCK_GL_CALL *PFN_glTexParameteri)(uint32_t target, uint32_t pname, int param);
+typedef void(MOCK_GL_CALL *PFN_glGetIntegerv)(uint32_t pname, int *data);
+typedef uint32_t(MOCK_GL_CALL *PFN_glGetError)();
+
+static PFN_glGenTextures mock_glGenTextures = nullptr;
+static PFN_glDeleteTextures mock_glDeleteTextures = nullptr;
+static PFN_glBindTexture mock_glBindTexture = nullptr;
+static PFN_glTexImage2D mock_glTexImage2D = nullptr;
+static PFN_glTexParameteri mock_glTexParameteri = nullptr;
+static PFN_glGetIntegerv mock_glGetIntegerv = nullptr;
+static PFN_glGetError mock_glGetError = nullptr;
+
+template <typename T>
+static bool load_opengl_function(void *p_library, const char *p_name, T &r_function) {
+#ifdef _WIN32
+	r_function = (T)GetProcAddress((HMODULE)p_library, p_name);
+#else
+	r_function = (T)dlsym(p_library, p_name);
+#endif
+	return r_function != nullptr;
+}
+
+bool load_opengl() {
+	static bool loaded = false;
+	if (loaded) {
+		return true;
+	}
+
+#ifdef _WIN32
+	void *library = (void *)LoadLibraryA("opengl32.dll");
+#else
+	void *library = dlopen("libGL.so.1", RTLD_NOW | RTLD_GLOBAL);
+#endif
+	if (library == nullptr) {
+		fprintf(stderr, "OpenXR mock runtime couldn't load OpenGL\n");
+		return false;
+	}
+
+	// we keep our library loaded, our textures live as long as the application's context
+	loaded = load_opengl_function(library, "glGenTextures", mock_glGenTextures) &&
+			load_opengl_function(library, "glDeleteTextures", mock_glDeleteTextures) &&
+			load_opengl_function(library, "glBindTexture", mock_glBindTexture) &&
+			load_opengl_function(library, "glTexImage2D", mock_glTexImage2D) &&
+			load_opengl_function(library, "glTexParameteri", mock_glTexParameteri) &&
+			load_opengl_function(library, "glGetIntegerv", mock_glGetIntegerv) &&
+			load_opengl_function(library, "glGetError", mock_glGetError);
+	return loaded;
+}
+
+static XrResult XRAPI_CALL mock_xrGetOpenGLGraphicsRequirementsKHR(XrInstance instance, XrSystemId systemId, XrGraphicsRequirementsOpenGLKHR *graphicsRequirements) {
+	MOCK_LOCK;
+
+	if (!is_instance(instance)) {
+		return XR_ERROR_HANDLE_INVALID;
+	} else if (systemId != MOCK_SYSTEM_ID) {
+		return XR_ERROR_SYSTEM_INVALID;
+	} else if (graphicsRequirements == nullptr || graphicsRequirements->type != XR_TYPE_GRAPHICS_REQUIREMENTS_OPENGL_KHR) {
+		return XR_ERROR_VALIDATION_FAILURE;
+	}
+
+	graphicsRequirements->minApiVersionSupported = XR_MAKE_VERSION(3, 3, 0);
+	graphicsRequirements->maxApiVersionSupported = XR_MAKE_VERSION(4, 6, 0);
+	mock_instance->graphics_requirements_queried = true;
+	return XR_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Swapchains, our images are textures in the application's current OpenGL context.
+// Headless sessions have no formats and can't create swapchains.
+
+static const uint32_t MOCK_SWAPCHAIN_IMAGE_COUNT = 3;
+
+struct MockFormat {
+	int64_t format; // the internal format, which is what OpenXR calls our format
+	uint32_t pixel_format;
+	uint32_t pixel_type;
+	bool depth;
+};
+
+// in our order of preference
+static const MockFormat mock_formats[] = {
+	{ MOCK_GL_SRGB8_ALPHA8, MOCK_GL_RGBA, MOCK_GL_UNSIGNED_BYTE, false },
+	{ MOCK_GL_RGBA8, MOCK_GL_RGBA, MOCK_GL_UNSIGNED_BYTE, false },
+	{ MOCK_GL_RGBA16F, MOCK_GL_RGBA, MOCK_GL_HALF_FLOAT, false },
+	{ MOCK_GL_DEPTH24_STENCIL8, MOCK_GL_DEPTH_STENCIL, MOCK_GL_UNSIGNED_INT_24_8, true },
+	{ MOCK_GL_DEPTH_COMPONENT24, MOCK_GL_DEPTH_COMPONENT, MOCK_GL_UNSIGNED_INT, true },
+};
+
+bool is_swapchain(XrSwapchain p_swapchain) {
+	if (mock_instance == nullptr || mock_instance->session == nullptr) {
+		return false;
+	}
+
+	for (MockSwapchain *swapchain : mock_instance->session->swapchains) {
+		if (from_handle<MockSwapchain>(p_swapchain) == swapchain) {
+			return true;
+		}
+	}
+	return false;
+}
+
+static void destroy_swapchain(MockSwapchain *p_swapchain) {
+	if (!p_swapchain->textures.empty()) {
+		mock_glDeleteTextures((int)p_swapchain->textures.size(), p_swapchain->textures.data());
+	}
+	delete p_swapchain;
+}
+
+void destroy_swapchains(MockSession *p_session) {
+	for (MockSwapchain *swapchain : p_session->swapchains) {
+		destroy_swapchain(swapchain);
+	}
+	p_session->swapchains.clear();
+}
+
+static XrResult XRAPI_CALL mock_xrEnumerateSwapchainFormats(XrSession session, uint32_t formatCapacityInput, uint32_t *formatCountOutput, int64_t *formats) {
+	MOCK_LOCK;
+
+	if (!is_session(session)) {
+		return XR_ERROR_HANDLE_INVALID;
+	}
+
+	std::vector<int64_t> supported_formats;
+	if (from_handle<MockSession>(session)->opengl) {
+		for (const MockFormat &format : mock_formats) {
+			supported_formats.push_back(format.format);
+		}
+	}
+	return copy_array(supported_formats, formatCapacityInput, formatCountOutput, formats);
+}
+
+static XrResult XRAPI_CALL mock_xrCreateSwapchain(XrSession session, const XrSwapchainCreateInfo *createInfo, XrSwapchain *swapchain) {
+	MOCK_LOCK;
+
+	if (!is_session(session)) {
+		return XR_ERROR_HANDLE_INVALID;
+	} else if (createInfo == nullptr || swapchain == nullptr || createInfo->type != XR_TYPE_SWAPCHAIN_CREATE_INFO) {
+		return XR_ERROR_VALIDATION_FAILURE;
+	}
+
+	MockSession *mock_session = from_handle<MockSession>(session);
+	const MockFormat *format = nullptr;
+	for (const MockFormat &supported_format : mock_formats) {
+		if (supported_format.format == createInfo->format) {
+			format = &supported_format;
+		}
+	}
+
+	if (!mock_session->opengl || format == nullptr) {
+		return XR_ERROR_SWAPCHAIN_FORMAT_UNSUPPORTED;
+	} else if (createInfo->width == 0 || createInfo->height == 0 || createInfo->width > MOCK_MAX_IMAGE_SIZE || createInfo->height > MOCK_MAX_IMAGE_SIZE) {
+		return XR_ERROR_VALIDATION_FAILURE;
+	} else if (createInfo->createFlags != 0 || createInfo->sampleCount != 1 || createInfo->faceCount != 1 || createInfo->arraySize != 1 || createInfo->mipCount != 1) {
+		// we keep it simple, one plain 2D texture per image
+		return XR_ERROR_FEATURE_UNSUPPORTED;
+	}
+
+	const XrSwapchainUsageFlags attachment = format->depth ? XR_SWAPCHAIN_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT : XR_SWAPCHAIN_USAGE_COLOR_ATTACHMENT_BIT;
+	const XrSwapchainUsageFlags wrong_attachment = format->depth ? XR_SWAPCHAIN_USAGE_COLOR_ATTACHMENT_BIT : XR_SWAPCHAIN_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
+	if ((createInfo->usageFlags & wrong_attachment) != 0 || (createInfo->usageFlags & attachment) == 0) {
+		return XR_ERROR_FEATURE_UNSUPPORTED;
+	}
+
+	MockSwapchain *new_swapchain = new MockSwapchain();
+	new_swapchain->usage = createInfo->usageFlags;
+	new_swapchain->format = createInfo->format;
+	new_swapchain->width = createInfo->width;
+	new_swapchain->height = createInfo->height;
+	new_swapchain->textures.assign(MOCK_SWAPCHAIN_IMAGE_COUNT, 0);
+
+	// leave the application's texture binding as it was
+	int previous_texture = 0;
+	mock_glGetIntegerv(MOCK_GL_TEXTURE_BINDING_2D, &previous_texture);
+	while (mock_glGetError() != MOCK_GL_NO_ERROR) {
+		// clear errors that aren't ours
+	}
+
+	mock_glGenTextures(MOCK_SWAPCHAIN_IMAGE_COUNT, new_swapchain->textures.data());
+	for (uint32_t texture : new_swapchain->textures) {
+		mock_glBindTexture(MOCK_GL_TEXTURE_2D, texture);
+		mock_glTexParameteri(MOCK_GL_TEXTURE_2D, MOCK_GL_TEXTURE_MIN_FILTER, MOCK_GL_LINEAR);
+		mock_glTexImage2D(MOCK_GL_TEXTURE_2D, 0, (int)format->format, (int)createInfo->width, (int)createInfo->height, 0, format->pixel_format, format->pixel_type, nullptr);
+	}
+	mock_glBindTexture(MOCK_GL_TEXTURE_2D, (uint32_t)previous_texture);
+
+	if (mock_glGetError() != MOCK_GL_NO_ERROR || new_swapchain->textures[0] == 0) {
+		// most likely there is no current context
+		destroy_swapchain(new_swapchain);
+		return XR_ERROR_RUNTIME_FAILURE;
+	}
+
+	mock_session->swapchains.push_back(new_swapchain);
+	*swapchain = to_handle<XrSwapchain>(new_swapchain);
+	return XR_SUCCESS;
+}
+
+static XrResult XRAPI_CALL mock_xrDestroySwapchain(XrSwapchain swapchain) {
+	MOCK_LOCK;
+
+	if (!is_swapchain(swapchain)) {
+		return XR_ERROR_HANDLE_INVALID;
+	}
+
+	std::vector<MockSwapchain *> &swapchains = mock_instance->session->swapchains;
+	for (size_t i = 0; i < swapchains.size(); i++) {
+		if (swapchains[i] == from_handle<MockSwapchain>(swapchain)) {
+			swapchains.erase(swapchains.begin() + i);
+			break;
+		}
+	}
+
+	destroy_swapchain(from_handle<MockSwapchain>(swapchain));
+	return XR_SUCCESS;
+}
+
+static XrResult XRAPI_CALL mock_xrEnumerateSwapchainImages(XrSwapchain swapchain, uint32_t imageCapacityInput, uint32_t *imageCountOutput, XrSwapchainImageBaseHeader *images) {
+	MOCK_LOCK;
+
+	if (!is_swapchain(swapchain)) {
+		return XR_ERROR_HANDLE_INVALID;
+	} else if (imageCountOutput == nullptr) {
+		return XR_ERROR_VALIDATION_FAILURE;
+	}
+
+	const MockSwapchain *mock_swapchain = from_handle<MockSwapchain>(swapchain);
+	*imageCountOutput = (uint32_t)mock_swapchain->textures.size();
+	if (imageCapacityInput == 0) {
+		return XR_SUCCESS;
+	} else if (imageCapacityInput < mock_swapchain->textures.size()) {
+		return XR_ERROR_SIZE_INSUFFICIENT;
+	} else if (images == nullptr) {
+		return XR_ERROR_VALIDATION_FAILURE;
+	}
+
+	XrSwapchainImageOpenGLKHR *gl_images = (XrSwapchainImageOpenGLKHR *)images;
+	for (size_t i = 0; i < mock_swapchain->textures.size(); i++) {
+		if (gl_images[i].type != XR_TYPE_SWAPCHAIN_IMAGE_OPENGL_KHR) {
+			return XR_ERROR_VALIDATION_FAILURE;
+		}
+		gl_images[i].image = mock_swapchain->textures[i];
+	}
+	return XR_SUCCESS;
+}
+
+static XrResult XRAPI_CALL mock_xrAcquireSwapchainImage(XrSwapchain swapchain, const XrSwapchainImageAcquireInfo *acquireInfo, uint32_t *index) {
+	MOCK_LOCK;
+
+	if (!is_swapchain(swapchain)) {
+		return XR_ERROR_HANDLE_INVALID;
+	} else if (index == nullptr) {
+		return XR_ERROR_VALIDATION_FAILURE;
+	}
+
+	MockSwapchain *mock_swapchain = from_handle<MockSwapchain>(swapchain);
+	if (mock_swapchain->acquired.size() == mock_swapchain->textures.size()) {
+		// the application holds on to all our images
+		return XR_ERROR_CALL_ORDER_INVALID;
+	}
+
+	*index = mock_swapchain->next_image;
+	mock_swapchain->acquired.push_back(mock_swapchain->next_image);
+	mock_swapchain->next_image = (mock_swapchain->next_image + 1) % mock_swapchain->textures.size();
+	return XR_SUCCESS;
+}
+
+static XrResult XRAPI_CALL mock_xrWaitSwapchainImage(XrSwapchain swapchain, const XrSwapchainImageWaitInfo *waitInfo) {
+	MOCK_LOCK;
+
+	if (!is_swapchain(swapchain)) {
+		return XR_ERROR_HANDLE_INVALID;
+	}
+
+	// We never block, we do check an acquired image was waiting to be waited on
+	MockSwapchain *mock_swapchain = from_handle<MockSwapchain>(swapchain);
+	if (mock_swapchain->waited == mock_swapchain->acquired.size()) {
+		return XR_ERROR_CALL_ORDER_INVALID;
+	}
+
+	mock_swapchain->waited++;
+	return XR_SUCCESS;
+}
+
+static XrResult XRAPI_CALL mock_xrReleaseSwapchainImage(XrSwapchain swapchain, const XrSwapchainImageReleaseInfo *releaseInfo) {
+	MOCK_LOCK;
+
+	if (!is_swapchain(swapchain)) {
+		return XR_ERROR_HANDLE_INVALID;
+	}
+
+	// images are released in the order they were acquired, and must have been waited on
+	MockSwapchain *mock_swapchain = from_handle<MockSwapchain>(swapchain);
+	if (mock_swapchain->waited == 0) {
+		return XR_ERROR_CALL_ORDER_INVALID;
+	}
+
+	mock_swapchain->acquired.pop_front();
+	mock_swapchain->waited--;
+	mock_swapchain->released++;
+	return XR_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Layers, we don't composite anything but we do check what we're given like a runtime would.
+// Problems are added to our report so our tests can show exactly what was wrong.
+
+static const size_t MOCK_MAX_LAYER_ERRORS = 100;
+
+static void add_layer_error(const char *p_format, ...) {
+	std::vector<std::string> &errors = mock_instance->report.layer_errors;
+	if (errors.size() >= MOCK_MAX_LAYER_ERRORS) {
+		return;
+	}
+
+	char message[256];
+	va_list args;
+	va_start(args, p_format);
+	vsnprintf(message, sizeof(message), p_format, args);
+	va_end(args);
+
+	char error[300];
+	snprintf(error, sizeof(error), "frame %llu: %s", (unsigned long long)mock_instance->report.frames, message);
+	errors.push_back(error);
+}
+
+static bool check_sub_image(const XrSwapchainSubImage &p_sub_image, XrSwapchainUsageFlags p_usage, const char *p_name) {
+	if (!is_swapchain(p_sub_image.swapchain)) {
+		add_layer_error("%s uses an invalid swapchain", p_name);
+		return false;
+	}
+
+	const MockSwapchain *swapchain = from_handle<MockSwapchain>(p_sub_image.swapchain);
+	const XrRect2Di &rect = p_sub_image.imageRect;
+	bool valid = true;
+	if (swapchain->released == 0) {
+		add_layer_error("%s uses a swapchain that never released an image", p_name);
+		valid = false;
+	}
+	if ((swapchain->usage & p_usage) != p_usage) {
+		add_layer_error("%s uses a swapchain created without usage flags 0x%llx", p_name, (unsigned long long)p_usage);
+		valid = false;
+	}
+	if (rect.offset.x < 0 || rect.offset.y < 0 || rect.extent.width <= 0 || rect.extent.height <= 0 ||
+			uint32_t(rect.offset.x + rect.extent.width) > swapchain->width || uint32_t(rect.offset.y + rect.extent.height) > swapchain->height) {
+		add_layer_error("%s image rect %dx%d at %d,%d doesn't fit its %ux%u swapchain", p_name,
+				rect.extent.width, rect.extent.height, rect.offset.x, rect.offset.y, swapchain->width, swapchain->height);
+		valid = false;
+	}
+	if (p_sub_image.imageArrayIndex != 0) {
+		add_layer_error("%s uses array index %u of a swapchain without arrays", p_name, p_sub_image.imageArrayIndex);
+		valid = false;
+	}
+	return valid;
+}
+
+static bool check_space_warp_info(const XrCompositionLayerSpaceWarpInfoFB &p_info, uint32_t p_view) {
+	if (!mock_instance->space_warp_ext) {
+		add_layer_error("view %u has space warp info without XR_FB_space_warp", p_view);
+		return false;
+	}
+
+	char name[64];
+	snprintf(name, sizeof(name), "view %u motion vectors", p_view);
+	bool valid = check_sub_image(p_info.motionVectorSubImage, XR_SWAPCHAIN_USAGE_COLOR_ATTACHMENT_BIT, name);
+	if (valid && from_handle<MockSwapchain>(p_info.motionVectorSubImage.swapchain)->format != MOCK_GL_RGBA16F) {
+		add_layer_error("%s aren't GL_RGBA16F", name);
+		valid = false;
+	}
+
+	snprintf(name, sizeof(name), "view %u depth", p_view);
+	valid = check_sub_image(p_info.depthSubImage, XR_SWAPCHAIN_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT, name) && valid;
+
+	if (!(p_info.minDepth >= 0.0f && p_info.minDepth < p_info.maxDepth && p_info.maxDepth <= 1.0f)) {
+		add_layer_error("view %u depth range %f - %f is invalid", p_view, p_info.minDepth, p_info.maxDepth);
+		valid = false;
+	}
+	if (!(p_info.nearZ > 0.0f && p_info.farZ > 0.0f && p_info.nearZ != p_info.farZ)) {
+		add_layer_error("view %u near %f and far %f are invalid", p_view, p_info.nearZ, p_info.farZ);
+		valid = false;
+	}
+	return valid;
+}
+
+static bool check_projection_layer(const XrCompositionLayerProjection &p_layer) {
+	if (!is_space(p_layer.space)) {
+		add_layer_error("projection layer uses an invalid space");
+		return false;
+	} else if (p_layer.viewCount != MOCK_VIEW_COUNT || p_layer.views == nullptr) {
+		add_layer_error("projection layer has %u views, we have %u", p_layer.viewCount, MOCK_VIEW_COUNT);
+		return false;
+	}
+
+	bool valid = true;
+	uint32_t space_warp_views = 0;
+	bool skip_frame = false;
+	for (uint32_t i = 0; i < p_layer.viewCount; i++) {
+		const XrCompositionLayerProjectionView &view = p_layer.views[i];
+		if (view.type != XR_TYPE_COMPOSITION_LAYER_PROJECTION_VIEW) {
+			add_layer_error("view %u is not a projection view", i);
+			valid = false;
+			continue;
+		}
+
+		char name[64];
+		snprintf(name, sizeof(name), "view %u", i);
+		valid = check_sub_image(view.subImage, XR_SWAPCHAIN_USAGE_COLOR_ATTACHMENT_BIT, name) && valid;
+
+		const XrCompositionLayerSpaceWarpInfoFB *space_warp_info = find_next<XrCompositionLayerSpaceWarpInfoFB>(view.next, XR_TYPE_COMPOSITION_LAYER_SPACE_WARP_INFO_FB);
+		if (space_warp_info != nullptr) {
+			valid = check_space_warp_info(*space_warp_info, i) && valid;
+			space_warp_views++;
+			skip_frame = skip_frame || (space_warp_info->layerFlags & XR_COMPOSITION_LAYER_SPACE_WARP_INFO_FRAME_SKIP_BIT_FB) != 0;
+		}
+	}
+
+	if (space_warp_views == p_layer.viewCount) {
+		mock_instance->report.space_warp_frames++;
+		if (skip_frame) {
+			mock_instance->report.space_warp_skipped_frames++;
+		}
+	} else if (space_warp_views != 0) {
+		add_layer_error("space warp info on %u of %u views", space_warp_views, p_layer.viewCount);
+		valid = false;
+	}
+	return valid;
+}
+
+XrResult check_layers(const XrFrameEndInfo *p_frame_end_info) {
+	if (p_frame_end_info->layerCount > 0 && p_frame_end_info->layers == nullptr) {
+		return XR_ERROR_VALIDATION_FAILURE;
+	}
+
+	bool valid = true;
+	bool has_projection_layer = false;
+	for (uint32_t i = 0; i < p_frame_end_info->layerCount; i++) {
+		const XrCompositionLayerBaseHeader *layer = p_frame_end_info->layers[i];
+		if (layer == nullptr) {
+			return XR_ERROR_LAYER_INVALID;
+		} else if (layer->type == XR_TYPE_COMPOSITION_LAYER_PROJECTION) {
+			has_projection_layer = true;
+			valid = check_projection_layer(*(const XrCompositionLayerProjection *)layer) && valid;
+		}
+		// other layers, i.e. quads from composition layer providers, we accept as they are
+	}
+
+	if (has_projection_layer) {
+		mock_instance->report.submitted_frames++;
+	}
+	return valid ? XR_SUCCESS : XR_ERROR_LAYER_INVALID;
+}
+
+const MockFunction mock_swapchain_functions[] = {
+	MOCK_EXTENSION_FUNCTION(xrGetOpenGLGraphicsRequirementsKHR, opengl_ext),
+	MOCK_FUNCTION(xrEnumerateSwapchainFormats),
+	MOCK_FUNCTION(xrCreateSwapchain),
+	MOCK_FUNCTION(xrDestroySwapchain),
+	MOCK_FUNCTION(xrEnumerateSwapchainImages),
+	MOCK_FUNCTION(xrAcquireSwapchainImage),
+	MOCK_FUNCTION(xrWaitSwapchainImage),
+	MOCK_FUNCTION(xrReleaseSwapchainImage),
+};
+const uint32_t mock_swapchain_function_count = MOCK_FUNCTION_COUNT(mock_swapchain_functions);
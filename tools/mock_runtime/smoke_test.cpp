@@ -0,0 +1,380 @@
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Smoke test for our mock OpenXR runtime
+//
+// Loads the runtime through the OpenXR loader, point XR_RUNTIME_JSON at openxr_mock_runtime.json,
+// and runs a headless session with actions, hand tracking and a spatial anchor for a number of frames:
+//   openxr_mock_runtime_test [frames]
+// Exits with 0 if the runtime behaved as expected, prints what failed and exits with 1 otherwise.
+
+#include <openxr/openxr.h>
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static int failures = 0;
+
+#define CHECK_RESULT(m_call)                                                               \
+	{                                                                                      \
+		XrResult check_result = m_call;                                                    \
+		if (XR_FAILED(check_result)) {                                                     \
+			printf("FAILED: %s returned %d (line %d)\n", #m_call, check_result, __LINE__); \
+			return false;                                                                  \
+		}                                                                                  \
+	}
+
+#define CHECK(m_condition, m_message)                          \
+	if (!(m_condition)) {                                      \
+		printf("FAILED: %s (line %d)\n", m_message, __LINE__); \
+		failures++;                                            \
+	}
+
+struct SmokeTest {
+	XrInstance instance = XR_NULL_HANDLE;
+	XrSystemId system_id = XR_NULL_SYSTEM_ID;
+	XrSession session = XR_NULL_HANDLE;
+	XrSessionState state = XR_SESSION_STATE_UNKNOWN;
+	bool running = false;
+	bool exiting = false;
+
+	XrActionSet action_set = XR_NULL_HANDLE;
+	XrAction select_action = XR_NULL_HANDLE;
+	XrAction aim_action = XR_NULL_HANDLE;
+	XrPath hand_paths[2] = { XR_NULL_PATH, XR_NULL_PATH };
+
+	XrSpace stage_space = XR_NULL_HANDLE;
+	XrSpace aim_spaces[2] = { XR_NULL_HANDLE, XR_NULL_HANDLE };
+
+	PFN_xrCreateHandTrackerEXT xrCreateHandTrackerEXT_ptr = nullptr;
+	PFN_xrDestroyHandTrackerEXT xrDestroyHandTrackerEXT_ptr = nullptr;
+	PFN_xrLocateHandJointsEXT xrLocateHandJointsEXT_ptr = nullptr;
+	XrHandTrackerEXT hand_trackers[2] = { XR_NULL_HANDLE, XR_NULL_HANDLE };
+
+	PFN_xrCreateSpatialAnchorMSFT xrCreateSpatialAnchorMSFT_ptr = nullptr;
+	PFN_xrCreateSpatialAnchorSpaceMSFT xrCreateSpatialAnchorSpaceMSFT_ptr = nullptr;
+	PFN_xrDestroySpatialAnchorMSFT xrDestroySpatialAnchorMSFT_ptr = nullptr;
+	XrSpatialAnchorMSFT anchor = XR_NULL_HANDLE;
+	XrSpace anchor_space = XR_NULL_HANDLE;
+	XrVector3f anchor_position = { 0.5f, 1.0f, -1.0f };
+
+	uint32_t frames_rendered = 0;
+	uint32_t frames_focused = 0;
+	uint32_t select_changes = 0;
+	XrTime last_display_time = 0;
+
+	bool create_instance();
+	bool create_actions();
+	bool create_session();
+	bool poll_events();
+	bool run_frame();
+	void cleanup();
+};
+
+bool SmokeTest::create_instance() {
+	const char *extensions[] = { XR_MND_HEADLESS_EXTENSION_NAME, XR_EXT_HAND_TRACKING_EXTENSION_NAME, XR_MSFT_SPATIAL_ANCHOR_EXTENSION_NAME };
+
+	XrInstanceCreateInfo create_info = { XR_TYPE_INSTANCE_CREATE_INFO };
+	strcpy(create_info.applicationInfo.applicationName, "mock runtime smoke test");
+	create_info.applicationInfo.applicationVersion = 1;
+	strcpy(create_info.applicationInfo.engineName, "none");
+	create_info.applicationInfo.apiVersion = XR_CURRENT_API_VERSION;
+	create_info.enabledExtensionCount = 3;
+	create_info.enabledExtensionNames = extensions;
+	CHECK_RESULT(xrCreateInstance(&create_info, &instance));
+
+	XrSystemGetInfo system_get_info = { XR_TYPE_SYSTEM_GET_INFO };
+	system_get_info.formFactor = XR_FORM_FACTOR_HEAD_MOUNTED_DISPLAY;
+	CHECK_RESULT(xrGetSystem(instance, &system_get_info, &system_id));
+
+	XrSystemHandTrackingPropertiesEXT hand_tracking_properties = { XR_TYPE_SYSTEM_HAND_TRACKING_PROPERTIES_EXT };
+	XrSystemProperties system_properties = { XR_TYPE_SYSTEM_PROPERTIES, &hand_tracking_properties };
+	CHECK_RESULT(xrGetSystemProperties(instance, system_id, &system_properties));
+	CHECK(hand_tracking_properties.supportsHandTracking == XR_TRUE, "hand tracking is supported");
+
+	CHECK_RESULT(xrGetInstanceProcAddr(instance, "xrCreateHandTrackerEXT", (PFN_xrVoidFunction *)&xrCreateHandTrackerEXT_ptr));
+	CHECK_RESULT(xrGetInstanceProcAddr(instance, "xrDestroyHandTrackerEXT", (PFN_xrVoidFunction *)&xrDestroyHandTrackerEXT_ptr));
+	CHECK_RESULT(xrGetInstanceProcAddr(instance, "xrLocateHandJointsEXT", (PFN_xrVoidFunction *)&xrLocateHandJointsEXT_ptr));
+	CHECK_RESULT(xrGetInstanceProcAddr(instance, "xrCreateSpatialAnchorMSFT", (PFN_xrVoidFunction *)&xrCreateSpatialAnchorMSFT_ptr));
+	CHECK_RESULT(xrGetInstanceProcAddr(instance, "xrCreateSpatialAnchorSpaceMSFT", (PFN_xrVoidFunction *)&xrCreateSpatialAnchorSpaceMSFT_ptr));
+	CHECK_RESULT(xrGetInstanceProcAddr(instance, "xrDestroySpatialAnchorMSFT", (PFN_xrVoidFunction *)&xrDestroySpatialAnchorMSFT_ptr));
+
+	return true;
+}
+
+bool SmokeTest::create_actions() {
+	CHECK_RESULT(xrStringToPath(instance, "/user/hand/left", &hand_paths[0]));
+	CHECK_RESULT(xrStringToPath(instance, "/user/hand/right", &hand_paths[1]));
+
+	XrActionSetCreateInfo action_set_info = { XR_TYPE_ACTION_SET_CREATE_INFO };
+	strcpy(action_set_info.actionSetName, "smoke_test");
+	strcpy(action_set_info.localizedActionSetName, "Smoke test");
+	CHECK_RESULT(xrCreateActionSet(instance, &action_set_info, &action_set));
+
+	XrActionCreateInfo action_info = { XR_TYPE_ACTION_CREATE_INFO };
+	action_info.countSubactionPaths = 2;
+	action_info.subactionPaths = hand_paths;
+
+	action_info.actionType = XR_ACTION_TYPE_BOOLEAN_INPUT;
+	strcpy(action_info.actionName, "select");
+	strcpy(action_info.localizedActionName, "Select");
+	CHECK_RESULT(xrCreateAction(action_set, &action_info, &select_action));
+
+	action_info.actionType = XR_ACTION_TYPE_POSE_INPUT;
+	strcpy(action_info.actionName, "aim");
+	strcpy(action_info.localizedActionName, "Aim");
+	CHECK_RESULT(xrCreateAction(action_set, &action_info, &aim_action));
+
+	const char *binding_paths[] = {
+		"/user/hand/left/input/select/click",
+		"/user/hand/right/input/select/click",
+		"/user/hand/left/input/aim/pose",
+		"/user/hand/right/input/aim/pose",
+	};
+	XrActionSuggestedBinding bindings[4];
+	for (int i = 0; i < 4; i++) {
+		bindings[i].action = i < 2 ? select_action : aim_action;
+		CHECK_RESULT(xrStringToPath(instance, binding_paths[i], &bindings[i].binding));
+	}
+
+	XrInteractionProfileSuggestedBinding suggested_bindings = { XR_TYPE_INTERACTION_PROFILE_SUGGESTED_BINDING };
+	CHECK_RESULT(xrStringToPath(instance, "/interaction_profiles/khr/simple_controller", &suggested_bindings.interactionProfile));
+	suggested_bindings.countSuggestedBindings = 4;
+	suggested_bindings.suggestedBindings = bindings;
+	CHECK_RESULT(xrSuggestInteractionProfileBindings(instance, &suggested_bindings));
+
+	return true;
+}
+
+bool SmokeTest::create_session() {
+	// headless, so no graphics binding
+	XrSessionCreateInfo session_info = { XR_TYPE_SESSION_CREATE_INFO };
+	session_info.systemId = system_id;
+	CHECK_RESULT(xrCreateSession(instance, &session_info, &session));
+
+	XrSessionActionSetsAttachInfo attach_info = { XR_TYPE_SESSION_ACTION_SETS_ATTACH_INFO };
+	attach_info.countActionSets = 1;
+	attach_info.actionSets = &action_set;
+	CHECK_RESULT(xrAttachSessionActionSets(session, &attach_info));
+
+	XrReferenceSpaceCreateInfo reference_space_info = { XR_TYPE_REFERENCE_SPACE_CREATE_INFO };
+	reference_space_info.referenceSpaceType = XR_REFERENCE_SPACE_TYPE_STAGE;
+	reference_space_info.poseInReferenceSpace.orientation.w = 1.0f;
+	CHECK_RESULT(xrCreateReferenceSpace(session, &reference_space_info, &stage_space));
+
+	for (int i = 0; i < 2; i++) {
+		XrActionSpaceCreateInfo action_space_info = { XR_TYPE_ACTION_SPACE_CREATE_INFO };
+		action_space_info.action = aim_action;
+		action_space_info.subactionPath = hand_paths[i];
+		action_space_info.poseInActionSpace.orientation.w = 1.0f;
+		CHECK_RESULT(xrCreateActionSpace(session, &action_space_info, &aim_spaces[i]));
+
+		XrHandTrackerCreateInfoEXT hand_tracker_info = { XR_TYPE_HAND_TRACKER_CREATE_INFO_EXT };
+		hand_tracker_info.hand = i == 0 ? XR_HAND_LEFT_EXT : XR_HAND_RIGHT_EXT;
+		hand_tracker_info.handJointSet = XR_HAND_JOINT_SET_DEFAULT_EXT;
+		CHECK_RESULT(xrCreateHandTrackerEXT_ptr(session, &hand_tracker_info, &hand_trackers[i]));
+	}
+
+	XrSpatialAnchorCreateInfoMSFT anchor_info = { XR_TYPE_SPATIAL_ANCHOR_CREATE_INFO_MSFT };
+	anchor_info.space = stage_space;
+	anchor_info.pose.orientation.w = 1.0f;
+	anchor_info.pose.position = anchor_position;
+	anchor_info.time = 1; // any valid time, our stage space doesn't move
+	CHECK_RESULT(xrCreateSpatialAnchorMSFT_ptr(session, &anchor_info, &anchor));
+
+	XrSpatialAnchorSpaceCreateInfoMSFT anchor_space_info = { XR_TYPE_SPATIAL_ANCHOR_SPACE_CREATE_INFO_MSFT };
+	anchor_space_info.anchor = anchor;
+	anchor_space_info.poseInAnchorSpace.orientation.w = 1.0f;
+	CHECK_RESULT(xrCreateSpatialAnchorSpaceMSFT_ptr(session, &anchor_space_info, &anchor_space));
+
+	return true;
+}
+
+bool SmokeTest::poll_events() {
+	XrEventDataBuffer event = { XR_TYPE_EVENT_DATA_BUFFER };
+	XrResult result = xrPollEvent(instance, &event);
+	while (result == XR_SUCCESS) {
+		if (event.type == XR_TYPE_EVENT_DATA_SESSION_STATE_CHANGED) {
+			const XrEventDataSessionStateChanged *state_changed = (XrEventDataSessionStateChanged *)&event;
+			CHECK(state_changed->session == session, "state change is for our session");
+			state = state_changed->state;
+
+			if (state == XR_SESSION_STATE_READY) {
+				XrSessionBeginInfo begin_info = { XR_TYPE_SESSION_BEGIN_INFO };
+				begin_info.primaryViewConfigurationType = XR_VIEW_CONFIGURATION_TYPE_PRIMARY_STEREO;
+				CHECK_RESULT(xrBeginSession(session, &begin_info));
+				running = true;
+			} else if (state == XR_SESSION_STATE_STOPPING) {
+				CHECK_RESULT(xrEndSession(session));
+				running = false;
+			} else if (state == XR_SESSION_STATE_EXITING) {
+				exiting = true;
+			}
+		}
+
+		event.type = XR_TYPE_EVENT_DATA_BUFFER;
+		result = xrPollEvent(instance, &event);
+	}
+
+	CHECK_RESULT(result);
+	return true;
+}
+
+bool SmokeTest::run_frame() {
+	XrFrameState frame_state = { XR_TYPE_FRAME_STATE };
+	CHECK_RESULT(xrWaitFrame(session, nullptr, &frame_state));
+	CHECK_RESULT(xrBeginFrame(session, nullptr));
+
+	// our mock runtime advances time by exactly one frame period every frame
+	if (last_display_time != 0) {
+		CHECK(frame_state.predictedDisplayTime == last_display_time + frame_state.predictedDisplayPeriod, "display time advances by one frame period");
+	}
+	last_display_time = frame_state.predictedDisplayTime;
+
+	if (state == XR_SESSION_STATE_FOCUSED) {
+		frames_focused++;
+
+		XrActiveActionSet active_action_set = { action_set, XR_NULL_PATH };
+		XrActionsSyncInfo sync_info = { XR_TYPE_ACTIONS_SYNC_INFO };
+		sync_info.countActiveActionSets = 1;
+		sync_info.activeActionSets = &active_action_set;
+		CHECK_RESULT(xrSyncActions(session, &sync_info));
+
+		for (int i = 0; i < 2; i++) {
+			XrActionStateGetInfo get_info = { XR_TYPE_ACTION_STATE_GET_INFO };
+			get_info.action = select_action;
+			get_info.subactionPath = hand_paths[i];
+			XrActionStateBoolean select_state = { XR_TYPE_ACTION_STATE_BOOLEAN };
+			CHECK_RESULT(xrGetActionStateBoolean(session, &get_info, &select_state));
+			CHECK(select_state.isActive == XR_TRUE, "select is bound");
+			if (select_state.changedSinceLastSync) {
+				select_changes++;
+			}
+
+			XrSpaceLocation location = { XR_TYPE_SPACE_LOCATION };
+			CHECK_RESULT(xrLocateSpace(aim_spaces[i], stage_space, frame_state.predictedDisplayTime, &location));
+			CHECK((location.locationFlags & XR_SPACE_LOCATION_POSITION_VALID_BIT) != 0, "aim pose is located");
+
+			XrHandJointLocationEXT joints[XR_HAND_JOINT_COUNT_EXT];
+			XrHandJointLocationsEXT joint_locations = { XR_TYPE_HAND_JOINT_LOCATIONS_EXT };
+			joint_locations.jointCount = XR_HAND_JOINT_COUNT_EXT;
+			joint_locations.jointLocations = joints;
+			XrHandJointsLocateInfoEXT locate_info = { XR_TYPE_HAND_JOINTS_LOCATE_INFO_EXT };
+			locate_info.baseSpace = stage_space;
+			locate_info.time = frame_state.predictedDisplayTime;
+			CHECK_RESULT(xrLocateHandJointsEXT_ptr(hand_trackers[i], &locate_info, &joint_locations));
+			CHECK(joint_locations.isActive == XR_TRUE, "hand is tracked");
+		}
+
+		// our anchor stays where we created it
+		XrSpaceLocation anchor_location = { XR_TYPE_SPACE_LOCATION };
+		CHECK_RESULT(xrLocateSpace(anchor_space, stage_space, frame_state.predictedDisplayTime, &anchor_location));
+		const XrVector3f &position = anchor_location.pose.position;
+		CHECK((anchor_location.locationFlags & XR_SPACE_LOCATION_POSITION_VALID_BIT) != 0, "anchor is located");
+		CHECK(fabsf(position.x - anchor_position.x) + fabsf(position.y - anchor_position.y) + fabsf(position.z - anchor_position.z) < 0.0001f, "anchor doesn't move");
+	}
+
+	XrView views[2] = { { XR_TYPE_VIEW }, { XR_TYPE_VIEW } };
+	XrViewState view_state = { XR_TYPE_VIEW_STATE };
+	XrViewLocateInfo view_locate_info = { XR_TYPE_VIEW_LOCATE_INFO };
+	view_locate_info.viewConfigurationType = XR_VIEW_CONFIGURATION_TYPE_PRIMARY_STEREO;
+	view_locate_info.displayTime = frame_state.predictedDisplayTime;
+	view_locate_info.space = stage_space;
+	uint32_t view_count = 0;
+	CHECK_RESULT(xrLocateViews(session, &view_locate_info, &view_state, 2, &view_count, views));
+	CHECK(view_count == 2, "we have two views");
+
+	if (frame_state.shouldRender) {
+		frames_rendered++;
+	}
+
+	// headless, so we never submit layers
+	XrFrameEndInfo end_info = { XR_TYPE_FRAME_END_INFO };
+	end_info.displayTime = frame_state.predictedDisplayTime;
+	end_info.environmentBlendMode = XR_ENVIRONMENT_BLEND_MODE_OPAQUE;
+	CHECK_RESULT(xrEndFrame(session, &end_info));
+
+	return true;
+}
+
+void SmokeTest::cleanup() {
+	if (anchor_space != XR_NULL_HANDLE) {
+		xrDestroySpace(anchor_space);
+	}
+	if (anchor != XR_NULL_HANDLE) {
+		xrDestroySpatialAnchorMSFT_ptr(anchor);
+	}
+	for (int i = 0; i < 2; i++) {
+		if (hand_trackers[i] != XR_NULL_HANDLE) {
+			xrDestroyHandTrackerEXT_ptr(hand_trackers[i]);
+		}
+		if (aim_spaces[i] != XR_NULL_HANDLE) {
+			xrDestroySpace(aim_spaces[i]);
+		}
+	}
+	if (stage_space != XR_NULL_HANDLE) {
+		xrDestroySpace(stage_space);
+	}
+	if (session != XR_NULL_HANDLE) {
+		xrDestroySession(session);
+	}
+	if (action_set != XR_NULL_HANDLE) {
+		xrDestroyActionSet(action_set);
+	}
+	if (instance != XR_NULL_HANDLE) {
+		xrDestroyInstance(instance);
+	}
+}
+
+static bool run(SmokeTest &p_test, uint32_t p_frames) {
+	if (!p_test.create_instance() || !p_test.create_actions() || !p_test.create_session()) {
+		return false;
+	}
+
+	uint32_t frame = 0;
+	bool exit_requested = false;
+	while (!p_test.exiting) {
+		if (!p_test.poll_events()) {
+			return false;
+		}
+
+		if (p_test.running) {
+			if (frame == p_frames) {
+				if (!exit_requested) {
+					CHECK_RESULT(xrRequestExitSession(p_test.session));
+					exit_requested = true;
+				}
+			} else if (!p_test.run_frame()) {
+				return false;
+			} else {
+				frame++;
+			}
+		} else if (frame > 0 && !exit_requested) {
+			printf("FAILED: session stopped before we requested exit\n");
+			return false;
+		}
+	}
+
+	return true;
+}
+
+int main(int argc, char **argv) {
+	uint32_t frames = argc > 1 ? (uint32_t)atoi(argv[1]) : 300;
+
+	SmokeTest test;
+	bool completed = run(test, frames);
+	test.cleanup();
+
+	if (completed) {
+		CHECK(test.frames_focused == frames, "all frames were focused");
+		CHECK(test.frames_rendered == frames, "all frames should render");
+		CHECK(frames < 100 || test.select_changes > 0, "scripted input changes");
+	}
+
+	if (!completed || failures > 0) {
+		return 1;
+	}
+
+	printf("Mock runtime ran %u frames, select changed %u times\n", frames, test.select_changes);
+	return 0;
+}
@@ -0,0 +1,75 @@
+#!/usr/bin/env python3
+# Runs demo/benchmark/Benchmark.tscn against our headless mock OpenXR runtime.
+#
+# The plugin must be built with mock_runtime=yes track_allocations=yes, this script
+# exits with the exit code of the benchmark which is non-zero if it failed, allocated
+# memory or exceeded the given thresholds.
+#
+# Timings depend on the machine we run on, so thresholds are required. Use --calibrate
+# to write thresholds based on a run on the machine that will check them.
+#
+# Usage: run_benchmark.py [--godot <godot executable>] [--platform linux|windows]
+#                         [--output <results.json>] [--frames <count>]
+#                         (--thresholds <thresholds.json> | --calibrate <thresholds.json>)
+
+import argparse
+import os
+import subprocess
+import sys
+
+root_path = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+demo_path = os.path.join(root_path, 'demo')
+
+
+def get_bin_path(platform):
+    return os.path.join(demo_path, 'addons', 'godot-openxr', 'bin', 'win64' if platform == 'windows' else platform)
+
+
+def run_benchmark(godot, platform, output, frames, thresholds, calibrate):
+    manifest = os.path.join(get_bin_path(platform), 'openxr_mock_runtime.json')
+    if not os.path.exists(manifest):
+        print('Mock runtime manifest ' + manifest + ' not found, build with mock_runtime=yes', file=sys.stderr)
+        return 2
+
+    env = os.environ.copy()
+    env['XR_RUNTIME_JSON'] = manifest
+    # our benchmark binds its additional action sets to the index controller
+    env['OPENXR_MOCK_INTERACTION_PROFILE'] = '/interaction_profiles/valve/index_controller'
+
+    command = [
+        godot,
+        '--path', demo_path,
+        'res://benchmark/Benchmark.tscn',
+        '--benchmark-output=' + os.path.abspath(output),
+        '--benchmark-frames=' + str(frames),
+    ]
+    if calibrate:
+        command.append('--benchmark-calibrate=' + os.path.abspath(calibrate))
+    else:
+        command.append('--benchmark-thresholds=' + os.path.abspath(thresholds))
+
+    try:
+        result = subprocess.call(command, env=env)
+    except OSError as e:
+        print('Could not run ' + godot + ': ' + str(e), file=sys.stderr)
+        return 2
+
+    if os.path.exists(output):
+        with open(output) as results:
+            print(results.read())
+
+    return result
+
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser(description='Run the Godot OpenXR benchmark against our mock runtime')
+    parser.add_argument('--godot', default='godot', help='Godot executable')
+    parser.add_argument('--platform', default='windows' if sys.platform == 'win32' else 'linux', choices=['linux', 'windows'])
+    parser.add_argument('--output', default='benchmark_results.json', help='File to write our results to')
+    parser.add_argument('--frames', type=int, default=900, help='Number of frames to measure')
+    thresholds = parser.add_mutually_exclusive_group(required=True)
+    thresholds.add_argument('--thresholds', help='Thresholds to check our results against')
+    thresholds.add_argument('--calibrate', help='Write thresholds based on this run to this file')
+    args = parser.parse_args()
+
+    sys.exit(run_benchmark(args.godot, args.platform, args.output, args.frames, args.thresholds, args.calibrate))
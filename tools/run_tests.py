@@ -0,0 +1,81 @@
+#!/usr/bin/env python3
+# Runs our tests against our headless mock OpenXR runtime.
+#
+# The plugin must be built with mock_runtime=yes track_allocations=yes, this builds the mock runtime
+# and its smoke test which loads the runtime through the OpenXR loader and runs a number of frames.
+# After the smoke test we run every scene in demo/tests in Godot, see demo/tests/test.gd.
+# Godot needs a display to process our frames, on CI we use xvfb-run.
+# Exits with a non-zero exit code if any test failed.
+#
+# Usage: run_tests.py [--godot <godot executable>] [--platform linux|windows] [--frames <count>]
+#                     [--skip-godot]
+
+import argparse
+import glob
+import os
+import subprocess
+import sys
+import tempfile
+
+root_path = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+demo_path = os.path.join(root_path, 'demo')
+
+
+def get_bin_path(platform):
+    return os.path.join(demo_path, 'addons', 'godot-openxr', 'bin', 'win64' if platform == 'windows' else platform)
+
+
+def run_test(name, command, env):
+    print('Running ' + name)
+    try:
+        result = subprocess.call(command, env=env)
+    except OSError as e:
+        print('Could not run ' + command[0] + ': ' + str(e), file=sys.stderr)
+        result = 2
+
+    print(name + (' passed' if result == 0 else ' FAILED'))
+    return result == 0
+
+
+def run_tests(godot, platform, frames, skip_godot):
+    bin_path = get_bin_path(platform)
+    manifest = os.path.join(bin_path, 'openxr_mock_runtime.json')
+    if not os.path.exists(manifest):
+        print('Mock runtime manifest ' + manifest + ' not found, build with mock_runtime=yes', file=sys.stderr)
+        return 2
+
+    env = os.environ.copy()
+    env['XR_RUNTIME_JSON'] = manifest
+
+    smoke_test = os.path.join(bin_path, 'openxr_mock_runtime_test' + ('.exe' if platform == 'windows' else ''))
+    failed = []
+    if not run_test('mock runtime smoke test', [smoke_test, str(frames)], env):
+        failed.append('mock runtime smoke test')
+
+    if not skip_godot:
+        report_dir = tempfile.mkdtemp(prefix='openxr_tests_')
+        for scene in sorted(glob.glob(os.path.join(demo_path, 'tests', '*.tscn'))):
+            scene_name = os.path.splitext(os.path.basename(scene))[0]
+
+            # each test gets a fresh report from our mock runtime
+            env['OPENXR_MOCK_REPORT'] = os.path.join(report_dir, scene_name + '.json')
+            if not run_test(scene_name, [godot, '--path', demo_path, 'res://tests/' + os.path.basename(scene)], env):
+                failed.append(scene_name)
+
+    if failed:
+        print('Failed tests: ' + ', '.join(failed))
+        return 1
+
+    print('All tests passed')
+    return 0
+
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser(description='Run the Godot OpenXR tests against our mock runtime')
+    parser.add_argument('--godot', default='godot', help='Godot executable')
+    parser.add_argument('--platform', default='windows' if sys.platform == 'win32' else 'linux', choices=['linux', 'windows'])
+    parser.add_argument('--frames', type=int, default=300, help='Number of frames the smoke test runs')
+    parser.add_argument('--skip-godot', action='store_true', help='Only run the smoke test')
+    args = parser.parse_args()
+
+    sys.exit(run_tests(args.godot, args.platform, args.frames, args.skip_godot))